@@ -0,0 +1,32 @@
+#pragma once
+
+/**
+ * @file
+ * Host stand-in for the project logger: LOG_ERROR, LOG_INFO and LOG_DEBUG print one line to stderr.
+ */
+
+#include <iostream>
+
+class HostLogLine {
+public:
+    explicit HostLogLine(const char* level) {
+        std::cerr << level;
+    }
+
+    HostLogLine(const HostLogLine&) = delete;
+    HostLogLine& operator=(const HostLogLine&) = delete;
+
+    ~HostLogLine() {
+        std::cerr << '\n';
+    }
+
+    template <typename T>
+    HostLogLine& operator<<(const T& value) {
+        std::cerr << value;
+        return *this;
+    }
+};
+
+#define LOG_ERROR HostLogLine("[error] ")
+#define LOG_INFO HostLogLine("[info] ")
+#define LOG_DEBUG HostLogLine("[debug] ")
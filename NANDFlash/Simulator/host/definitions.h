@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * @file
+ * Host stand-in for the Harmony definitions.h, for building the drivers against MT29FSimulator.
+ *
+ * Provides the CPU clock, the PIO pin functions (no pins exist, reads return high) and the MATRIX
+ * register MT29F::initialize() sets for the NAND chip select. XDMAC, SCB and DWT are not provided:
+ * XDMACNANDDma is left out of host builds and the cycle counter uses the steady clock off-ARM.
+ */
+
+#include "samv71q21b.h"
+
+#define CPU_CLOCK_FREQUENCY 300000000U
+
+typedef enum {
+    PIO_PIN_PA0 = 0,
+    PIO_PIN_NONE = -1,
+} PIO_PIN;
+
+typedef void (*PIO_PIN_CALLBACK)(PIO_PIN pin, uintptr_t context);
+
+inline bool PIO_PinRead(PIO_PIN /* pin */) {
+    return true;
+}
+
+inline void PIO_PinWrite(PIO_PIN /* pin */, bool /* value */) {}
+
+inline bool PIO_PinInterruptCallbackRegister(PIO_PIN /* pin */, const PIO_PIN_CALLBACK /* callback */,
+                                             uintptr_t /* context */) {
+    return true;
+}
+
+inline void PIO_PinInterruptEnable(PIO_PIN /* pin */) {}
+
+inline void PIO_PinInterruptDisable(PIO_PIN /* pin */) {}
+
+struct HostMatrixRegisters {
+    uint32_t CCFG_SMCNFCS;
+};
+
+inline HostMatrixRegisters hostMatrixRegisters{};
+
+#define MATRIX_REGS (&hostMatrixRegisters)
+
+#define CCFG_SMCNFCS_SMC_NFCS0(value) (static_cast<uint32_t>(value) << 0U)
+#define CCFG_SMCNFCS_SMC_NFCS1(value) (static_cast<uint32_t>(value) << 1U)
+#define CCFG_SMCNFCS_SMC_NFCS2(value) (static_cast<uint32_t>(value) << 2U)
+#define CCFG_SMCNFCS_SMC_NFCS3(value) (static_cast<uint32_t>(value) << 3U)
@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * @file
+ * Host stand-in for the Harmony device header, for building the drivers against MT29FSimulator.
+ *
+ * Only what SMC.hpp uses: the EBI chip select addresses and the SMC timing registers, which are plain
+ * variables here. Nothing may access memory at the chip select addresses on the host, so MT29F has to
+ * be given a NANDBus backend and MRAM cannot be used.
+ */
+
+#include <cstdint>
+#include <cstddef>
+
+#define EBI_CS0_ADDR 0x60000000U
+#define EBI_CS1_ADDR 0x61000000U
+#define EBI_CS2_ADDR 0x62000000U
+#define EBI_CS3_ADDR 0x63000000U
+
+struct HostSmcChipSelectRegisters {
+    uint32_t SMC_SETUP;
+    uint32_t SMC_PULSE;
+    uint32_t SMC_CYCLE;
+    uint32_t SMC_MODE;
+};
+
+struct HostSmcRegisters {
+    HostSmcChipSelectRegisters SMC_CS_NUMBER[4];
+};
+
+inline HostSmcRegisters hostSmcRegisters{};
+
+#define SMC_REGS (&hostSmcRegisters)
+
+#define SMC_SETUP_NWE_SETUP(value) (0x3FU & (static_cast<uint32_t>(value) << 0U))
+#define SMC_SETUP_NCS_WR_SETUP(value) (0x3F00U & (static_cast<uint32_t>(value) << 8U))
+#define SMC_SETUP_NRD_SETUP(value) (0x3F0000U & (static_cast<uint32_t>(value) << 16U))
+#define SMC_SETUP_NCS_RD_SETUP(value) (0x3F000000U & (static_cast<uint32_t>(value) << 24U))
+#define SMC_PULSE_NWE_PULSE(value) (0x7FU & (static_cast<uint32_t>(value) << 0U))
+#define SMC_PULSE_NCS_WR_PULSE(value) (0x7F00U & (static_cast<uint32_t>(value) << 8U))
+#define SMC_PULSE_NRD_PULSE(value) (0x7F0000U & (static_cast<uint32_t>(value) << 16U))
+#define SMC_PULSE_NCS_RD_PULSE(value) (0x7F000000U & (static_cast<uint32_t>(value) << 24U))
+#define SMC_CYCLE_NWE_CYCLE(value) (0x1FFU & (static_cast<uint32_t>(value) << 0U))
+#define SMC_CYCLE_NRD_CYCLE(value) (0x1FF0000U & (static_cast<uint32_t>(value) << 16U))
+#define SMC_MODE_READ_MODE_Msk (1U << 0U)
+#define SMC_MODE_WRITE_MODE_Msk (1U << 1U)
+#define SMC_MODE_EXNW_MODE_DISABLED (0U << 4U)
+#define SMC_MODE_DBW_8_BIT (0U << 12U)
+#define SMC_MODE_TDF_CYCLES(value) (0xF0000U & (static_cast<uint32_t>(value) << 16U))
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "NANDBus.hpp"
+#include "NANDDma.hpp"
+#include <cstdint>
+#include <etl/span.h>
+
+/**
+ * @brief Host-side NANDDmaEngine moving the data phase through a NANDBus.
+ *
+ * @details Stands in for XDMACNANDDma off-target. A started transfer stays pending until the
+ *          driver waits for it; the "interrupt" then fires inside waitForCompletion(), which moves
+ *          the bytes through the bus backend and reports the outcome. This exercises the
+ *          same start / block / complete sequence as the target, including the failure paths:
+ *          - setChannelAvailable(false): start requests are refused, so the CPU fallback runs
+ *          - failNextTransfer(): the transfer stops halfway with a bus error
+ *          - stallNextTransfer(): the transfer never completes and the wait times out
+ *
+ * @note Host only. Not part of the target build.
+ */
+class FakeNANDDma final : public NANDDmaEngine {
+public:
+    /**
+     * @param bus Bus backend the data cycles are issued on (normally the MT29FSimulator)
+     */
+    explicit FakeNANDDma(NANDBus& bus) : nandBus{bus} {}
+
+    bool startRead(uint32_t dataRegisterAddress, etl::span<uint8_t> destination) override;
+
+    bool startWrite(etl::span<const uint8_t> source, uint32_t dataRegisterAddress) override;
+
+    bool waitForCompletion(uint32_t timeoutUs) override;
+
+    /* ================== Test Hooks ================== */
+
+    /**
+     * @param isAvailable false to refuse every transfer, as if the channel was taken
+     */
+    void setChannelAvailable(bool isAvailable) {
+        channelAvailable = isAvailable;
+    }
+
+    /**
+     * @brief Abort the next transfer with a bus error after half of the bytes.
+     */
+    void failNextTransfer() {
+        injectFailure = true;
+    }
+
+    /**
+     * @brief Let the next transfer hang, so that waitForCompletion() times out.
+     */
+    void stallNextTransfer() {
+        injectStall = true;
+    }
+
+    /**
+     * @return Number of transfers that were started
+     */
+    [[nodiscard]] uint32_t getStartedTransfers() const {
+        return startedTransfers;
+    }
+
+    /**
+     * @return Number of transfers that completed successfully
+     */
+    [[nodiscard]] uint32_t getCompletedTransfers() const {
+        return completedTransfers;
+    }
+
+    /**
+     * @return Number of start requests refused because the channel was unavailable
+     */
+    [[nodiscard]] uint32_t getRefusedTransfers() const {
+        return refusedTransfers;
+    }
+
+private:
+    NANDBus& nandBus;
+
+    bool channelAvailable = true;
+
+    bool injectFailure = false;
+
+    bool injectStall = false;
+
+    bool isTransferActive = false;
+
+    etl::span<uint8_t> readDestination;
+
+    etl::span<const uint8_t> writeSource;
+
+    uint32_t startedTransfers = 0U;
+
+    uint32_t completedTransfers = 0U;
+
+    uint32_t refusedTransfers = 0U;
+
+    bool start();
+};
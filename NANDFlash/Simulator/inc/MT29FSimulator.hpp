@@ -0,0 +1,299 @@
+#pragma once
+
+#include "NANDBus.hpp"
+#include "MT29FGeometry.hpp"
+#include <chrono>
+#include <sys/types.h>
+#include <etl/array.h>
+#include <etl/span.h>
+
+/**
+ * @brief Host-side model of the MT29F64G08AFAAAWP, used as an MT29F bus backend.
+ *
+ * @details Decodes the raw command/address/data cycles issued by MT29F the same way the device
+ *          does and keeps the page array in a file, so that the driver can be exercised,
+ *          benchmarked and fuzzed on a plain Linux machine:
+ *          - 00h-addr-30h READ PAGE, 00h-addr-35h COPYBACK READ, 00h (return to data output)
+ *          - 31h / 00h-addr-31h READ CACHE SEQUENTIAL / RANDOM, 3Fh READ CACHE END
+ *          - 80h-addr-data-10h PAGE PROGRAM, 80h-addr-data-15h PAGE PROGRAM CACHE
+ *          - 85h-addr-[data]-10h COPYBACK PROGRAM
+ *          - 80h-addr-data-11h + 81h-addr-data-10h PROGRAM PAGE MULTI-PLANE
+ *          - 00h-addr-32h + 00h-addr-30h READ PAGE MULTI-PLANE, 06h-addr-E0h CHANGE READ COLUMN ENHANCED
+ *          - 05h-col-E0h CHANGE READ COLUMN, 85h-col CHANGE WRITE COLUMN inside a program sequence
+ *          - 60h-addr-D0h ERASE BLOCK, 60h-addr-D1h multi-plane erase queueing
+ *          - 70h READ STATUS, 90h READ ID, ECh READ PARAMETER PAGE, FFh RESET
+ *          - EFh-addr-P1..P4 SET FEATURES, EEh-addr GET FEATURES (timing mode 01h, read retry 89h)
+ *
+ *          Array busy times (tR, tPROG, tBERS, tRST, tRCBSY) are modelled against the steady clock.
+ *          The interface (RDY, mirrored on R/B#) and the array (ARDY) are tracked separately, so
+ *          cache operations report ready while the array is still loading the next page. Programming can
+ *          only clear bits (the new data is ANDed into the array), as on the real device.
+ *
+ *          The backing file holds every page of the device (8640 bytes each). It is created
+ *          sparse and stores the bitwise complement of the array, so unwritten regions read
+ *          back as erased (0xFF) and erased blocks are released with a hole punch.
+ *
+ * @note Host only (POSIX file I/O). Not part of the target build. Needs only ETL, no Harmony headers.
+ *
+ * @note Protocol violations (e.g. data cycles while the device is busy, programming an
+ *       out-of-range row) do not abort; they are counted and the offending cycle is dropped,
+ *       so the model can be driven by fuzzed cycle sequences.
+ */
+class MT29FSimulator final : public NANDBus {
+public:
+    /**
+     * @brief Modelled array busy times.
+     *
+     * @note Defaults are the datasheet maximums also used by the driver timeouts.
+     */
+    struct Timing {
+        uint32_t readUs = 35U;          /*!< tR: array to data register */
+        uint32_t programUs = 560U;      /*!< tPROG: data register to array */
+        uint32_t eraseUs = 7000U;       /*!< tBERS: block erase */
+        uint32_t resetUs = 1000U;       /*!< tRST: reset while idle */
+        uint32_t cacheBusyUs = 3U;      /*!< tRCBSY / tCBSY: transfer between cache and data register */
+        uint32_t dummyBusyUs = 1U;      /*!< tDBSY: multi-plane queueing (11h, 32h) */
+        uint32_t featureUs = 1U;        /*!< tFEAT: SET/GET FEATURES */
+    };
+
+    /**
+     * @param backingFilePath Path of the file holding the page array (created if missing)
+     * @param timing Array busy times to model
+     */
+    MT29FSimulator(const char* backingFilePath, Timing timing);
+
+    /**
+     * @param backingFilePath Path of the file holding the page array (created if missing)
+     */
+    explicit MT29FSimulator(const char* backingFilePath) : MT29FSimulator{backingFilePath, Timing{}} {}
+
+    ~MT29FSimulator() override;
+
+    MT29FSimulator(const MT29FSimulator&) = delete;
+    MT29FSimulator& operator=(const MT29FSimulator&) = delete;
+    MT29FSimulator(MT29FSimulator&&) = delete;
+    MT29FSimulator& operator=(MT29FSimulator&&) = delete;
+
+    /**
+     * @return true if the backing file was opened and sized successfully
+     */
+    [[nodiscard]] bool isOpen() const {
+        return fileDescriptor >= 0;
+    }
+
+    /* ================== NANDBus ================== */
+
+    void writeCommand(uint8_t command) override;
+
+    void writeAddress(uint8_t address) override;
+
+    void writeData(uint8_t data) override;
+
+    uint8_t readData() override;
+
+    bool isBusy() override;
+
+    /* ================== Test Hooks ================== */
+
+    /**
+     * @brief Write the factory bad block marker (0x00) into the first spare byte of a block.
+     *
+     * @param block Block to mark
+     */
+    void markFactoryBadBlock(uint16_t block);
+
+    /**
+     * @brief Make a block readable only with one read retry option.
+     *
+     * @details Pages of the block loaded by READ PAGE or COPYBACK READ with any other option of
+     *          feature 89h come back with one flipped bit every 16 bytes, beyond what ECC corrects.
+     *
+     * @param block Block to degrade
+     * @param readableOption Read retry option that reads the block correctly
+     */
+    void degradeBlock(uint16_t block, uint8_t readableOption);
+
+    /**
+     * @return Read retry option selected with SET FEATURES (0 after RESET)
+     */
+    [[nodiscard]] uint8_t getReadRetryOption() const {
+        return readRetryFeature[0];
+    }
+
+    /**
+     * @brief Drive the WP# input of the model.
+     *
+     * @param isProtected true to reject program/erase operations (status WP bit cleared)
+     */
+    void setWriteProtected(bool isProtected) {
+        writeProtected = isProtected;
+    }
+
+    /**
+     * @return Number of dropped cycles that violated the command protocol
+     */
+    [[nodiscard]] uint32_t getProtocolViolations() const {
+        return protocolViolations;
+    }
+
+    /**
+     * @return Timing mode selected with SET FEATURES (0 after RESET)
+     */
+    [[nodiscard]] uint8_t getTimingMode() const {
+        return timingModeFeature[0];
+    }
+
+private:
+    static constexpr uint32_t PageSize = MT29FGeometry::TotalBytesPerPage;
+    static constexpr uint8_t PlaneCount = 2U;
+    static constexpr uint8_t AddressCyclesMax = 5U;
+    static constexpr uint8_t ColumnAddressCycles = 2U;
+    static constexpr uint8_t RowAddressCycles = 3U;
+    static constexpr uint16_t ParameterPageSize = 256U;
+    static constexpr uint8_t ParameterPageCopies = 3U;
+    static constexpr uint8_t FeatureParameterCount = 4U;
+    static constexpr uint8_t NotDegraded = 0xFFU;
+
+    using Clock = std::chrono::steady_clock;
+    using PageRegister = etl::array<uint8_t, PageSize>;
+
+    /**
+     * @brief Command sequence currently being decoded.
+     */
+    enum class Sequence : uint8_t {
+        NONE,
+        READ,
+        READ_ID,
+        READ_PARAMETER_PAGE,
+        PROGRAM,
+        COPYBACK_PROGRAM,
+        ERASE,
+        CHANGE_READ_COLUMN,
+        CHANGE_READ_COLUMN_ENHANCED,
+        SET_FEATURES,
+        GET_FEATURES,
+    };
+
+    /**
+     * @brief Source of the bytes returned by readData().
+     */
+    enum class Output : uint8_t {
+        NONE,
+        STATUS,
+        ID,
+        PARAMETER_PAGE,
+        FEATURES,
+        PAGE_REGISTER,
+    };
+
+    /**
+     * @brief Decoded row address.
+     */
+    struct Row {
+        uint32_t lun;
+        uint32_t block;
+        uint32_t page;
+    };
+
+    int fileDescriptor = -1;
+
+    const Timing timing;
+
+    Clock::time_point readyAt{};        /*!< RDY (and R/B#) goes HIGH at this time */
+
+    Clock::time_point arrayReadyAt{};   /*!< ARDY goes HIGH at this time */
+
+    bool writeProtected = false;
+
+    uint8_t failStatus = 0U;
+
+    uint32_t protocolViolations = 0U;
+
+    Sequence sequence = Sequence::NONE;
+
+    Output output = Output::NONE;
+
+    Output dataOutput = Output::NONE; /*!< Data output restored by 00h after a status read */
+
+    etl::array<uint8_t, AddressCyclesMax> addressCycles{};
+
+    uint8_t addressCount = 0U;
+
+    uint8_t writeColumnCount = 0U;  /*!< Column cycles received since 85h CHANGE WRITE COLUMN */
+
+    bool isChangingWriteColumn = false;
+
+    uint8_t selectedPlane = 0U;
+
+    uint32_t columnPointer = 0U;
+
+    uint32_t outputPointer = 0U;
+
+    etl::array<uint8_t, 5> idOutput{};
+
+    uint8_t idLength = 0U;
+
+    etl::array<uint32_t, PlaneCount> queuedEraseBlocks{};
+
+    uint8_t queuedEraseCount = 0U;
+
+    etl::array<Row, PlaneCount> queuedProgramRows{};
+
+    uint8_t queuedProgramCount = 0U;
+
+    etl::array<PageRegister, PlaneCount> pageRegisters{};   /*!< Host visible (cache) registers */
+
+    PageRegister dataRegister{};    /*!< Data register feeding the cache register during cache reads */
+
+    Row dataRegisterRow{};
+
+    bool dataRegisterValid = false;
+
+    etl::array<uint8_t, ParameterPageSize> parameterPage{};
+
+    etl::array<uint8_t, FeatureParameterCount> timingModeFeature{};   /*!< P1..P4 of feature address 01h */
+
+    etl::array<uint8_t, FeatureParameterCount> readRetryFeature{};    /*!< P1..P4 of feature address 89h */
+
+    etl::array<uint8_t, FeatureParameterCount> featureInput{};
+
+    uint8_t featureAddress = 0U;    /*!< Feature address of the current SET/GET FEATURES */
+
+    etl::array<uint8_t, MT29FGeometry::BlocksPerLun> readableRetryOptions{};  /*!< Option reading each block, NotDegraded if any */
+
+    uint8_t featureInputCount = 0U;
+
+    void selectOutput(Output source);
+
+    [[nodiscard]] bool isInterfaceBusy() const;
+
+    [[nodiscard]] bool isArrayBusy() const;
+
+    void startBusy(uint32_t microseconds);
+
+    void startCacheRead(const Row* nextRow);
+
+    [[nodiscard]] uint8_t statusRegister() const;
+
+    [[nodiscard]] Row decodeRow(uint8_t firstRowCycle) const;
+
+    [[nodiscard]] uint32_t decodeColumn() const;
+
+    [[nodiscard]] static bool isRowValid(const Row& row);
+
+    void onAddressComplete();
+
+    void loadPage(const Row& row);
+
+    void programPage(const Row& row);
+
+    void eraseBlock(uint32_t block);
+
+    void buildParameterPage();
+
+    [[nodiscard]] static off_t pageOffset(uint32_t block, uint32_t page);
+
+    void readArray(off_t offset, etl::span<uint8_t> data) const;
+
+    void writeArray(off_t offset, etl::span<const uint8_t> data) const;
+};
@@ -0,0 +1,68 @@
+#include "FakeNANDDma.hpp"
+
+bool FakeNANDDma::startRead(uint32_t /* dataRegisterAddress */, etl::span<uint8_t> destination) {
+    if (not start()) {
+        return false;
+    }
+
+    readDestination = destination;
+    writeSource = {};
+
+    return true;
+}
+
+bool FakeNANDDma::startWrite(etl::span<const uint8_t> source, uint32_t /* dataRegisterAddress */) {
+    if (not start()) {
+        return false;
+    }
+
+    readDestination = {};
+    writeSource = source;
+
+    return true;
+}
+
+bool FakeNANDDma::waitForCompletion(uint32_t /* timeoutUs */) {
+    if (not isTransferActive) {
+        return false;
+    }
+
+    isTransferActive = false;
+
+    if (injectStall) {
+        injectStall = false;
+        return false;
+    }
+
+    const size_t Length = readDestination.empty() ? writeSource.size() : readDestination.size();
+    const size_t TransferredLength = injectFailure ? (Length / 2U) : Length;
+
+    for (size_t index = 0U; index < TransferredLength; index++) {
+        if (readDestination.empty()) {
+            nandBus.writeData(writeSource[index]);
+        } else {
+            readDestination[index] = nandBus.readData();
+        }
+    }
+
+    if (injectFailure) {
+        injectFailure = false;
+        return false;
+    }
+
+    completedTransfers++;
+
+    return true;
+}
+
+bool FakeNANDDma::start() {
+    if ((not channelAvailable) or isTransferActive) {
+        refusedTransfers++;
+        return false;
+    }
+
+    isTransferActive = true;
+    startedTransfers++;
+
+    return true;
+}
@@ -0,0 +1,805 @@
+#include "MT29FSimulator.hpp"
+#include <etl/algorithm.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    /**
+     * @brief Opcodes decoded by the model (ONFI / MT29F datasheet "Command Definitions").
+     */
+    namespace Opcode {
+        constexpr uint8_t Reset = 0xFFU;
+        constexpr uint8_t ReadId = 0x90U;
+        constexpr uint8_t ReadParameterPage = 0xECU;
+        constexpr uint8_t ReadStatus = 0x70U;
+        constexpr uint8_t ReadMode = 0x00U;
+        constexpr uint8_t ReadConfirm = 0x30U;
+        constexpr uint8_t CopybackReadConfirm = 0x35U;
+        constexpr uint8_t ReadCacheSequential = 0x31U;
+        constexpr uint8_t ReadCacheEnd = 0x3FU;
+        constexpr uint8_t PageProgram = 0x80U;
+        constexpr uint8_t CopybackProgram = 0x85U;
+        constexpr uint8_t PageProgramConfirm = 0x10U;
+        constexpr uint8_t PageProgramCache = 0x15U;
+        constexpr uint8_t EraseBlock = 0x60U;
+        constexpr uint8_t EraseBlockConfirm = 0xD0U;
+        constexpr uint8_t EraseMultiPlaneConfirm = 0xD1U;
+        constexpr uint8_t PageProgramMultiPlaneConfirm = 0x11U;
+        constexpr uint8_t PageProgramMultiPlane = 0x81U;
+        constexpr uint8_t ReadMultiPlane = 0x32U;
+        constexpr uint8_t ChangeReadColumn = 0x05U;
+        constexpr uint8_t ChangeReadColumnEnhanced = 0x06U;
+        constexpr uint8_t ChangeReadColumnConfirm = 0xE0U;
+        constexpr uint8_t SetFeatures = 0xEFU;
+        constexpr uint8_t GetFeatures = 0xEEU;
+    }
+
+    constexpr uint8_t StatusFail = 0x01U;
+    constexpr uint8_t StatusFailCommand = 0x02U;
+    constexpr uint8_t StatusArrayReady = 0x20U;
+    constexpr uint8_t StatusReady = 0x40U;
+    constexpr uint8_t StatusWriteProtect = 0x80U;
+
+    constexpr etl::array<uint8_t, 5> DeviceId = { 0x2CU, 0x68U, 0x00U, 0x27U, 0xA9U };
+    constexpr etl::array<uint8_t, 4> OnfiSignature = { 'O', 'N', 'F', 'I' };
+    constexpr uint8_t ReadIdManufacturerAddress = 0x00U;
+    constexpr uint8_t ReadIdOnfiAddress = 0x20U;
+    constexpr uint8_t TimingModeFeatureAddress = 0x01U;
+    constexpr uint8_t HighestTimingMode = 5U;
+    constexpr uint8_t ReadRetryFeatureAddress = 0x89U;
+    constexpr uint8_t HighestReadRetryOption = MT29FGeometry::ReadRetryOptions - 1U;
+    constexpr uint8_t DegradedBitInterval = 16U;
+    constexpr uint8_t ErasedByte = 0xFFU;
+}
+
+MT29FSimulator::MT29FSimulator(const char* backingFilePath, Timing timing) : timing{timing} {
+    constexpr off_t DeviceSize = static_cast<off_t>(MT29FGeometry::BlocksPerLun) * MT29FGeometry::PagesPerBlock * PageSize;
+
+    fileDescriptor = open(backingFilePath, O_RDWR | O_CREAT, 0644);
+
+    if ((fileDescriptor >= 0) and (ftruncate(fileDescriptor, DeviceSize) != 0)) {
+        close(fileDescriptor);
+        fileDescriptor = -1;
+    }
+
+    for (auto& pageRegister : pageRegisters) {
+        pageRegister.fill(ErasedByte);
+    }
+
+    readableRetryOptions.fill(NotDegraded);
+}
+
+MT29FSimulator::~MT29FSimulator() {
+    if (fileDescriptor >= 0) {
+        close(fileDescriptor);
+    }
+}
+
+
+/* ============= NANDBus ============= */
+
+void MT29FSimulator::writeCommand(uint8_t command) {
+    if (command == Opcode::Reset) {
+        sequence = Sequence::NONE;
+        selectOutput(Output::NONE);
+        addressCount = 0U;
+        isChangingWriteColumn = false;
+        queuedEraseCount = 0U;
+        queuedProgramCount = 0U;
+        failStatus = 0U;
+        timingModeFeature.fill(0U);
+        readRetryFeature.fill(0U);
+        startBusy(timing.resetUs);
+        return;
+    }
+
+    if (command == Opcode::ReadStatus) {
+        output = Output::STATUS;
+        return;
+    }
+
+    if (isInterfaceBusy()) {
+        protocolViolations++;
+        return;
+    }
+
+    const bool IsChangeWriteColumn = (command == Opcode::CopybackProgram) and (addressCount == AddressCyclesMax)
+                                     and ((sequence == Sequence::PROGRAM) or (sequence == Sequence::COPYBACK_PROGRAM));
+
+    if (IsChangeWriteColumn) {
+        isChangingWriteColumn = true;
+        writeColumnCount = 0U;
+        return;
+    }
+
+    if (isChangingWriteColumn) {
+        protocolViolations++;
+        isChangingWriteColumn = false;
+        sequence = Sequence::NONE;
+        queuedProgramCount = 0U;
+        return;
+    }
+
+    const bool IsArrayCommand = (command != Opcode::ReadMode) and (command != Opcode::ReadCacheSequential)
+                                and (command != Opcode::ReadCacheEnd) and (command != Opcode::PageProgram)
+                                and (command != Opcode::PageProgramConfirm) and (command != Opcode::PageProgramCache)
+                                and (command != Opcode::ChangeReadColumn)
+                                and (command != Opcode::ChangeReadColumnEnhanced)
+                                and (command != Opcode::ChangeReadColumnConfirm);
+
+    if (IsArrayCommand and isArrayBusy()) {
+        protocolViolations++;
+        return;
+    }
+
+    switch (command) {
+        case Opcode::ReadMode:
+            sequence = Sequence::READ;
+            addressCount = 0U;
+            output = dataOutput;
+            break;
+
+        case Opcode::ReadConfirm:
+        case Opcode::CopybackReadConfirm: {
+            const Row row = decodeRow(2U);
+
+            if ((sequence != Sequence::READ) or (addressCount != AddressCyclesMax) or (not isRowValid(row))) {
+                protocolViolations++;
+                sequence = Sequence::NONE;
+                break;
+            }
+
+            loadPage(row);
+            columnPointer = decodeColumn();
+            selectOutput(Output::PAGE_REGISTER);
+            sequence = Sequence::NONE;
+            startBusy(timing.readUs);
+            break;
+        }
+
+        case Opcode::ReadMultiPlane: {
+            const Row row = decodeRow(2U);
+
+            if ((sequence != Sequence::READ) or (addressCount != AddressCyclesMax) or (not isRowValid(row))) {
+                protocolViolations++;
+                sequence = Sequence::NONE;
+                break;
+            }
+
+            readArray(pageOffset(row.block, row.page), pageRegisters[row.block & 1U]);
+            sequence = Sequence::NONE;
+            readyAt = Clock::now() + std::chrono::microseconds(timing.dummyBusyUs);
+            break;
+        }
+
+        case Opcode::ChangeReadColumn:
+            sequence = Sequence::CHANGE_READ_COLUMN;
+            addressCount = 0U;
+            break;
+
+        case Opcode::ChangeReadColumnEnhanced:
+            sequence = Sequence::CHANGE_READ_COLUMN_ENHANCED;
+            addressCount = 0U;
+            break;
+
+        case Opcode::ChangeReadColumnConfirm: {
+            if ((sequence == Sequence::CHANGE_READ_COLUMN) and (addressCount == ColumnAddressCycles)
+                and (dataOutput == Output::PAGE_REGISTER)) {
+                columnPointer = decodeColumn();
+                selectOutput(Output::PAGE_REGISTER);
+                sequence = Sequence::NONE;
+                break;
+            }
+
+            const Row row = decodeRow(2U);
+
+            if ((sequence != Sequence::CHANGE_READ_COLUMN_ENHANCED) or (addressCount != AddressCyclesMax) or (not isRowValid(row))) {
+                protocolViolations++;
+                sequence = Sequence::NONE;
+                break;
+            }
+
+            selectedPlane = row.block & 1U;
+            columnPointer = decodeColumn();
+            selectOutput(Output::PAGE_REGISTER);
+            sequence = Sequence::NONE;
+            break;
+        }
+
+        case Opcode::ReadCacheSequential:
+        case Opcode::ReadCacheEnd: {
+            const bool IsRandom = (command == Opcode::ReadCacheSequential) and (addressCount == AddressCyclesMax);
+            Row nextRow = IsRandom ? decodeRow(2U) : dataRegisterRow;
+
+            if (not IsRandom) {
+                nextRow.page++;
+            }
+
+            const bool IsLoadValid = (command == Opcode::ReadCacheEnd) or isRowValid(nextRow);
+
+            if ((sequence != Sequence::READ) or (not dataRegisterValid) or (not IsLoadValid)
+                or ((addressCount != 0U) and (not IsRandom))) {
+                protocolViolations++;
+                sequence = Sequence::NONE;
+                break;
+            }
+
+            startCacheRead((command == Opcode::ReadCacheSequential) ? &nextRow : nullptr);
+            sequence = Sequence::NONE;
+            break;
+        }
+
+        case Opcode::ReadId:
+            sequence = Sequence::READ_ID;
+            addressCount = 0U;
+            selectOutput(Output::NONE);
+            break;
+
+        case Opcode::ReadParameterPage:
+            sequence = Sequence::READ_PARAMETER_PAGE;
+            addressCount = 0U;
+            selectOutput(Output::NONE);
+            break;
+
+        case Opcode::SetFeatures:
+            sequence = Sequence::SET_FEATURES;
+            addressCount = 0U;
+            featureInputCount = 0U;
+            selectOutput(Output::NONE);
+            break;
+
+        case Opcode::GetFeatures:
+            sequence = Sequence::GET_FEATURES;
+            addressCount = 0U;
+            selectOutput(Output::NONE);
+            break;
+
+        case Opcode::PageProgram:
+        case Opcode::PageProgramMultiPlane:
+            sequence = Sequence::PROGRAM;
+            addressCount = 0U;
+            selectOutput(Output::NONE);
+            break;
+
+        case Opcode::CopybackProgram:
+            sequence = Sequence::COPYBACK_PROGRAM;
+            addressCount = 0U;
+            selectOutput(Output::NONE);
+            break;
+
+        case Opcode::PageProgramMultiPlaneConfirm: {
+            const Row row = decodeRow(2U);
+
+            if ((sequence != Sequence::PROGRAM) or (addressCount != AddressCyclesMax) or (not isRowValid(row))
+                or (queuedProgramCount >= PlaneCount)) {
+                protocolViolations++;
+                sequence = Sequence::NONE;
+                queuedProgramCount = 0U;
+                break;
+            }
+
+            queuedProgramRows[queuedProgramCount++] = row;
+            sequence = Sequence::NONE;
+            readyAt = etl::max(Clock::now(), readyAt) + std::chrono::microseconds(timing.dummyBusyUs);
+            break;
+        }
+
+        case Opcode::PageProgramConfirm:
+        case Opcode::PageProgramCache: {
+            const bool IsProgramSequence = (sequence == Sequence::PROGRAM) or (sequence == Sequence::COPYBACK_PROGRAM);
+
+            if ((not IsProgramSequence) or (addressCount != AddressCyclesMax)) {
+                protocolViolations++;
+                sequence = Sequence::NONE;
+                queuedProgramCount = 0U;
+                break;
+            }
+
+            const Row row = decodeRow(2U);
+            const bool HasFailed = writeProtected or (not isRowValid(row));
+            dataRegisterValid = false;
+
+            if (not HasFailed) {
+                for (uint8_t index = 0U; index < queuedProgramCount; index++) {
+                    programPage(queuedProgramRows[index]);
+                }
+
+                programPage(row);
+            }
+
+            queuedProgramCount = 0U;
+
+            failStatus = static_cast<uint8_t>(((failStatus & StatusFail) != 0U) ? StatusFailCommand : 0U);
+            failStatus |= HasFailed ? StatusFail : 0U;
+            sequence = Sequence::NONE;
+
+            const Clock::time_point Start = etl::max(Clock::now(), arrayReadyAt);
+
+            if (command == Opcode::PageProgramCache) {
+                readyAt = Start + std::chrono::microseconds(timing.cacheBusyUs);
+                arrayReadyAt = readyAt + std::chrono::microseconds(timing.programUs);
+            } else {
+                readyAt = Start + std::chrono::microseconds(timing.programUs);
+                arrayReadyAt = readyAt;
+            }
+            break;
+        }
+
+        case Opcode::EraseBlock:
+            sequence = Sequence::ERASE;
+            addressCount = 0U;
+            selectOutput(Output::NONE);
+            break;
+
+        case Opcode::EraseMultiPlaneConfirm:
+        case Opcode::EraseBlockConfirm: {
+            const Row row = decodeRow(0U);
+
+            if ((sequence != Sequence::ERASE) or (addressCount != RowAddressCycles) or (not isRowValid(row))
+                or (queuedEraseCount >= PlaneCount)) {
+                protocolViolations++;
+                sequence = Sequence::NONE;
+                queuedEraseCount = 0U;
+                break;
+            }
+
+            queuedEraseBlocks[queuedEraseCount++] = row.block;
+            sequence = Sequence::NONE;
+
+            if (command == Opcode::EraseMultiPlaneConfirm) {
+                break;
+            }
+
+            failStatus = writeProtected ? StatusFail : 0U;
+            dataRegisterValid = false;
+
+            if (not writeProtected) {
+                for (uint8_t index = 0U; index < queuedEraseCount; index++) {
+                    eraseBlock(queuedEraseBlocks[index]);
+                }
+            }
+
+            queuedEraseCount = 0U;
+            startBusy(timing.eraseUs);
+            break;
+        }
+
+        default:
+            protocolViolations++;
+            break;
+    }
+}
+
+void MT29FSimulator::writeAddress(uint8_t address) {
+    if (isInterfaceBusy()) {
+        protocolViolations++;
+        return;
+    }
+
+    switch (sequence) {
+        case Sequence::READ_ID:
+            if ((addressCount != 0U) or ((address != ReadIdManufacturerAddress) and (address != ReadIdOnfiAddress))) {
+                protocolViolations++;
+                break;
+            }
+
+            if (address == ReadIdManufacturerAddress) {
+                etl::copy(DeviceId.begin(), DeviceId.end(), idOutput.begin());
+                idLength = DeviceId.size();
+            } else {
+                etl::copy(OnfiSignature.begin(), OnfiSignature.end(), idOutput.begin());
+                idLength = OnfiSignature.size();
+            }
+
+            addressCount = 1U;
+            outputPointer = 0U;
+            selectOutput(Output::ID);
+            break;
+
+        case Sequence::READ_PARAMETER_PAGE:
+            if (address != 0U) {
+                protocolViolations++;
+                break;
+            }
+
+            buildParameterPage();
+            outputPointer = 0U;
+            selectOutput(Output::PARAMETER_PAGE);
+            sequence = Sequence::NONE;
+            startBusy(timing.readUs);
+            break;
+
+        case Sequence::SET_FEATURES:
+        case Sequence::GET_FEATURES:
+            if ((addressCount != 0U) or ((address != TimingModeFeatureAddress) and (address != ReadRetryFeatureAddress))) {
+                protocolViolations++;
+                break;
+            }
+
+            addressCount = 1U;
+            featureAddress = address;
+
+            if (sequence == Sequence::GET_FEATURES) {
+                outputPointer = 0U;
+                selectOutput(Output::FEATURES);
+                sequence = Sequence::NONE;
+                startBusy(timing.featureUs);
+            }
+            break;
+
+        case Sequence::PROGRAM:
+        case Sequence::COPYBACK_PROGRAM:
+            if (isChangingWriteColumn) {
+                addressCycles[writeColumnCount++] = address;
+
+                if (writeColumnCount == ColumnAddressCycles) {
+                    columnPointer = decodeColumn();
+                    isChangingWriteColumn = false;
+                }
+                break;
+            }
+            [[fallthrough]];
+
+        case Sequence::READ:
+        case Sequence::CHANGE_READ_COLUMN_ENHANCED:
+            if (addressCount >= AddressCyclesMax) {
+                protocolViolations++;
+                break;
+            }
+
+            addressCycles[addressCount++] = address;
+
+            if (addressCount == AddressCyclesMax) {
+                onAddressComplete();
+            }
+            break;
+
+        case Sequence::CHANGE_READ_COLUMN:
+            if (addressCount >= ColumnAddressCycles) {
+                protocolViolations++;
+                break;
+            }
+
+            addressCycles[addressCount++] = address;
+            break;
+
+        case Sequence::ERASE:
+            if (addressCount >= RowAddressCycles) {
+                protocolViolations++;
+                break;
+            }
+
+            addressCycles[addressCount++] = address;
+            break;
+
+        default:
+            protocolViolations++;
+            break;
+    }
+}
+
+void MT29FSimulator::writeData(uint8_t data) {
+    if (sequence == Sequence::SET_FEATURES) {
+        if (isInterfaceBusy() or (addressCount != 1U)) {
+            protocolViolations++;
+            return;
+        }
+
+        featureInput[featureInputCount++] = data;
+
+        if (featureInputCount < FeatureParameterCount) {
+            return;
+        }
+
+        if (featureAddress == ReadRetryFeatureAddress) {
+            if (featureInput[0] > HighestReadRetryOption) {
+                protocolViolations++;
+            } else {
+                readRetryFeature = featureInput;
+            }
+        } else if (featureInput[0] > HighestTimingMode) {
+            protocolViolations++;
+        } else {
+            timingModeFeature = featureInput;
+        }
+
+        sequence = Sequence::NONE;
+        startBusy(timing.featureUs);
+        return;
+    }
+
+    const bool IsProgramSequence = (sequence == Sequence::PROGRAM) or (sequence == Sequence::COPYBACK_PROGRAM);
+
+    if (isInterfaceBusy() or (not IsProgramSequence) or (addressCount != AddressCyclesMax) or isChangingWriteColumn
+        or (columnPointer >= PageSize)) {
+        protocolViolations++;
+        return;
+    }
+
+    pageRegisters[selectedPlane][columnPointer++] = data;
+}
+
+uint8_t MT29FSimulator::readData() {
+    if (output == Output::STATUS) {
+        return statusRegister();
+    }
+
+    if (isInterfaceBusy()) {
+        protocolViolations++;
+        return 0U;
+    }
+
+    switch (output) {
+        case Output::ID:
+            if (outputPointer < idLength) {
+                return idOutput[outputPointer++];
+            }
+            break;
+
+        case Output::PARAMETER_PAGE:
+            if (outputPointer < (ParameterPageSize * ParameterPageCopies)) {
+                return parameterPage[(outputPointer++) % ParameterPageSize];
+            }
+            break;
+
+        case Output::FEATURES:
+            if (outputPointer < FeatureParameterCount) {
+                return (featureAddress == ReadRetryFeatureAddress) ? readRetryFeature[outputPointer++]
+                                                                   : timingModeFeature[outputPointer++];
+            }
+            break;
+
+        case Output::PAGE_REGISTER:
+            if (columnPointer < PageSize) {
+                return pageRegisters[selectedPlane][columnPointer++];
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    protocolViolations++;
+    return 0U;
+}
+
+bool MT29FSimulator::isBusy() {
+    return isInterfaceBusy();
+}
+
+
+/* ============= Test Hooks ============= */
+
+void MT29FSimulator::markFactoryBadBlock(uint16_t block) {
+    if (block >= MT29FGeometry::BlocksPerLun) {
+        return;
+    }
+
+    PageRegister page;
+    readArray(pageOffset(block, 0U), page);
+    page[MT29FGeometry::DataBytesPerPage] = 0x00U;
+    writeArray(pageOffset(block, 0U), page);
+}
+
+void MT29FSimulator::degradeBlock(uint16_t block, uint8_t readableOption) {
+    if (block < MT29FGeometry::BlocksPerLun) {
+        readableRetryOptions[block] = readableOption;
+    }
+}
+
+
+/* ============= Device Model ============= */
+
+void MT29FSimulator::selectOutput(Output source) {
+    output = source;
+    dataOutput = source;
+}
+
+bool MT29FSimulator::isInterfaceBusy() const {
+    return Clock::now() < readyAt;
+}
+
+bool MT29FSimulator::isArrayBusy() const {
+    return Clock::now() < arrayReadyAt;
+}
+
+void MT29FSimulator::startBusy(uint32_t microseconds) {
+    readyAt = Clock::now() + std::chrono::microseconds(microseconds);
+    arrayReadyAt = readyAt;
+}
+
+void MT29FSimulator::startCacheRead(const Row* nextRow) {
+    const Clock::time_point Start = etl::max(Clock::now(), arrayReadyAt);
+
+    selectedPlane = dataRegisterRow.block & 1U;
+    pageRegisters[selectedPlane] = dataRegister;
+    columnPointer = 0U;
+    selectOutput(Output::PAGE_REGISTER);
+
+    readyAt = Start + std::chrono::microseconds(timing.cacheBusyUs);
+    arrayReadyAt = readyAt;
+
+    if (nextRow == nullptr) {
+        dataRegisterValid = false;
+        return;
+    }
+
+    readArray(pageOffset(nextRow->block, nextRow->page), dataRegister);
+    dataRegisterRow = *nextRow;
+    arrayReadyAt += std::chrono::microseconds(timing.readUs);
+}
+
+uint8_t MT29FSimulator::statusRegister() const {
+    uint8_t status = failStatus;
+
+    if (not writeProtected) {
+        status |= StatusWriteProtect;
+    }
+
+    if (not isInterfaceBusy()) {
+        status |= StatusReady;
+    }
+
+    if (not isArrayBusy()) {
+        status |= StatusArrayReady;
+    }
+
+    return status;
+}
+
+MT29FSimulator::Row MT29FSimulator::decodeRow(uint8_t firstRowCycle) const {
+    const uint8_t Row1 = addressCycles[firstRowCycle];
+    const uint8_t Row2 = addressCycles[firstRowCycle + 1U];
+    const uint8_t Row3 = addressCycles[firstRowCycle + 2U];
+
+    return Row {
+        static_cast<uint32_t>((Row3 >> 3U) & 0x01U),
+        static_cast<uint32_t>(((Row1 >> 7U) & 0x01U) | (static_cast<uint32_t>(Row2) << 1U) | ((Row3 & 0x07U) << 9U)),
+        static_cast<uint32_t>(Row1 & 0x7FU),
+    };
+}
+
+uint32_t MT29FSimulator::decodeColumn() const {
+    return addressCycles[0] | ((addressCycles[1] & 0x3FU) << 8U);
+}
+
+bool MT29FSimulator::isRowValid(const Row& row) {
+    return (row.lun < MT29FGeometry::LunsPerCe) and (row.block < MT29FGeometry::BlocksPerLun) and (row.page < MT29FGeometry::PagesPerBlock);
+}
+
+void MT29FSimulator::onAddressComplete() {
+    const Row row = decodeRow(2U);
+
+    if ((not isRowValid(row)) or (sequence == Sequence::CHANGE_READ_COLUMN_ENHANCED)) {
+        return;
+    }
+
+    selectedPlane = row.block & 1U;
+    columnPointer = decodeColumn();
+
+    if (sequence == Sequence::PROGRAM) {
+        pageRegisters[selectedPlane].fill(ErasedByte);
+    }
+}
+
+void MT29FSimulator::loadPage(const Row& row) {
+    selectedPlane = row.block & 1U;
+    readArray(pageOffset(row.block, row.page), dataRegister);
+
+    const uint8_t ReadableOption = readableRetryOptions[row.block];
+
+    if ((ReadableOption != NotDegraded) and (ReadableOption != readRetryFeature[0])) {
+        for (uint32_t index = 0U; index < PageSize; index += DegradedBitInterval) {
+            dataRegister[index] ^= 0x01U;
+        }
+    }
+
+    pageRegisters[selectedPlane] = dataRegister;
+    dataRegisterRow = row;
+    dataRegisterValid = true;
+}
+
+void MT29FSimulator::programPage(const Row& row) {
+    PageRegister page;
+    readArray(pageOffset(row.block, row.page), page);
+
+    const PageRegister& Source = pageRegisters[row.block & 1U];
+
+    for (uint32_t index = 0U; index < PageSize; index++) {
+        page[index] &= Source[index];
+    }
+
+    writeArray(pageOffset(row.block, row.page), page);
+}
+
+void MT29FSimulator::eraseBlock(uint32_t block) {
+    constexpr off_t BlockSize = static_cast<off_t>(MT29FGeometry::PagesPerBlock) * PageSize;
+
+    if (fallocate(fileDescriptor, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, pageOffset(block, 0U), BlockSize) == 0) {
+        return;
+    }
+
+    PageRegister erased;
+    erased.fill(ErasedByte);
+
+    for (uint32_t page = 0U; page < MT29FGeometry::PagesPerBlock; page++) {
+        writeArray(pageOffset(block, page), erased);
+    }
+}
+
+void MT29FSimulator::buildParameterPage() {
+    constexpr uint16_t CrcPolynomial = 0x8005U;
+    constexpr uint16_t CrcInitialValue = 0x4F4EU;
+    constexpr size_t CrcDataLength = 254U;
+
+    auto putLittleEndian = [this](size_t offset, uint32_t value, uint8_t size) {
+        for (uint8_t index = 0U; index < size; index++) {
+            parameterPage[offset + index] = static_cast<uint8_t>(value >> (8U * index));
+        }
+    };
+
+    auto putString = [this](size_t offset, const char* text, size_t fieldLength) {
+        for (size_t index = 0U; index < fieldLength; index++) {
+            parameterPage[offset + index] = (*text != '\0') ? static_cast<uint8_t>(*text++) : static_cast<uint8_t>(' ');
+        }
+    };
+
+    parameterPage.fill(0U);
+
+    etl::copy(OnfiSignature.begin(), OnfiSignature.end(), parameterPage.begin());
+    putLittleEndian(4U, 0x0004U, 2U);                       /* ONFI 2.0 */
+    putString(32U, "MICRON", 12U);
+    putString(44U, "MT29F64G08AFAAAWP", 20U);
+    parameterPage[64U] = DeviceId[0];
+    putLittleEndian(80U, MT29FGeometry::DataBytesPerPage, 4U);
+    putLittleEndian(84U, MT29FGeometry::SpareBytesPerPage, 2U);
+    putLittleEndian(92U, MT29FGeometry::PagesPerBlock, 4U);
+    putLittleEndian(96U, MT29FGeometry::BlocksPerLun, 4U);
+    parameterPage[100U] = MT29FGeometry::LunsPerCe;
+    parameterPage[101U] = 0x23U;                             /* 3 row, 2 column address cycles */
+    parameterPage[102U] = 2U;                                /* MLC */
+    putLittleEndian(129U, 0x003FU, 2U);                      /* Asynchronous timing modes 0-5 */
+
+    uint16_t crc = CrcInitialValue;
+
+    for (size_t index = 0U; index < CrcDataLength; index++) {
+        crc ^= static_cast<uint16_t>(parameterPage[index]) << 8U;
+
+        for (uint8_t bit = 0U; bit < 8U; bit++) {
+            crc = ((crc & 0x8000U) != 0U) ? static_cast<uint16_t>((crc << 1U) ^ CrcPolynomial) : static_cast<uint16_t>(crc << 1U);
+        }
+    }
+
+    putLittleEndian(CrcDataLength, crc, 2U);
+}
+
+
+/* ============= Backing File ============= */
+
+off_t MT29FSimulator::pageOffset(uint32_t block, uint32_t page) {
+    return ((static_cast<off_t>(block) * MT29FGeometry::PagesPerBlock) + page) * PageSize;
+}
+
+void MT29FSimulator::readArray(off_t offset, etl::span<uint8_t> data) const {
+    const ssize_t BytesRead = (fileDescriptor >= 0) ? pread(fileDescriptor, data.data(), data.size(), offset) : 0;
+    const size_t ValidBytes = (BytesRead > 0) ? static_cast<size_t>(BytesRead) : 0U;
+
+    etl::fill(data.begin() + ValidBytes, data.end(), 0U);
+
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(~byte);
+    }
+}
+
+void MT29FSimulator::writeArray(off_t offset, etl::span<const uint8_t> data) const {
+    PageRegister inverted;
+    const size_t Length = etl::min<size_t>(data.size(), inverted.size());
+
+    for (size_t index = 0U; index < Length; index++) {
+        inverted[index] = static_cast<uint8_t>(~data[index]);
+    }
+
+    if (fileDescriptor >= 0) {
+        static_cast<void>(pwrite(fileDescriptor, inverted.data(), Length, offset));
+    }
+}
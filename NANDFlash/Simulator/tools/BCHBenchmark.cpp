@@ -0,0 +1,110 @@
+/**
+ * @file
+ * Benchmark of BCHCodec on 1 KiB sectors (host only).
+ *
+ * Times encode() and decode() of a clean sector, and decode() of sectors with 1 to 24 random bit
+ * errors spread over data and parity, checking that every error is corrected. BCHCodec needs
+ * nothing but ETL, so only BCHCodec.cpp has to be built with this file.
+ *
+ * Usage: BCHBenchmark [iterations]
+ */
+
+#include "BCHCodec.hpp"
+#include <etl/array.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr size_t SectorBytes = BCHCodec::MaxDataBytes;
+
+    constexpr uint32_t CodewordBits = (SectorBytes + BCHCodec::ParityBytes) * 8U;
+
+    using Clock = std::chrono::steady_clock;
+
+    double getMicroseconds(Clock::time_point start, uint32_t iterations) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / iterations;
+    }
+
+    void flipBit(std::vector<uint8_t>& data, etl::array<uint8_t, BCHCodec::ParityBytes>& parity, uint32_t bit) {
+        const uint8_t Mask = static_cast<uint8_t>(0x80U >> (bit % 8U));
+
+        if (bit < (SectorBytes * 8U)) {
+            data[bit / 8U] ^= Mask;
+        } else {
+            parity[(bit / 8U) - SectorBytes] ^= Mask;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const auto Iterations = static_cast<uint32_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 0) : 2000U);
+
+    std::mt19937 generator(1U);
+    std::vector<uint8_t> data(SectorBytes);
+    etl::array<uint8_t, BCHCodec::ParityBytes> parity{};
+
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(generator());
+    }
+
+    auto start = Clock::now();
+
+    for (uint32_t iteration = 0U; iteration < Iterations; iteration++) {
+        BCHCodec::encode(data, parity);
+    }
+
+    std::printf("encode              %8.2f us/sector\n", getMicroseconds(start, Iterations));
+
+    start = Clock::now();
+
+    for (uint32_t iteration = 0U; iteration < Iterations; iteration++) {
+        if (BCHCodec::decode(data, parity) != 0U) {
+            std::printf("FAIL clean sector\n");
+            return 1;
+        }
+    }
+
+    std::printf("decode, clean       %8.2f us/sector\n", getMicroseconds(start, Iterations));
+
+    for (const uint8_t Errors : { 1U, 4U, 8U, 16U, 24U }) {
+        std::vector<std::vector<uint32_t>> errorBits(Iterations);
+
+        /* Distinct error positions drawn before timing */
+        for (auto& bits : errorBits) {
+            while (bits.size() < Errors) {
+                const uint32_t Bit = generator() % CodewordBits;
+
+                if (std::find(bits.begin(), bits.end(), Bit) == bits.end()) {
+                    bits.push_back(Bit);
+                }
+            }
+        }
+
+        const std::vector<uint8_t> CleanData = data;
+        const auto CleanParity = parity;
+        double totalUs = 0.0;
+
+        for (const auto& bits : errorBits) {
+            for (const uint32_t Bit : bits) {
+                flipBit(data, parity, Bit);
+            }
+
+            start = Clock::now();
+            const auto Corrected = BCHCodec::decode(data, parity);
+            totalUs += getMicroseconds(start, 1U);
+
+            if ((Corrected != Errors) or (data != CleanData) or (parity != CleanParity)) {
+                std::printf("FAIL %u errors not corrected\n", Errors);
+                return 1;
+            }
+        }
+
+        std::printf("decode, %2u errors   %8.2f us/sector\n", Errors, totalUs / Iterations);
+    }
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file
+ * Write amplification of NANDFTL garbage collection on top of MT29FSimulator (host only).
+ *
+ * For each victim selection policy, formats the FTL with a mapping table covering fillPercent of
+ * getMaxSectorCount(), writes every sector once, then overwrites sectors at random with a hot/cold
+ * skew: 80% of the writes go to the first 20% of the sectors. Prints the write amplification of the
+ * overwrite phase, (hostPageWrites + copybackMoves + hostMoves) / hostPageWrites, with the
+ * collections and erases it took, and finally reads every sector back and checks its last version.
+ * The simulator busy times are set to 0: the figure of interest is the page count, not the time.
+ * The run covers the whole device (about 4.5 GB of backing file) and is CPU bound by the simulator
+ * and the software ECC: the defaults take about 40 minutes.
+ *
+ * Usage: FTLBenchmark <backing file> [fill percent] [overwrites per sector]
+ */
+
+#include "NANDFlash.hpp"
+#include "NANDFTL.hpp"
+#include "LittleEndian.hpp"
+#include "MT29FSimulator.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr uint32_t HotSectorPercent = 20U;
+
+    constexpr uint32_t HotWritePercent = 80U;
+
+    const char* getName(NANDFTL::GcPolicy policy) {
+        return (policy == NANDFTL::GcPolicy::GREEDY) ? "greedy" : "cost-benefit";
+    }
+
+    /**
+     * @brief Sector data identifying the sector and its version.
+     */
+    void fillSector(uint32_t sector, uint32_t version, std::vector<uint8_t>& data) {
+        for (size_t index = 0U; index < data.size(); index++) {
+            data[index] = static_cast<uint8_t>((index * 7U) + sector + (version * 13U));
+        }
+
+        LittleEndian::storeWord(data, 0U, sector);
+        LittleEndian::storeWord(data, 4U, version);
+    }
+
+    /**
+     * @return false if the FTL failed or a sector did not read back
+     */
+    bool runPass(MT29F& nand, NANDFTL::GcPolicy policy, uint32_t fillPercent, uint32_t overwritesPerSector) {
+        std::optional<NANDFTL> ftl;
+        std::vector<uint32_t> mappingTable;
+
+        {
+            NANDFTL probe(nand, etl::span<uint32_t>{});
+
+            mappingTable.resize((static_cast<uint64_t>(probe.getMaxSectorCount()) * fillPercent) / 100U);
+        }
+
+        ftl.emplace(nand, etl::span<uint32_t>(mappingTable.data(), mappingTable.size()), policy);
+
+        if (not ftl->format().has_value()) {
+            std::printf("FAIL format\n");
+            return false;
+        }
+
+        const auto Sectors = static_cast<uint32_t>(mappingTable.size());
+        const uint32_t HotSectors = (Sectors * HotSectorPercent) / 100U;
+        std::vector<uint32_t> versions(Sectors, 0U);
+        std::vector<uint8_t> data(NANDFTL::SectorBytes);
+        std::mt19937 generator(1U);
+
+        for (uint32_t sector = 0U; sector < Sectors; sector++) {
+            fillSector(sector, 0U, data);
+
+            if (not ftl->write(sector, data).has_value()) {
+                std::printf("FAIL fill sector %u\n", sector);
+                return false;
+            }
+        }
+
+        const NANDFTL::Statistics Before = ftl->getStatistics();
+        const uint64_t Overwrites = static_cast<uint64_t>(Sectors) * overwritesPerSector;
+
+        for (uint64_t write = 0U; write < Overwrites; write++) {
+            const uint32_t Sector = ((generator() % 100U) < HotWritePercent) ? (generator() % HotSectors)
+                                                                             : (HotSectors + (generator() % (Sectors - HotSectors)));
+
+            fillSector(Sector, ++versions[Sector], data);
+
+            if (not ftl->write(Sector, data).has_value()) {
+                std::printf("FAIL overwrite sector %u\n", Sector);
+                return false;
+            }
+        }
+
+        const NANDFTL::Statistics& After = ftl->getStatistics();
+        const uint64_t HostWrites = After.hostPageWrites - Before.hostPageWrites;
+        const uint64_t Moves = (After.copybackMoves - Before.copybackMoves) + (After.hostMoves - Before.hostMoves);
+
+        std::printf("%-12s sectors %6u (%u%%)  write amplification %5.2f  collections %6u  erases %6u  copyback %5.1f%%\n",
+                    getName(policy), Sectors, fillPercent,
+                    static_cast<double>(HostWrites + Moves) / static_cast<double>(HostWrites),
+                    After.garbageCollections - Before.garbageCollections, After.blockErases - Before.blockErases,
+                    (Moves == 0U) ? 0.0
+                                  : (100.0 * static_cast<double>(After.copybackMoves - Before.copybackMoves) /
+                                     static_cast<double>(Moves)));
+
+        for (uint32_t sector = 0U; sector < Sectors; sector++) {
+            std::vector<uint8_t> expected(NANDFTL::SectorBytes);
+
+            fillSector(sector, versions[sector], expected);
+
+            if (not ftl->read(sector, data).has_value() or (data != expected)) {
+                std::printf("FAIL read back sector %u\n", sector);
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::printf("Usage: %s <backing file> [fill percent] [overwrites per sector]\n", argv[0]);
+        return 2;
+    }
+
+    const auto FillPercent = static_cast<uint32_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 0) : 80U);
+    const auto OverwritesPerSector = static_cast<uint32_t>((argc > 3) ? std::strtoul(argv[3], nullptr, 0) : 3U);
+
+    if ((FillPercent == 0U) or (FillPercent > 100U)) {
+        std::printf("FAIL fill percent must be 1 to 100\n");
+        return 2;
+    }
+
+    MT29FSimulator simulator(argv[1], MT29FSimulator::Timing{0U, 0U, 0U, 0U, 0U, 0U, 0U});
+
+    if (not simulator.isOpen()) {
+        std::printf("FAIL cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    MT29F nand(simulator, YieldDelegate{});
+
+    if (not nand.initialize().has_value()) {
+        std::printf("FAIL initialize\n");
+        return 1;
+    }
+
+    for (const NANDFTL::GcPolicy Policy : { NANDFTL::GcPolicy::GREEDY, NANDFTL::GcPolicy::COST_BENEFIT }) {
+        if (not runPass(nand, Policy, FillPercent, OverwritesPerSector)) {
+            return 1;
+        }
+    }
+
+    return (simulator.getProtocolViolations() == 0U) ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file
+ * Benchmark of the compression stage of NANDLogStore on top of MT29FSimulator (host only).
+ *
+ * Appends the same records once raw and once with isCompressing, for three kinds of data (slowly
+ * varying temperature samples, a noisy ADC trace and text log lines), with the simulator modelling
+ * the datasheet busy times. Prints the compression ratio, the pages programmed and the effective
+ * append throughput from the log statistics, then reads every record back and checks it. The noisy
+ * ADC trace is there to show the fallback: LZ4 finds no matches in it, so it is stored raw.
+ *
+ * Usage: LogStoreBenchmark <backing file> [records]
+ */
+
+#include "NANDFlash.hpp"
+#include "NANDLogStore.hpp"
+#include "MT29FSimulator.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr uint16_t FirstBlock = 256U;
+
+    constexpr uint16_t SegmentCount = 64U;
+
+    enum class DataKind : uint8_t {
+        TEMPERATURE,
+        ADC_TRACE,
+        TEXT_LOG,
+    };
+
+    const char* getName(DataKind kind) {
+        switch (kind) {
+            case DataKind::TEMPERATURE:
+                return "temperature";
+            case DataKind::ADC_TRACE:
+                return "adc trace";
+            default:
+                return "text log";
+        }
+    }
+
+    /**
+     * @brief Payload of record number index, the same on every call.
+     */
+    std::vector<uint8_t> makeRecord(DataKind kind, uint32_t index) {
+        std::mt19937 generator(index);
+        std::vector<uint8_t> record;
+
+        switch (kind) {
+            case DataKind::TEMPERATURE: {
+                /* 16 rounds of 16 little endian centidegree sensors drifting slowly, one reading in 8 off by one */
+                for (uint32_t sample = 0U; sample < 256U; sample++) {
+                    const auto Value = static_cast<int16_t>(2100U + (100U * (sample % 16U)) + ((index + sample) / 64U) +
+                                                            (((generator() % 8U) == 0U) ? 1U : 0U));
+
+                    record.push_back(static_cast<uint8_t>(Value));
+                    record.push_back(static_cast<uint8_t>(static_cast<uint16_t>(Value) >> 8U));
+                }
+                break;
+            }
+            case DataKind::ADC_TRACE: {
+                /* 1024 12-bit samples of a sine with 2 bits of noise */
+                for (uint32_t sample = 0U; sample < 1024U; sample++) {
+                    const double Phase = (static_cast<double>(sample) + index) * 0.05;
+                    const auto Value = static_cast<uint16_t>(2048.0 + (1500.0 * std::sin(Phase)) + (generator() % 4U));
+
+                    record.push_back(static_cast<uint8_t>(Value));
+                    record.push_back(static_cast<uint8_t>(Value >> 8U));
+                }
+                break;
+            }
+            default: {
+                static constexpr const char* Messages[] = {
+                    "EPS: battery voltage nominal",  "ADCS: sun sensor update",   "OBC: housekeeping collected",
+                    "COMMS: beacon transmitted",     "PAYLOAD: exposure started", "OBC: task watchdog kicked",
+                };
+                char line[96];
+
+                while (record.size() < 600U) {
+                    const auto Time = static_cast<uint32_t>((index * 10U) + record.size());
+                    const int Length = std::snprintf(line, sizeof(line), "[%08u] %s (%u)\n", Time,
+                                                     Messages[generator() % 6U], static_cast<uint32_t>(generator() % 100U));
+
+                    record.insert(record.end(), line, line + Length);
+                }
+                break;
+            }
+        }
+
+        std::memcpy(record.data(), &index, sizeof(index));
+
+        return record;
+    }
+
+    /**
+     * @return false if the log failed or a record did not read back
+     */
+    bool runPass(MT29F& nand, etl::span<NANDLogStore::IndexEntry> index, DataKind kind, uint32_t records,
+                 bool isCompressing) {
+        NANDLogStore log(nand, FirstBlock, index);
+
+        if (not log.format().has_value()) {
+            std::printf("FAIL format\n");
+            return false;
+        }
+
+        log.resetStatistics();
+
+        for (uint32_t record = 0U; record < records; record++) {
+            if (not log.append(record, makeRecord(kind, record), isCompressing).has_value()) {
+                std::printf("FAIL append %u\n", record);
+                return false;
+            }
+        }
+
+        if (not log.flush().has_value()) {
+            std::printf("FAIL flush\n");
+            return false;
+        }
+
+        const NANDLogStore::Statistics Statistics = log.getStatistics();
+        uint32_t readRecords = 0U;
+        bool isIntact = true;
+
+        auto sinkLambda = [&](uint32_t timestamp, etl::span<const uint8_t> payload) -> bool {
+            const std::vector<uint8_t> Expected = makeRecord(kind, timestamp);
+
+            isIntact = isIntact and (timestamp == readRecords) and (payload.size() == Expected.size()) and
+                       (std::memcmp(payload.data(), Expected.data(), Expected.size()) == 0);
+            readRecords++;
+
+            return true;
+        };
+
+        const uint32_t StartCycles = MT29F::readCycleCounter();
+
+        if (not log.readRange(0U, UINT32_MAX, NANDLogStore::RecordSink(sinkLambda)).has_value()) {
+            std::printf("FAIL readRange\n");
+            return false;
+        }
+
+        const uint32_t ReadUs = MT29F::getElapsedMicroseconds(StartCycles);
+
+        std::printf("%-12s %-10s ratio %5.2f  pages %5u  append %6.2f MB/s (compress %5.1f%% of it)  query %6.2f MB/s\n",
+                    getName(kind), isCompressing ? "compressed" : "raw",
+                    static_cast<double>(Statistics.payloadBytes) / static_cast<double>(Statistics.storedBytes),
+                    Statistics.programmedPages,
+                    static_cast<double>(Statistics.payloadBytes) / static_cast<double>(Statistics.busyUs),
+                    100.0 * static_cast<double>(Statistics.compressUs) / static_cast<double>(Statistics.busyUs),
+                    static_cast<double>(Statistics.payloadBytes) / static_cast<double>(ReadUs));
+
+        if (not isIntact or (readRecords != records)) {
+            std::printf("FAIL read back %u of %u records\n", readRecords, records);
+            return false;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::printf("Usage: %s <backing file> [records]\n", argv[0]);
+        return 2;
+    }
+
+    const auto Records = static_cast<uint32_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 0) : 2000U);
+
+    MT29FSimulator simulator(argv[1]);
+
+    if (not simulator.isOpen()) {
+        std::printf("FAIL cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    MT29F nand(simulator, YieldDelegate{});
+
+    if (not nand.initialize().has_value()) {
+        std::printf("FAIL initialize\n");
+        return 1;
+    }
+
+    static etl::array<NANDLogStore::IndexEntry, SegmentCount> index;
+
+    for (const DataKind Kind : { DataKind::TEMPERATURE, DataKind::ADC_TRACE, DataKind::TEXT_LOG }) {
+        if (not runPass(nand, index, Kind, Records, false) or not runPass(nand, index, Kind, Records, true)) {
+            return 1;
+        }
+    }
+
+    return (simulator.getProtocolViolations() == 0U) ? 0 : 1;
+}
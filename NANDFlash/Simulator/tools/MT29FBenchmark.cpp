@@ -0,0 +1,128 @@
+/**
+ * @file
+ * Benchmark of the basic MT29F operations on top of MT29FSimulator (host only).
+ *
+ * Times initialize(), eraseBlock(), programPage(), readPage() and copyback() with the simulator
+ * modelling the datasheet busy times (MT29FSimulator::Timing defaults), and prints the mean and worst
+ * latency of each and the page throughput. The busy times dominate, so the figures are close to the
+ * device limits and mostly show the driver overhead on top of them.
+ *
+ * Usage: MT29FBenchmark <backing file> [blocks]
+ */
+
+#include "NANDFlash.hpp"
+#include "MT29FSimulator.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    constexpr uint16_t FirstBlock = 64U;
+
+    struct Timer {
+        const char* name;
+        bool isPageTransfer = false;
+        uint64_t totalUs = 0U;
+        uint32_t worstUs = 0U;
+        uint32_t count = 0U;
+
+        void add(uint32_t elapsedUs) {
+            totalUs += elapsedUs;
+            worstUs = (elapsedUs > worstUs) ? elapsedUs : worstUs;
+            count++;
+        }
+
+        void print() const {
+            const double MeanUs = (count == 0U) ? 0.0 : (static_cast<double>(totalUs) / count);
+
+            std::printf("%-12s %8u calls  mean %9.1f us  worst %8u us", name, count, MeanUs, worstUs);
+
+            if (isPageTransfer and (MeanUs > 0.0)) {
+                std::printf("  %7.2f MB/s", MT29F::DataBytesPerPage / MeanUs);
+            }
+
+            std::printf("\n");
+        }
+    };
+
+    /**
+     * @brief Run call and add its duration to timer.
+     *
+     * @return false if the call failed
+     */
+    template <typename Call>
+    bool timeCall(Timer& timer, Call call) {
+        const uint32_t StartCycles = MT29F::readCycleCounter();
+        const bool IsSuccessful = call().has_value();
+
+        timer.add(MT29F::getElapsedMicroseconds(StartCycles));
+
+        if (not IsSuccessful) {
+            std::printf("FAIL %s\n", timer.name);
+        }
+
+        return IsSuccessful;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::printf("Usage: %s <backing file> [blocks]\n", argv[0]);
+        return 2;
+    }
+
+    const auto Blocks = static_cast<uint16_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 0) : 4U);
+
+    MT29FSimulator simulator(argv[1]);
+
+    if (not simulator.isOpen()) {
+        std::printf("FAIL cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    MT29F nand(simulator, YieldDelegate{});
+    Timer initializeTimer{"initialize"};
+    Timer eraseTimer{"eraseBlock"};
+    Timer programTimer{"programPage", true};
+    Timer readTimer{"readPage", true};
+    Timer copybackTimer{"copyback"};
+    std::vector<uint8_t> data(MT29F::DataBytesPerPage);
+
+    for (size_t index = 0U; index < data.size(); index++) {
+        data[index] = static_cast<uint8_t>((index * 31U) + (index >> 8U));
+    }
+
+    if (not timeCall(initializeTimer, [&] { return nand.initialize(); })) {
+        return 1;
+    }
+
+    /* Pairs of blocks of the same plane: the first one programmed and read, then copied back into the second */
+    for (uint16_t pair = 0U; pair < Blocks; pair++) {
+        const auto Source = static_cast<uint16_t>(FirstBlock + (4U * pair));
+        const auto Destination = static_cast<uint16_t>(Source + 2U);
+
+        if (not timeCall(eraseTimer, [&] { return nand.eraseBlock(Source); }) or
+            not timeCall(eraseTimer, [&] { return nand.eraseBlock(Destination); })) {
+            return 1;
+        }
+
+        for (uint32_t page = 0U; page < MT29F::PagesPerBlock; page++) {
+            const MT29F::NANDAddress Address(0U, Source, page);
+
+            if (not timeCall(programTimer, [&] { return nand.programPage(Address, data); }) or
+                not timeCall(readTimer, [&] { return nand.readPage(Address, data); }) or
+                not timeCall(copybackTimer, [&] { return nand.copyback(Address, MT29F::NANDAddress(0U, Destination, page)); })) {
+                return 1;
+            }
+        }
+    }
+
+    initializeTimer.print();
+    eraseTimer.print();
+    programTimer.print();
+    readTimer.print();
+    copybackTimer.print();
+    std::printf("protocol violations %u\n", simulator.getProtocolViolations());
+
+    return (simulator.getProtocolViolations() == 0U) ? 0 : 1;
+}
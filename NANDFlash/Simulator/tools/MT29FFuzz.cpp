@@ -0,0 +1,233 @@
+/**
+ * @file
+ * Fuzz driver for MT29F on top of MT29FSimulator (host only).
+ *
+ * Every round first feeds random command, address and data cycles straight into the simulator, with
+ * WP# asserted so that they cannot change the array. It then brings up a fresh MT29F on the same
+ * simulator, whose initialize() has to recover the device with a RESET, and runs random readPage(),
+ * programPage(), eraseBlock() and copyback() calls on a few blocks, checking every read against a
+ * model of the array. The driver calls must not add protocol violations.
+ *
+ * Usage: MT29FFuzz <backing file> [seed] [rounds]
+ *
+ * Exits with 1 on the first failure, after printing it.
+ */
+
+#include "NANDFlash.hpp"
+#include "MT29FSimulator.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr uint16_t FirstBlock = 64U;
+
+    constexpr uint16_t BlockCount = 8U;
+
+    constexpr uint32_t CyclesPerRound = 4000U;
+
+    constexpr uint32_t OperationsPerRound = 200U;
+
+    constexpr int32_t ErasedPage = -1;
+
+    /**
+     * @brief Content of the fuzzed blocks: the seed of the data of every page, or ErasedPage.
+     */
+    struct ArrayModel {
+        std::vector<int32_t> pageSeeds = std::vector<int32_t>(BlockCount * MT29F::PagesPerBlock, ErasedPage);
+
+        etl::array<uint8_t, BlockCount> nextPage{};
+
+        int32_t& at(uint16_t block, uint32_t page) {
+            return pageSeeds[((block - FirstBlock) * MT29F::PagesPerBlock) + page];
+        }
+    };
+
+    void fillPage(int32_t seed, etl::span<uint8_t> data) {
+        if (seed == ErasedPage) {
+            etl::fill(data.begin(), data.end(), 0xFFU);
+            return;
+        }
+
+        std::mt19937 generator(static_cast<uint32_t>(seed));
+
+        for (auto& byte : data) {
+            byte = static_cast<uint8_t>(generator());
+        }
+    }
+
+    void feedRandomCycles(MT29FSimulator& simulator, std::mt19937& generator) {
+        simulator.setWriteProtected(true);
+
+        for (uint32_t cycle = 0U; cycle < CyclesPerRound; cycle++) {
+            const auto Value = static_cast<uint8_t>(generator());
+
+            switch (generator() % 5U) {
+                case 0U:
+                    simulator.writeCommand(Value);
+                    break;
+                case 1U:
+                    simulator.writeAddress(Value);
+                    break;
+                case 2U:
+                    simulator.writeData(Value);
+                    break;
+                case 3U:
+                    (void) simulator.readData();
+                    break;
+                default:
+                    (void) simulator.isBusy();
+                    break;
+            }
+        }
+
+        simulator.setWriteProtected(false);
+    }
+
+    bool fail(const char* operation, uint16_t block, uint32_t page, const char* reason) {
+        std::printf("FAIL %s block %u page %u: %s\n", operation, block, page, reason);
+        return false;
+    }
+
+    /**
+     * @return false on the first read mismatch or failed call
+     */
+    bool runOperations(MT29F& nand, ArrayModel& model, std::mt19937& generator) {
+        std::vector<uint8_t> data(MT29F::DataBytesPerPage);
+        std::vector<uint8_t> expected(MT29F::DataBytesPerPage);
+
+        for (uint32_t operation = 0U; operation < OperationsPerRound; operation++) {
+            const auto Block = static_cast<uint16_t>(FirstBlock + (generator() % BlockCount));
+            uint8_t& nextPage = model.nextPage[Block - FirstBlock];
+
+            switch (generator() % 8U) {
+                case 0U: {
+                    if (not nand.eraseBlock(Block).has_value()) {
+                        return fail("eraseBlock", Block, 0U, "error");
+                    }
+
+                    for (uint32_t page = 0U; page < MT29F::PagesPerBlock; page++) {
+                        model.at(Block, page) = ErasedPage;
+                    }
+
+                    nextPage = 0U;
+                    break;
+                }
+                case 1U:
+                case 2U: {
+                    if (nextPage == MT29F::PagesPerBlock) {
+                        break;
+                    }
+
+                    const auto Seed = static_cast<int32_t>(generator() & 0x7FFFFFFFU);
+
+                    fillPage(Seed, data);
+
+                    if (not nand.programPage(MT29F::NANDAddress(0U, Block, nextPage), data).has_value()) {
+                        return fail("programPage", Block, nextPage, "error");
+                    }
+
+                    model.at(Block, nextPage) = Seed;
+                    nextPage++;
+                    break;
+                }
+                case 3U: {
+                    /* Any written page to the next page of a block of the same plane */
+                    const auto Source = static_cast<uint16_t>(FirstBlock + (generator() % BlockCount));
+                    const auto SourcePage = static_cast<uint32_t>(generator() % MT29F::PagesPerBlock);
+                    const auto Destination = static_cast<uint16_t>(Block ^ ((Block ^ Source) & 1U));
+                    uint8_t& destinationPage = model.nextPage[Destination - FirstBlock];
+
+                    if ((model.at(Source, SourcePage) == ErasedPage) or (destinationPage == MT29F::PagesPerBlock)) {
+                        break;
+                    }
+
+                    if (not nand.copyback(MT29F::NANDAddress(0U, Source, SourcePage),
+                                          MT29F::NANDAddress(0U, Destination, destinationPage)).has_value()) {
+                        return fail("copyback", Destination, destinationPage, "error");
+                    }
+
+                    model.at(Destination, destinationPage) = model.at(Source, SourcePage);
+                    destinationPage++;
+                    break;
+                }
+                default: {
+                    const auto Page = static_cast<uint32_t>(generator() % MT29F::PagesPerBlock);
+
+                    if (not nand.readPage(MT29F::NANDAddress(0U, Block, Page), data).has_value()) {
+                        return fail("readPage", Block, Page, "error");
+                    }
+
+                    fillPage(model.at(Block, Page), expected);
+
+                    if (data != expected) {
+                        return fail("readPage", Block, Page, "data differs from the model");
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::printf("Usage: %s <backing file> [seed] [rounds]\n", argv[0]);
+        return 2;
+    }
+
+    const auto Seed = static_cast<uint32_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 0) : 1U);
+    const auto Rounds = static_cast<uint32_t>((argc > 3) ? std::strtoul(argv[3], nullptr, 0) : 100U);
+
+    MT29FSimulator simulator(argv[1], MT29FSimulator::Timing{0U, 0U, 0U, 0U, 0U, 0U, 0U});
+
+    if (not simulator.isOpen()) {
+        std::printf("FAIL cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::mt19937 generator(Seed);
+    ArrayModel model;
+    uint32_t driverViolations = 0U;
+
+    for (uint32_t round = 0U; round < Rounds; round++) {
+        feedRandomCycles(simulator, generator);
+
+        std::optional<MT29F> nand;
+
+        nand.emplace(simulator, YieldDelegate{});
+
+        if (not nand->initialize().has_value()) {
+            std::printf("FAIL initialize after random cycles, round %u\n", round);
+            return 1;
+        }
+
+        /* The blocks start from whatever the backing file held */
+        if (round == 0U) {
+            for (uint16_t block = FirstBlock; block < (FirstBlock + BlockCount); block++) {
+                if (not nand->eraseBlock(block).has_value()) {
+                    return fail("eraseBlock", block, 0U, "error") ? 0 : 1;
+                }
+            }
+        }
+
+        const uint32_t ViolationsBefore = simulator.getProtocolViolations();
+
+        if (not runOperations(*nand, model, generator)) {
+            std::printf("round %u, seed %u\n", round, Seed);
+            return 1;
+        }
+
+        driverViolations += simulator.getProtocolViolations() - ViolationsBefore;
+    }
+
+    std::printf("rounds %u, random cycle violations %u, driver violations %u\n", Rounds,
+                simulator.getProtocolViolations() - driverViolations, driverViolations);
+
+    return (driverViolations == 0U) ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <etl/span.h>
+#include <etl/optional.h>
+
+/**
+ * @brief Binary BCH code over GF(2^14) correcting up to 24 bit errors per codeword.
+ *
+ * @details Matches the MT29F64G08AFAAAWP ECC requirement (24 bits per 1080 bytes) for 1 KiB sectors.
+ *          A codeword is the data bytes followed by ParityBytes of parity. The code is shortened, so
+ *          any data length up to MaxDataBytes can be protected with the same generator polynomial.
+ *
+ *          Bit order: data and parity are taken as one MSB-first bit stream, the first bit being the
+ *          highest degree coefficient of the codeword polynomial.
+ *
+ *          - Encoding runs a byte-wise LFSR driven by a 256-entry remainder table.
+ *          - Decoding re-encodes the data and compares the parity first, so a clean codeword costs
+ *            the same as an encode. Only a non-zero remainder goes through syndrome computation,
+ *            Berlekamp-Massey and a Chien search over the shortened code positions, which stops as
+ *            soon as all roots of the error locator have been found.
+ *
+ *          The Galois field and remainder tables are computed at compile time and live in flash.
+ */
+class BCHCodec {
+public:
+    static constexpr uint8_t GaloisFieldDegree = 14U;   /*!< m: codeword symbols are elements of GF(2^m) */
+
+    static constexpr uint8_t CorrectableBits = 24U;     /*!< t: bit errors corrected per codeword */
+
+    static constexpr uint16_t ParityBits = GaloisFieldDegree * CorrectableBits;
+
+    static constexpr size_t ParityBytes = ParityBits / 8U;
+
+    static constexpr size_t MaxDataBytes = 1024U;       /*!< Largest data length per codeword */
+
+    /**
+     * @brief Compute the parity of a codeword.
+     *
+     * @param data Data bytes (at most MaxDataBytes)
+     * @param[out] parity Parity bytes
+     */
+    static void encode(etl::span<const uint8_t> data, etl::span<uint8_t, ParityBytes> parity);
+
+    /**
+     * @brief Detect and correct bit errors in a codeword in place.
+     *
+     * @param data Data bytes (at most MaxDataBytes), corrected in place
+     * @param parity Parity bytes as read back, corrected in place
+     *
+     * @return Number of corrected bits, or etl::nullopt if the codeword has more errors than can be corrected
+     *         (data and parity are then left untouched)
+     */
+    [[nodiscard]] static etl::optional<uint8_t> decode(etl::span<uint8_t> data, etl::span<uint8_t, ParityBytes> parity);
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "NANDFlash.hpp"
+#include <etl/array.h>
+
+/**
+ * @brief Free blocks of an MT29F ordered by erase count, for dynamic wear leveling.
+ *
+ * @details One binary min-heap per plane, keyed on the erase count of each block, so that the least
+ *          worn free block of a plane is found in O(1) and inserted or removed in O(log n). A position
+ *          index per block makes membership tests O(1) and allows removing any block.
+ *
+ *          The erase counts are owned by the caller. The count of a block must not change while it is
+ *          in the pool: remove it, erase it, update the count and insert it again.
+ */
+class FreeBlockPool {
+public:
+    static constexpr uint16_t BlockCount = MT29F::UsableBlocksPerLun;
+
+    static constexpr uint8_t PlaneCount = 2U;
+
+    static constexpr uint16_t NoBlock = 0xFFFFU;
+
+    /**
+     * @param eraseCounts Erase count of each block (must outlive the pool)
+     */
+    explicit FreeBlockPool(const etl::array<uint32_t, BlockCount>& eraseCounts)
+        : eraseCounts{eraseCounts} {
+        clear();
+    }
+
+    FreeBlockPool(const FreeBlockPool&) = delete;
+    FreeBlockPool& operator=(const FreeBlockPool&) = delete;
+    FreeBlockPool(FreeBlockPool&&) = delete;
+    FreeBlockPool& operator=(FreeBlockPool&&) = delete;
+
+    ~FreeBlockPool() = default;
+
+    void clear();
+
+    /**
+     * @pre block < BlockCount and not in the pool
+     */
+    void insert(uint16_t block);
+
+    /**
+     * @brief Remove a block, ignored if it is not in the pool.
+     */
+    void remove(uint16_t block);
+
+    [[nodiscard]] bool contains(uint16_t block) const {
+        return positions[block] != NoPosition;
+    }
+
+    /**
+     * @return Least worn free block of a plane, NoBlock if the plane has none
+     */
+    [[nodiscard]] uint16_t peekLeastWorn(uint8_t plane) const {
+        return (heapSizes[plane] > 0U) ? heaps[plane][0] : NoBlock;
+    }
+
+    /**
+     * @brief Most worn free block of a plane, for data that will stay cold.
+     *
+     * @details O(n): scans the leaves of the heap. Only meant for static wear leveling.
+     *
+     * @return NoBlock if the plane has none
+     */
+    [[nodiscard]] uint16_t findMostWorn(uint8_t plane) const;
+
+    [[nodiscard]] uint16_t size() const {
+        return heapSizes[0] + heapSizes[1];
+    }
+
+    [[nodiscard]] uint16_t size(uint8_t plane) const {
+        return heapSizes[plane];
+    }
+
+private:
+    static constexpr uint16_t NoPosition = 0xFFFFU;
+
+    static constexpr uint16_t BlocksPerPlane = BlockCount / PlaneCount;
+
+    static_assert((BlockCount % PlaneCount) == 0U, "Planes must hold the same number of blocks");
+
+    const etl::array<uint32_t, BlockCount>& eraseCounts;
+
+    etl::array<etl::array<uint16_t, BlocksPerPlane>, PlaneCount> heaps{};
+
+    etl::array<uint16_t, PlaneCount> heapSizes{};
+
+    etl::array<uint16_t, BlockCount> positions{};   /*!< Index of each block in its plane heap */
+
+    [[nodiscard]] static uint8_t getPlane(uint16_t block) {
+        return static_cast<uint8_t>(MT29F::getPlane(block));
+    }
+
+    [[nodiscard]] bool isLessWorn(uint16_t block, uint16_t other) const {
+        return eraseCounts[block] < eraseCounts[other];
+    }
+
+    void place(uint8_t plane, uint16_t position, uint16_t block) {
+        heaps[plane][position] = block;
+        positions[block] = position;
+    }
+
+    void siftUp(uint8_t plane, uint16_t position);
+
+    void siftDown(uint8_t plane, uint16_t position);
+};
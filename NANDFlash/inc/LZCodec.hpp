@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <etl/array.h>
+#include <etl/optional.h>
+#include <etl/span.h>
+
+/**
+ * @brief Small-footprint LZ77 compressor producing the LZ4 block format.
+ *
+ * @details The output is a sequence of (literal run, match) pairs: a token byte holding the literal
+ *          length and match length - 4 in two nibbles (15 meaning more length bytes follow, each
+ *          adding up to 255), the literals, then the match as a 16-bit little endian backward offset.
+ *          The block ends with a literal-only sequence. Any LZ4 block decoder (e.g. LZ4_decompress_safe()
+ *          on the ground) decodes it.
+ *
+ *          - Compression is greedy with a single hash table entry per 4-byte prefix, the table being the
+ *            only working memory (HashEntries * 2 bytes, held by the object, never on the heap). The
+ *            search step grows on long literal runs, so incompressible data costs little.
+ *          - Decompression needs no working memory and checks every length and offset against both
+ *            buffers, so a corrupted block is rejected instead of overrunning memory.
+ *
+ *          Sensor samples, ADC traces and text logs typically shrink to a third or less; random data
+ *          grows by up to 1 byte in 255 plus a few bytes, in which case the caller should store it raw.
+ */
+class LZCodec {
+public:
+    static constexpr size_t MaxInputBytes = 65535U;     /*!< Positions and offsets are 16 bits */
+
+    static constexpr uint8_t HashBits = 12U;
+
+    static constexpr size_t HashEntries = 1U << HashBits;
+
+    /**
+     * @return Output size that holds the compressed form of any input of inputBytes bytes
+     */
+    [[nodiscard]] static constexpr size_t getMaxCompressedBytes(size_t inputBytes) {
+        return inputBytes + (inputBytes / 255U) + 16U;
+    }
+
+    /**
+     * @brief Compress a block.
+     *
+     * @param input At most MaxInputBytes bytes
+     * @param[out] output Compressed block
+     *
+     * @return Compressed size, or etl::nullopt if the input is too long or the output too small
+     *         (the output content is then undefined)
+     */
+    [[nodiscard]] etl::optional<size_t> compress(etl::span<const uint8_t> input, etl::span<uint8_t> output);
+
+    /**
+     * @brief Decompress a block.
+     *
+     * @param input Compressed block
+     * @param[out] output Buffer for the decompressed bytes
+     *
+     * @return Decompressed size, or etl::nullopt if the block is malformed or does not fit the output
+     */
+    [[nodiscard]] static etl::optional<size_t> decompress(etl::span<const uint8_t> input, etl::span<uint8_t> output);
+
+private:
+    etl::array<uint16_t, HashEntries> hashTable{};   /*!< Last input position of each 4-byte prefix hash */
+};
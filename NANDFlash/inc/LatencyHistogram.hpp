@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <etl/array.h>
+#include <etl/binary.h>
+
+/**
+ * @brief Latency distribution of one operation type, in power of two buckets of microseconds.
+ *
+ * @details Bucket 0 counts samples below 1 us and bucket b samples in [2^(b-1), 2^b) us; the last
+ *          bucket also takes everything longer. Recording a sample is a count leading zeros and a few
+ *          additions, so histograms can stay enabled in flight builds.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint8_t BucketCount = 24U;   /*!< Last bucket starts at about 4.2 s */
+
+    /**
+     * @return Exclusive upper bound of a bucket in microseconds, UINT32_MAX for the last one
+     */
+    [[nodiscard]] static constexpr uint32_t getBucketLimitUs(uint8_t bucket) {
+        return (bucket >= (BucketCount - 1U)) ? UINT32_MAX : (1UL << bucket);
+    }
+
+    void record(uint32_t microseconds) {
+        const uint8_t Bucket = static_cast<uint8_t>(32U - etl::count_leading_zeros(microseconds));
+
+        buckets[(Bucket < BucketCount) ? Bucket : (BucketCount - 1U)]++;
+        count++;
+        totalUs += microseconds;
+
+        if (microseconds > maxUs) {
+            maxUs = microseconds;
+        }
+    }
+
+    void reset() {
+        buckets.fill(0U);
+        count = 0U;
+        totalUs = 0U;
+        maxUs = 0U;
+    }
+
+    [[nodiscard]] uint32_t getCount() const {
+        return count;
+    }
+
+    [[nodiscard]] uint64_t getTotalUs() const {
+        return totalUs;
+    }
+
+    [[nodiscard]] uint32_t getMaxUs() const {
+        return maxUs;
+    }
+
+    [[nodiscard]] uint32_t getBucket(uint8_t bucket) const {
+        return (bucket < BucketCount) ? buckets[bucket] : 0U;
+    }
+
+    /**
+     * @brief Upper bound of a percentile, from the bucket boundaries.
+     *
+     * @param percent 0 to 100
+     *
+     * @return Bucket limit in microseconds below which at least percent of the samples fall, 0 without samples
+     */
+    [[nodiscard]] uint32_t getPercentileLimitUs(uint8_t percent) const {
+        const uint64_t Target = ((static_cast<uint64_t>(count) * percent) + 99U) / 100U;
+        uint64_t cumulative = 0U;
+
+        for (uint8_t bucket = 0U; (bucket < BucketCount) and (count > 0U); bucket++) {
+            cumulative += buckets[bucket];
+
+            if ((cumulative >= Target) and (cumulative > 0U)) {
+                return getBucketLimitUs(bucket);
+            }
+        }
+
+        return 0U;
+    }
+
+private:
+    etl::array<uint32_t, BucketCount> buckets{};
+
+    uint32_t count = 0U;
+
+    uint64_t totalUs = 0U;
+
+    uint32_t maxUs = 0U;
+};
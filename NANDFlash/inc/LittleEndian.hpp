@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <etl/span.h>
+
+/**
+ * @brief Little endian encoding of the integer fields of the on-media formats (bad block table, FTL tags
+ *        and journal, log store headers, LZ4 blocks).
+ *
+ * @details Byte by byte, so the fields need no alignment and the format does not depend on the CPU.
+ *          The compiler merges the accesses into single (unaligned) loads and stores on the Cortex-M7.
+ */
+class LittleEndian {
+public:
+    static void storeHalfWord(etl::span<uint8_t> bytes, size_t offset, uint16_t value) {
+        bytes[offset] = static_cast<uint8_t>(value);
+        bytes[offset + 1U] = static_cast<uint8_t>(value >> 8U);
+    }
+
+    [[nodiscard]] static uint16_t loadHalfWord(etl::span<const uint8_t> bytes, size_t offset) {
+        return static_cast<uint16_t>(static_cast<uint16_t>(bytes[offset]) | (static_cast<uint16_t>(bytes[offset + 1U]) << 8U));
+    }
+
+    static void storeWord(etl::span<uint8_t> bytes, size_t offset, uint32_t value) {
+        for (size_t index = 0U; index < sizeof(uint32_t); index++) {
+            bytes[offset + index] = static_cast<uint8_t>(value >> (8U * index));
+        }
+    }
+
+    [[nodiscard]] static uint32_t loadWord(etl::span<const uint8_t> bytes, size_t offset) {
+        uint32_t value = 0U;
+
+        for (size_t index = 0U; index < sizeof(uint32_t); index++) {
+            value |= static_cast<uint32_t>(bytes[offset + index]) << (8U * index);
+        }
+
+        return value;
+    }
+};
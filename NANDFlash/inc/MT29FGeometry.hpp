@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Array geometry of the MT29F64G08AFAAAWP.
+ *
+ * @details Shared by the MT29F driver and the host-side MT29FSimulator. Kept free of Harmony headers,
+ *          so the simulator builds on a plain host toolchain with only ETL.
+ */
+class MT29FGeometry {
+public:
+    static constexpr uint32_t DataBytesPerPage = 8192U;
+    static constexpr uint16_t SpareBytesPerPage = 448U;
+    static constexpr uint32_t TotalBytesPerPage = DataBytesPerPage + SpareBytesPerPage;
+    static constexpr uint8_t PagesPerBlock = 128U;
+    static constexpr uint16_t BlocksPerLun = 4096U;
+    static constexpr uint8_t LunsPerCe = 1U;
+    static constexpr uint8_t ReadRetryOptions = 8U;     /*!< Options of feature 89h, option 0 being the default read levels */
+};
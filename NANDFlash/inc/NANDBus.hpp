@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Bus backend for the MT29F NAND flash driver.
+ *
+ * @details By default MT29F drives the device directly through the SMC/EBI (CLE/ALE address
+ *          triggers and byte accesses on the chip select memory area). A NANDBus replaces those
+ *          raw bus cycles, so the very same command sequences can be run against a device model
+ *          (e.g. the host-side MT29FSimulator) for benchmarking, fuzzing and regression tests.
+ *
+ *          Implementations receive exactly what the device would see on its pins:
+ *          - writeCommand(): a cycle with CLE HIGH
+ *          - writeAddress(): a cycle with ALE HIGH
+ *          - writeData() / readData(): data cycles (WE# / RE# toggles)
+ *          - isBusy(): the level of the R/B# line
+ *
+ * @note The driver does not own the backend. The backend must outlive the MT29F instance.
+ */
+class NANDBus {
+public:
+    virtual ~NANDBus() = default;
+
+    /**
+     * @brief Latch a command byte (CLE cycle).
+     *
+     * @param command Command opcode
+     */
+    virtual void writeCommand(uint8_t command) = 0;
+
+    /**
+     * @brief Latch an address byte (ALE cycle).
+     *
+     * @param address Address cycle value
+     */
+    virtual void writeAddress(uint8_t address) = 0;
+
+    /**
+     * @brief Input one data byte (WE# cycle).
+     *
+     * @param data Data byte
+     */
+    virtual void writeData(uint8_t data) = 0;
+
+    /**
+     * @brief Output one data byte (RE# cycle).
+     *
+     * @return Data byte driven by the device
+     */
+    virtual uint8_t readData() = 0;
+
+    /**
+     * @brief Sample the R/B# line.
+     *
+     * @retval true R/B# is LOW (device busy)
+     * @retval false R/B# is HIGH (device ready)
+     */
+    virtual bool isBusy() = 0;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <etl/span.h>
+
+/**
+ * @brief DMA engine used by MT29F for the data phase of page transfers.
+ *
+ * @details The NAND data register is a single, fixed EBI address, so page data is moved with a
+ *          memory-to-memory transfer that keeps one side fixed and increments the other.
+ *          A transfer is started with startRead()/startWrite() and the calling task then blocks in
+ *          waitForCompletion(), letting other tasks run while the controller moves the page.
+ *
+ *          If startRead()/startWrite() return false (no channel available) the driver falls back
+ *          to the CPU byte loop, so an engine never has to queue requests.
+ *
+ * @see XDMACNANDDma for the ATSAMV71 implementation
+ */
+class NANDDmaEngine {
+public:
+    virtual ~NANDDmaEngine() = default;
+
+    /**
+     * @brief Start moving bytes from the NAND data register into memory.
+     *
+     * @param dataRegisterAddress EBI address of the NAND data register
+     * @param destination Destination buffer
+     *
+     * @retval true Transfer started
+     * @retval false No channel available, nothing was transferred
+     */
+    virtual bool startRead(uint32_t dataRegisterAddress, etl::span<uint8_t> destination) = 0;
+
+    /**
+     * @brief Start moving bytes from memory into the NAND data register.
+     *
+     * @param source Source buffer
+     * @param dataRegisterAddress EBI address of the NAND data register
+     *
+     * @retval true Transfer started
+     * @retval false No channel available, nothing was transferred
+     */
+    virtual bool startWrite(etl::span<const uint8_t> source, uint32_t dataRegisterAddress) = 0;
+
+    /**
+     * @brief Block the calling task until the started transfer completes.
+     *
+     * @param timeoutUs Maximum time to wait in microseconds
+     *
+     * @retval true Transfer completed without bus errors
+     * @retval false Transfer failed or timed out. The transfer has been stopped.
+     */
+    virtual bool waitForCompletion(uint32_t timeoutUs) = 0;
+};
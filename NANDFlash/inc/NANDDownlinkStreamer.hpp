@@ -0,0 +1,152 @@
+#pragma once
+
+#include "NANDFlash.hpp"
+#include <etl/delegate.h>
+#include <etl/expected.h>
+#include <etl/span.h>
+
+/**
+ * @brief Cuts a run of NAND pages into fixed-size transport packets, reading the page data straight
+ *        into the packets.
+ *
+ * @details The pages are read with readPagesSequential(). The data of each page is pulled from the
+ *          NAND data phase directly into the payload field of the packet being filled, so no page buffer
+ *          and no copy are involved. A packet whose payload is full gets its header and is passed to the
+ *          PacketSink while the device is already loading the next page (READ CACHE), and a payload may
+ *          continue over the next page.
+ *
+ *          With includeParity (the default), each page is sent as its data sectors followed by the BCH
+ *          parity of those sectors taken from the spare area (EccSectorsPerPage x ParityBytes for a full
+ *          page), so the ground decodes every 1 KiB sector with BCHCodec. The last page is sent up to the
+ *          end of its last sector. An erased sector has all-0xFF parity and must be recognized as erased,
+ *          as MT29F::readPageEcc() does. Without it, only the data area is sent.
+ *
+ *          Packets are built in a ring of slots in caller memory. A packet stays untouched until
+ *          slotCount - 1 more packets have been passed to the sink, so with 2 slots (double buffering) the
+ *          sink may start a DMA transfer of one packet and return while the next one is filled.
+ *
+ *          Without a HeaderWriter, the header starts with a CCSDS space packet primary header
+ *          (telemetry, no secondary header flag, unsegmented) carrying the APID, a 14-bit sequence count
+ *          and the data field length. The rest of the header is zero.
+ *
+ * @note The codewords are not decoded on board: the parity follows the data of the page, so a sector
+ *       could only be corrected once the packets carrying it were already handed to the sink.
+ *
+ * @note Thread Safety: Caller must hold the MT29F mutex during stream(), sink calls included.
+ */
+class NANDDownlinkStreamer {
+public:
+    static constexpr uint8_t CcsdsPrimaryHeaderBytes = 6U;
+
+    static constexpr uint16_t CcsdsMaxApid = 0x7FFU;
+
+    static constexpr uint16_t CcsdsSequenceCountMask = 0x3FFFU;
+
+    /**
+     * @brief Sizes of the packets.
+     */
+    struct PacketFormat {
+        uint16_t headerBytes = CcsdsPrimaryHeaderBytes;   /*!< Bytes before the payload */
+        uint16_t payloadBytes = 1018U;                     /*!< Page bytes per packet, only the last one may carry less */
+        uint16_t apid = 0U;                                /*!< APID of the default CCSDS header */
+        bool includeParity = true;                         /*!< Send the BCH parity of each page after its data */
+    };
+
+    /**
+     * @brief Type alias for the delegate writing the header of a packet.
+     *
+     * @details Called once the payload of the packet is complete.
+     *
+     * @param sequenceCount Packets sent before this one since construction or resetSequenceCount()
+     * @param payloadLength Payload bytes of this packet
+     * @param header headerBytes bytes to fill
+     */
+    using HeaderWriter = etl::delegate<void(uint32_t sequenceCount, uint16_t payloadLength, etl::span<uint8_t> header)>;
+
+    /**
+     * @brief Type alias for the delegate handing a packet to the transport.
+     *
+     * @details The packet is header and payload, contiguous. Return false to stop the stream.
+     */
+    using PacketSink = etl::delegate<bool(etl::span<const uint8_t> packet)>;
+
+    struct Statistics {
+        uint32_t packets = 0U;
+        uint32_t pages = 0U;
+        uint64_t payloadBytes = 0U;
+    };
+
+    /**
+     * @param nand Driver to read from (must outlive the streamer)
+     * @param packetRing Storage for the packet slots of headerBytes + payloadBytes each, at least two
+     * @param format Packet sizes
+     * @param headerWriter Optional, the default writes a CCSDS primary header
+     */
+    NANDDownlinkStreamer(MT29F& nand, etl::span<uint8_t> packetRing, const PacketFormat& format,
+                         HeaderWriter headerWriter = HeaderWriter{})
+        : nand{nand}
+        , packetRing{packetRing}
+        , format{format}
+        , headerWriter{headerWriter} {}
+
+    NANDDownlinkStreamer(const NANDDownlinkStreamer&) = delete;
+    NANDDownlinkStreamer& operator=(const NANDDownlinkStreamer&) = delete;
+    NANDDownlinkStreamer(NANDDownlinkStreamer&&) = delete;
+    NANDDownlinkStreamer& operator=(NANDDownlinkStreamer&&) = delete;
+
+    ~NANDDownlinkStreamer() = default;
+
+    /**
+     * @brief Packetize byteCount bytes of page data starting at a page.
+     *
+     * @details The pages continue into the following blocks, as in readPagesSequential(). The last
+     *          packet carries the remainder of byteCount (rounded up to a whole sector with includeParity).
+     *
+     * @param startAddress First page (column must be 0)
+     * @param byteCount Data bytes to send, parity not included
+     * @param sink Transport
+     *
+     * @return Number of packets passed to the sink, or specific error code
+     * @retval NANDErrorCode::INVALID_PARAMETER Invalid format, fewer than two slots or no sink
+     *
+     * @see MT29F::readPagesSequential() for the device errors
+     */
+    [[nodiscard]] etl::expected<uint32_t, NANDErrorCode> stream(const MT29F::NANDAddress& startAddress,
+                                                                uint64_t byteCount, PacketSink sink);
+
+    [[nodiscard]] uint16_t getPacketBytes() const {
+        return format.headerBytes + format.payloadBytes;
+    }
+
+    void resetSequenceCount() {
+        sequenceCount = 0U;
+    }
+
+    [[nodiscard]] const Statistics& getStatistics() const {
+        return statistics;
+    }
+
+    /**
+     * @brief Write a CCSDS space packet primary header.
+     *
+     * @param dataFieldBytes Bytes after the primary header (1 to 65536)
+     * @param[out] header At least CcsdsPrimaryHeaderBytes bytes
+     */
+    static void writeCcsdsPrimaryHeader(uint16_t apid, uint32_t sequenceCount, uint32_t dataFieldBytes,
+                                        etl::span<uint8_t> header);
+
+private:
+    MT29F& nand;
+
+    etl::span<uint8_t> packetRing;
+
+    const PacketFormat format;
+
+    HeaderWriter headerWriter;
+
+    uint32_t sequenceCount = 0U;
+
+    Statistics statistics;
+
+    [[nodiscard]] bool isFormatValid() const;
+};
@@ -0,0 +1,610 @@
+#pragma once
+
+#include "NANDFlash.hpp"
+#include "NANDFTLJournal.hpp"
+#include "FreeBlockPool.hpp"
+#include <etl/array.h>
+#include <etl/bitset.h>
+#include <etl/expected.h>
+#include <etl/span.h>
+
+/**
+ * @brief Page-mapped flash translation layer exposing an MT29F as a block device of 8 KiB logical sectors.
+ *
+ * @details Writes are out of place: every sector write programs the next page of the open host block
+ *          with programPageEcc() and the logical to physical (L2P) table is updated in RAM. The page
+ *          metadata carries the reverse mapping, so the table can be rebuilt from the device:
+ *
+ *            0 - 3    logical sector (little endian)
+ *            4 - 7    write sequence number (little endian)
+ *            8 - 11   erase count of the block (little endian, only authoritative in page 0)
+ *
+ *          A newer write of a sector always has a higher sequence number. Relocated pages keep their
+ *          metadata, so on mount the copy with the highest sequence number wins, and duplicates left by
+ *          an interrupted garbage collection carry identical data.
+ *
+ *          Garbage collection runs when the number of free blocks drops below GcThresholdBlocks. The
+ *          victim is the block with the fewest valid pages (GREEDY) or the best age * (1 - u) / 2u ratio
+ *          (COST_BENEFIT), where u is the valid page ratio and age the number of writes since the block
+ *          last received data. Valid pages move with copyback into a relocation block of the same plane,
+ *          or through RAM (ECC corrected) when the metadata codeword already needed many corrections or
+ *          no block of that plane is free. A valid page that cannot be read on the RAM path is dropped
+ *          (unmapped through the journal, counted in droppedPages), so the victim can still be released.
+ *
+ *          Free blocks are either erased or dirty (stale data, erased when allocated). Without background
+ *          maintenance a victim is erased as soon as it is collected: a relocated page keeps its sequence
+ *          number, so a stale copy left behind could be mapped again by the next mount and keep the victim
+ *          from being freed. Blocks found free at mount are dirty.
+ *
+ *          Background maintenance (enableBackgroundMaintenance()): victims are left dirty, and a low
+ *          priority task calling runBackgroundStep() keeps the number of erased blocks between two
+ *          watermarks (erasing an even/odd pair with one multi-plane erase when it can) and collects
+ *          garbage a few pages at a time while free blocks run low, so that write() seldom erases or
+ *          collects itself. Background collection skips victims holding more than BackgroundMaxValidPages
+ *          valid pages, so that watermarks above the over-provisioning cannot make it copy full blocks
+ *          around forever. Keeping erasedLow at least GcThresholdBlocks also bounds the stale copies a
+ *          reset can leave behind.
+ *
+ *          Scrubbing (enableScrubbing()): a task calling runScrubStep() at a fixed period walks the pages
+ *          holding data with readPageEcc(), a few per call. A block whose pages need at least
+ *          refreshCorrectedBits corrections in one codeword, are uncorrectable or need a read retry option
+ *          is refreshed: its valid pages are moved through RAM (ECC corrected, never with copyback, which
+ *          would carry the errors along) and it is released to be erased. The sectors of pages that cannot
+ *          be corrected are unmapped by the refresh (droppedPages), so a refresh always completes and the
+ *          rest of the block is saved. Host reads are counted per block, and a block read readDisturbLimit
+ *          times is refreshed as well; as its cells are not damaged, its pages may move with copyback.
+ *          Read counts live in RAM only and restart from 0 at mount.
+ *
+ *          Wear leveling: free blocks are kept in a FreeBlockPool and the least worn one is allocated
+ *          (dynamic). Every StaticWearCheckInterval erases, if the erase count of the least worn block
+ *          holding data lags the most worn block by more than StaticWearThreshold, that block is collected
+ *          like a victim (static), so that its cold data stops pinning a young block. Page 0 of a block is
+ *          always programmed through RAM, so that its metadata carries the current erase count; copyback
+ *          is only used for the other pages.
+ *
+ *          Blocks reported by MT29F::isBlockBad() are never used. A block whose program fails is closed,
+ *          collected first and then marked bad with MT29F::markBadBlock(); a block that fails to erase is
+ *          marked bad directly.
+ *
+ *          With a NANDFTLJournal attached, every L2P change is also appended to an MRAM journal and mount()
+ *          replays it instead of scanning the NAND. The scan remains the fallback when the MRAM holds no
+ *          valid checkpoint.
+ *
+ * @note Write amplification = (hostPageWrites + copybackMoves + hostMoves) / hostPageWrites.
+ *
+ * @note The L2P table is caller provided (one uint32_t per logical sector). The sector count must not
+ *       exceed (good blocks - OverprovisionBlocks) * PagesPerBlock; more spare space lowers write
+ *       amplification. The remaining state takes about 104 KiB of RAM.
+ *
+ * @note Thread Safety: Requires external synchronization, like MT29F. The FTL must be the only
+ *       writer of the usable blocks of the device.
+ */
+class NANDFTL {
+public:
+    static constexpr uint32_t SectorBytes = MT29F::DataBytesPerPage;
+
+    static constexpr uint32_t UnmappedPage = 0xFFFFFFFFU;      /*!< L2P entry of a sector never written */
+
+    static constexpr uint16_t OverprovisionBlocks = 8U;         /*!< Good blocks kept out of the logical capacity */
+
+    static constexpr uint16_t GcThresholdBlocks = 4U;           /*!< Collect garbage before a host block allocation below this many free blocks */
+
+    static constexpr uint32_t StaticWearThreshold = 64U;        /*!< Erase count spread above which a cold block is migrated */
+
+    static constexpr uint16_t StaticWearCheckInterval = 128U;   /*!< Erases between two static wear leveling checks */
+
+    static constexpr uint8_t BackgroundStepPages = 8U;          /*!< Victim pages examined per background collection step */
+
+    static constexpr uint8_t BackgroundMaxValidPages = MT29F::PagesPerBlock / 2U;   /*!< Fuller victims are left to write() */
+
+    /**
+     * @brief Garbage collection victim selection policy.
+     */
+    enum class GcPolicy : uint8_t {
+        GREEDY,          /*!< Fewest valid pages */
+        COST_BENEFIT,    /*!< Highest age * (1 - u) / 2u, avoids moving hot data that is about to be invalidated */
+    };
+
+    /**
+     * @brief Counters accumulated since mount() or format().
+     */
+    struct Statistics {
+        uint64_t hostPageWrites = 0U;      /*!< Sectors written by the host */
+        uint64_t copybackMoves = 0U;       /*!< Pages relocated with copyback */
+        uint64_t hostMoves = 0U;           /*!< Pages relocated through RAM */
+        uint32_t blockErases = 0U;
+        uint32_t garbageCollections = 0U;  /*!< Victim blocks collected */
+        uint32_t retiredBlocks = 0U;       /*!< Blocks marked bad after a program or erase failure */
+        uint32_t checkpoints = 0U;         /*!< Journal checkpoints written */
+        uint32_t wearLevelingMigrations = 0U;   /*!< Cold blocks collected by static wear leveling */
+        uint32_t droppedPages = 0U;        /*!< Valid pages unmapped by a relocation because they could not be read */
+        uint32_t foregroundErases = 0U;    /*!< Erases a write or relocation had to wait for */
+        uint32_t foregroundCollections = 0U;   /*!< Victims collected inside write() */
+        uint64_t foregroundEraseUs = 0U;   /*!< Time spent in foreground erases */
+        uint64_t foregroundCollectionUs = 0U;  /*!< Time write() spent collecting garbage */
+        uint32_t maxForegroundStallUs = 0U;    /*!< Longest single foreground erase or collection */
+        uint32_t backgroundErases = 0U;    /*!< Blocks erased by runBackgroundStep() */
+        uint32_t multiPlaneErases = 0U;    /*!< Pairs of them erased with one multi-plane erase */
+        uint32_t backgroundCollectionSteps = 0U;   /*!< Garbage collection steps run by runBackgroundStep() */
+        uint64_t scrubbedPages = 0U;       /*!< Pages checked by runScrubStep() */
+        uint32_t scrubPasses = 0U;         /*!< Complete walks over the usable blocks */
+        uint32_t scrubRefreshes = 0U;      /*!< Blocks refreshed because of their bit errors */
+        uint32_t scrubUncorrectablePages = 0U;     /*!< Pages runScrubStep() found uncorrectable */
+        uint32_t readDisturbRefreshes = 0U;    /*!< Blocks refreshed because of their read count */
+    };
+
+    /**
+     * @brief Scrubbing thresholds and rate.
+     */
+    struct ScrubSettings {
+        uint8_t pagesPerStep = 4U;              /*!< Pages read or relocated per runScrubStep(), bounds its bandwidth */
+        uint8_t refreshCorrectedBits = 12U;     /*!< Corrections in one codeword that trigger a refresh (BCH corrects 24) */
+        uint16_t readDisturbLimit = 50000U;     /*!< Host reads of a block that trigger a refresh (counts saturate at 65535) */
+    };
+
+    /**
+     * @brief Watermarks of the background maintenance, with hysteresis: work starts below the low
+     *        watermark and stops at the high one.
+     */
+    struct BackgroundWatermarks {
+        uint16_t erasedLow = 8U;    /*!< Start pre-erasing below this many erased blocks */
+        uint16_t erasedHigh = 16U;  /*!< Stop pre-erasing at this many erased blocks */
+        uint16_t freeLow = 16U;     /*!< Start collecting garbage below this many free blocks */
+        uint16_t freeHigh = 24U;    /*!< Stop collecting garbage at this many free blocks */
+    };
+
+    /**
+     * @param nand Initialized NAND driver (must outlive the FTL)
+     * @param mappingTable L2P table storage, one entry per logical sector
+     * @param policy Garbage collection victim selection policy
+     */
+    NANDFTL(MT29F& nand, etl::span<uint32_t> mappingTable, GcPolicy policy = GcPolicy::COST_BENEFIT)
+        : nand{nand}
+        , mapping{mappingTable}
+        , policy{policy} {}
+
+    NANDFTL(const NANDFTL&) = delete;
+    NANDFTL& operator=(const NANDFTL&) = delete;
+    NANDFTL(NANDFTL&&) = delete;
+    NANDFTL& operator=(NANDFTL&&) = delete;
+
+    ~NANDFTL() = default;
+
+    /**
+     * @brief Journal the L2P table in MRAM, so that mount() does not scan the NAND.
+     *
+     * @details Must be attached before format() or mount(), and then on every later mount: changes made
+     *          without the journal are not in its checkpoint.
+     *
+     * @param mappingJournal Journal (must outlive the FTL), nullptr to rebuild the table from the NAND
+     */
+    void attachJournal(NANDFTLJournal* mappingJournal) {
+        journal = mappingJournal;
+    }
+
+    /**
+     * @brief Erase every good usable block and start with all sectors unmapped.
+     *
+     * @details The erase count of each block is carried over from its page 0 when it holds FTL data.
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::ALREADY_INITIALIZED FTL already mounted
+     * @retval NANDErrorCode::INVALID_PARAMETER Mapping table empty, larger than the device capacity or
+     *         than the journal region
+     * @retval NANDErrorCode::NOT_INITIALIZED NAND driver not initialized
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> format();
+
+    /**
+     * @brief Rebuild the L2P table from the journal or from the page metadata of every good usable block.
+     *
+     * @details With a journal, loads its checkpoint and replays the records appended since. Otherwise, or
+     *          when the journal is not valid, reads only the metadata codeword of each programmed page
+     *          (readPageMetadataEcc()), stops at the first erased page of a block and then writes a new
+     *          checkpoint. Partially programmed blocks are closed. Erase counts come from the journal or
+     *          from page 0 of each block; erased blocks get the mean of the known counts.
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::ALREADY_INITIALIZED FTL already mounted
+     * @retval NANDErrorCode::INVALID_PARAMETER Mapping table empty or larger than the device capacity
+     * @retval NANDErrorCode::NOT_INITIALIZED NAND driver not initialized
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> mount();
+
+    /**
+     * @brief Read a logical sector. Sectors never written read as 0xFF.
+     *
+     * @param sector Logical sector
+     * @param[out] data Sector data, exactly SectorBytes bytes
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED FTL not mounted
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Sector beyond the mapping table
+     * @retval NANDErrorCode::INVALID_PARAMETER Wrong data size
+     * @retval NANDErrorCode::ECC_UNCORRECTABLE Page could not be corrected
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> read(uint32_t sector, etl::span<uint8_t> data);
+
+    /**
+     * @brief Write a logical sector out of place, collecting garbage first if free blocks run low.
+     *
+     * @param sector Logical sector
+     * @param data Sector data, exactly SectorBytes bytes
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED FTL not mounted
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Sector beyond the mapping table
+     * @retval NANDErrorCode::INVALID_PARAMETER Wrong data size
+     * @retval NANDErrorCode::NO_SPACE No block could be reclaimed
+     * @retval NANDErrorCode::PROGRAM_FAILED Programming failed on MaxProgramAttempts blocks in a row
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED Data written but the journal record could not be stored
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> write(uint32_t sector, etl::span<const uint8_t> data);
+
+    /**
+     * @brief Fold the journal into its checkpoint now (it is otherwise done when the journal fills up),
+     *        e.g. from a periodic task or before a planned reset, to shorten the next mount.
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED FTL not mounted or no journal attached
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> checkpoint();
+
+    /**
+     * @brief Largest mapping table size the device supports (good usable blocks minus overprovisioning).
+     *
+     * @pre NAND driver must be initialized
+     */
+    [[nodiscard]] uint32_t getMaxSectorCount() const;
+
+    [[nodiscard]] uint32_t getSectorCount() const {
+        return mapping.size();
+    }
+
+    [[nodiscard]] bool isMounted() const {
+        return mounted;
+    }
+
+    /**
+     * @brief Defer the erase of collected victims to runBackgroundStep().
+     *
+     * @param watermarks Erased and free block watermarks (low must not exceed high)
+     */
+    void enableBackgroundMaintenance(const BackgroundWatermarks& watermarks) {
+        backgroundWatermarks = watermarks;
+        isBackgroundEnabled = true;
+    }
+
+    /**
+     * @brief Run one bounded unit of background work: one block erase (or a multi-plane pair), or one
+     *        garbage collection step of BackgroundStepPages pages.
+     *
+     * @details Meant for a low priority task that takes the FTL mutex for each call and yields between
+     *          calls while there is work.
+     *
+     * @return true if work was done and more may remain, false when idle, or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED FTL not mounted or background maintenance not enabled
+     */
+    [[nodiscard]] etl::expected<bool, NANDErrorCode> runBackgroundStep();
+
+    /**
+     * @brief Check the stored data in the background and refresh degrading blocks.
+     *
+     * @param settings Thresholds and pages per step (pagesPerStep must not be 0)
+     */
+    void enableScrubbing(const ScrubSettings& settings) {
+        scrubSettings = settings;
+        isScrubEnabled = true;
+    }
+
+    /**
+     * @brief Run one bounded scrub step: read the next pagesPerStep pages holding data, or move up to
+     *        pagesPerStep pages of the block being refreshed.
+     *
+     * @details Meant for a low priority task calling it at a fixed period with the FTL mutex held: the
+     *          scrub bandwidth is then at most pagesPerStep pages per period, whatever the amount of data.
+     *          A garbage collection already in progress is advanced first, as the refresh reuses it.
+     *
+     * @return true if work was done, false when no block holds data, or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED FTL not mounted or scrubbing not enabled
+     */
+    [[nodiscard]] etl::expected<bool, NANDErrorCode> runScrubStep();
+
+    /**
+     * @brief Host reads of a usable block since its last erase (or since mount).
+     */
+    [[nodiscard]] uint16_t getReadCount(uint16_t block) const {
+        return (block < BlockCount) ? readCounts[block] : 0U;
+    }
+
+    [[nodiscard]] uint16_t getFreeBlockCount() const {
+        return erasedPool.size() + dirtyPool.size();
+    }
+
+    [[nodiscard]] uint16_t getErasedBlockCount() const {
+        return erasedPool.size();
+    }
+
+    /**
+     * @brief Erase count of a usable block, as known to the FTL (see mount()).
+     */
+    [[nodiscard]] uint32_t getEraseCount(uint16_t block) const {
+        return (block < BlockCount) ? eraseCounts[block] : 0U;
+    }
+
+    [[nodiscard]] const Statistics& getStatistics() const {
+        return statistics;
+    }
+
+private:
+    static constexpr uint16_t BlockCount = MT29F::UsableBlocksPerLun;   /*!< Blocks managed by the FTL (reserved blocks excluded) */
+
+    static constexpr uint8_t PagesPerBlock = MT29F::PagesPerBlock;
+
+    static constexpr uint8_t PlaneCount = 2U;
+
+    static constexpr uint16_t NoBlock = FreeBlockPool::NoBlock;
+
+    static constexpr uint8_t TagBytes = 12U;
+
+    static constexpr uint8_t MaxProgramAttempts = 3U;
+
+    static constexpr uint8_t CopybackMaxCorrectedBits = 8U;   /*!< Metadata corrections above which a page is moved through RAM */
+
+    using Tag = etl::array<uint8_t, TagBytes>;
+
+    /**
+     * @brief What a newly allocated block will hold, which decides how it is picked.
+     */
+    enum class BlockUse : uint8_t {
+        HOST_DATA,        /*!< Least worn block, collect garbage and level wear first if needed */
+        RELOCATED_DATA,   /*!< Least worn block, for garbage collection */
+        COLD_DATA,        /*!< Most worn block, for static wear leveling */
+    };
+
+    /**
+     * @brief Decoded page metadata.
+     */
+    struct TagFields {
+        uint32_t sector;
+        uint32_t sequence;
+        uint32_t eraseCount;
+    };
+
+    MT29F& nand;
+
+    const etl::span<uint32_t> mapping;
+
+    const GcPolicy policy;
+
+    NANDFTLJournal* journal = nullptr;
+
+    bool mounted = false;
+
+    uint32_t sequence = 0U;   /*!< Sequence number of the latest host write */
+
+    etl::array<uint8_t, BlockCount> validPages{};
+
+    etl::array<uint8_t, BlockCount> writtenPages{};    /*!< Next page to program (pages are programmed in order) */
+
+    etl::array<uint32_t, BlockCount> blockMinSequence{};
+
+    etl::array<uint32_t, BlockCount> blockMaxSequence{};   /*!< Youngest data in the block, the age reference of COST_BENEFIT */
+
+    etl::array<uint32_t, BlockCount> eraseCounts{};
+
+    FreeBlockPool erasedPool{eraseCounts};   /*!< Free blocks ready to be programmed */
+
+    FreeBlockPool dirtyPool{eraseCounts};    /*!< Free blocks holding stale data */
+
+    etl::bitset<BlockCount> retiringBlocks;  /*!< Program failed: collect first, then mark bad */
+
+    uint16_t erasesSinceWearCheck = 0U;
+
+    uint8_t lastAllocatedPlane = 0U;   /*!< Ties between planes alternate */
+
+    bool isMigratingColdData = false;   /*!< Static wear leveling in progress: relocate into worn blocks */
+
+    uint16_t collectingBlock = NoBlock;   /*!< Victim whose collection is in progress */
+
+    uint8_t collectionPage = 0U;          /*!< Next page of collectingBlock to examine */
+
+    bool isBackgroundEnabled = false;
+
+    BackgroundWatermarks backgroundWatermarks;
+
+    bool isPreErasing = false;
+
+    bool isCollectingInBackground = false;
+
+    bool isScrubEnabled = false;
+
+    ScrubSettings scrubSettings;
+
+    uint16_t scrubBlock = 0U;             /*!< Next block to check */
+
+    uint8_t scrubPage = 0U;               /*!< Next page of scrubBlock to check */
+
+    uint16_t refreshBlock = NoBlock;      /*!< Block the scrubber is refreshing */
+
+    uint16_t correctingBlock = NoBlock;   /*!< Block whose pages must move through ECC, not copyback */
+
+    etl::array<uint16_t, BlockCount> readCounts{};   /*!< Host reads since the last erase, saturating */
+
+    uint16_t hostBlock = NoBlock;
+
+    etl::array<uint16_t, PlaneCount> relocationBlocks{};
+
+    Statistics statistics;
+
+    alignas(32) etl::array<uint8_t, SectorBytes> pageBuffer{};   /*!< Relocations through RAM (cache line aligned for DMA) */
+
+    static MT29F::NANDAddress toAddress(uint32_t physicalPage) {
+        return MT29F::NANDAddress { 0U, physicalPage / PagesPerBlock, physicalPage % PagesPerBlock, 0U };
+    }
+
+    static Tag encodeTag(const TagFields& fields);
+
+    static TagFields decodeTag(const Tag& tag);
+
+    /**
+     * @brief Clear the RAM state and check the mapping table size against the device.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> prepare();
+
+    /**
+     * @brief Mount step: read the metadata of the programmed pages of a block and map the newest copies.
+     *
+     * @param[out] isEraseCountKnown Whether page 0 held an erase count
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> scanBlock(uint16_t block, bool& isEraseCountKnown);
+
+    /**
+     * @brief Give the blocks whose erase count is unknown the mean of the known counts.
+     */
+    void estimateEraseCounts(const etl::bitset<BlockCount>& knownEraseCounts);
+
+    /**
+     * @brief Mount step: whether a copy of a sector is newer than the one currently mapped.
+     */
+    [[nodiscard]] bool isNewerCopy(uint32_t sector, uint32_t tagSequence);
+
+    void setMapping(uint32_t sector, uint32_t physicalPage, uint32_t tagSequence);
+
+    /**
+     * @brief Update the L2P table and append the change to the journal, checkpointing it first when full.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> recordMapping(uint32_t sector, uint32_t physicalPage,
+                                                                   uint32_t tagSequence);
+
+    /**
+     * @brief Append a record to the journal, if one is attached, checkpointing it first when full.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> appendJournal(const NANDFTLJournal::Record& record);
+
+    /**
+     * @brief Mount step: load the journal and derive the block state from the L2P table.
+     *
+     * @retval NANDErrorCode::JOURNAL_INVALID No usable checkpoint (also when it maps pages outside the usable blocks)
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> loadJournal();
+
+    /**
+     * @brief Take a free block (erasing it if needed), in the given plane if one is requested.
+     *
+     * @param plane Plane (0 or 1), or PlaneCount for any plane
+     * @param use Data the block will hold
+     */
+    [[nodiscard]] etl::expected<uint16_t, NANDErrorCode> allocateBlock(uint8_t plane, BlockUse use);
+
+    /**
+     * @brief Pick a free block from one pool.
+     *
+     * @return NoBlock if the pool has none in the requested plane
+     */
+    [[nodiscard]] uint16_t pickBlock(const FreeBlockPool& pool, uint8_t plane, BlockUse use) const;
+
+    /**
+     * @brief Erase a block taken out of the free pools and count the erase.
+     *
+     * @return true if erased, false if the erase failed and the block was retired, or specific error code
+     */
+    [[nodiscard]] etl::expected<bool, NANDErrorCode> eraseFreeBlock(uint16_t block);
+
+    /**
+     * @brief Background step: erase the least worn dirty block of each plane, together if both exist.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> preEraseBlocks();
+
+    /**
+     * @brief Count an erase and journal it.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> recordErase(uint16_t block);
+
+    /**
+     * @brief Add the time since startCycles to a foreground stall counter and to the longest stall.
+     */
+    void recordStall(uint64_t& totalUs, uint32_t startCycles);
+
+    /**
+     * @brief Static wear leveling check: collect the least worn block holding data into the most worn free
+     *        blocks if it lags too far behind. Checks again at the next allocation after a migration.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> levelWear();
+
+    /**
+     * @brief Collect the victim selected by the GC policy.
+     *
+     * @retval NANDErrorCode::NO_SPACE No block with invalid pages
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> collectGarbage();
+
+    /**
+     * @brief Relocate the valid pages of a block and release it (finishing any collection in progress first).
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> collectBlock(uint16_t victim);
+
+    /**
+     * @brief Examine up to maxPages more pages of collectingBlock, and release it once all are examined.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> continueCollection(uint8_t maxPages);
+
+    [[nodiscard]] uint16_t selectVictim() const;
+
+    /**
+     * @brief Move a valid page into a relocation block, keeping its metadata.
+     *
+     * @details A page whose data cannot be corrected is unmapped (its sector then reads as erased)
+     *          instead of failing, so the collection of its block can still complete.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> relocatePage(uint32_t physicalPage, uint32_t sector,
+                                                                 uint32_t tagSequence, uint8_t correctedBits);
+
+    /**
+     * @brief Return a collected victim to the free pools (erasing it now without background maintenance),
+     *        or mark it bad if it is retiring.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> releaseBlock(uint16_t block);
+
+    /**
+     * @brief Close a block after a program failure, so that it is collected and marked bad.
+     */
+    void retireBlock(uint16_t block);
+
+    /**
+     * @brief Stop programming into a host or relocation block.
+     */
+    void closeBlock(uint16_t block);
+
+    /**
+     * @brief Scrub step: check the next pages holding data and pick a block to refresh.
+     *
+     * @return Number of pages read
+     */
+    [[nodiscard]] etl::expected<uint8_t, NANDErrorCode> checkScrubPages();
+
+    /**
+     * @brief Schedule the collection of a block by the scrubber.
+     *
+     * @param isCorrecting Move its pages through ECC (bit errors found)
+     */
+    void startRefresh(uint16_t block, bool isCorrecting);
+
+    [[nodiscard]] bool holdsData(uint16_t block) const {
+        return (not isFreeBlock(block)) and (writtenPages[block] > 0U) and (validPages[block] > 0U)
+               and (not nand.isBlockBad(block).value_or(true));
+    }
+
+    [[nodiscard]] bool isFreeBlock(uint16_t block) const {
+        return erasedPool.contains(block) or dirtyPool.contains(block);
+    }
+
+    [[nodiscard]] bool isOpenBlock(uint16_t block) const {
+        return (block == hostBlock) or (block == relocationBlocks[0]) or (block == relocationBlocks[1]);
+    }
+};
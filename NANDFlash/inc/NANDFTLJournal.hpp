@@ -0,0 +1,247 @@
+#pragma once
+
+#include "NANDFlash.hpp"
+#include "MR4A08BUYS45.hpp"
+#include <etl/array.h>
+#include <etl/expected.h>
+#include <etl/span.h>
+
+/**
+ * @brief MRAM journal of the NANDFTL logical to physical (L2P) table, so that mount replays MRAM instead of
+ *        scanning the metadata of every NAND page.
+ *
+ * @details The journal owns a region of the MRAM laid out as:
+ *
+ *            0                        checkpoint header, slot 0
+ *            HeaderSlotBytes          checkpoint header, slot 1
+ *            2 * HeaderSlotBytes      block table: youngest write sequence of each block (uint32_t)
+ *            + BlockCount * 4         erase count table: erase count of each block (uint32_t)
+ *            + BlockCount * 4         L2P image: physical page of each sector (uint32_t)
+ *            + sectors * 4            journal: journalCapacity records of RecordBytes
+ *
+ *          Every L2P change is appended as a record {sector, physical page, write sequence}, and every
+ *          block erase as {EraseRecordSector, block, erase count}. When the journal is full, checkpoint()
+ *          writes the image entries of the journaled sectors and both block tables, then commits a
+ *          header with the next generation into the older header slot. Records carry the low half of the
+ *          generation and a CRC, so that the records left by an older generation or torn by a reset end
+ *          the replay without clearing the journal.
+ *
+ *          An interrupted checkpoint is harmless: the image entries it may have overwritten are those of
+ *          the journaled sectors, and the replay of the previous generation writes them all again.
+ *
+ *          Mount reads the image (4 bytes per sector) and replays at most journalCapacity records, so its
+ *          duration depends on the table size and journal length, not on the NAND size.
+ *
+ * @note All values are little endian. One MRAM region must hold one journal; it is only valid for the
+ *       sector count and journal capacity it was created with.
+ */
+class NANDFTLJournal {
+public:
+    static constexpr uint32_t DefaultJournalCapacity = 4096U;   /*!< Records between checkpoints (64 KiB of MRAM) */
+
+    static constexpr uint8_t RecordBytes = 16U;
+
+    static constexpr uint8_t HeaderSlotBytes = 32U;
+
+    static constexpr uint16_t BlockCount = MT29F::UsableBlocksPerLun;
+
+    static constexpr uint32_t EraseRecordSector = 0xFFFFFFFFU;   /*!< Sector of the records of block erases */
+
+    /**
+     * @brief One L2P change or block erase.
+     */
+    struct Record {
+        uint32_t sector;         /*!< EraseRecordSector for a block erase */
+        uint32_t physicalPage;   /*!< NANDFTL::UnmappedPage when a sector is dropped, the block for an erase */
+        uint32_t sequence;       /*!< Write sequence of the page data, the new erase count for an erase */
+    };
+
+    /**
+     * @param mram MRAM driver (must outlive the journal)
+     * @param baseAddress First MRAM address of the journal region
+     * @param regionBytes Size of the journal region
+     * @param journalCapacity Records appended between checkpoints (bounds the replay at mount)
+     */
+    NANDFTLJournal(MRAM& mram, uint32_t baseAddress, uint32_t regionBytes,
+                   uint32_t journalCapacity = DefaultJournalCapacity)
+        : mram{mram}
+        , baseAddress{baseAddress}
+        , regionBytes{regionBytes}
+        , journalCapacity{journalCapacity} {}
+
+    NANDFTLJournal(const NANDFTLJournal&) = delete;
+    NANDFTLJournal& operator=(const NANDFTLJournal&) = delete;
+    NANDFTLJournal(NANDFTLJournal&&) = delete;
+    NANDFTLJournal& operator=(NANDFTLJournal&&) = delete;
+
+    ~NANDFTLJournal() = default;
+
+    /**
+     * @brief Write a complete checkpoint (image of every sector) and start an empty journal.
+     *
+     * @param mapping L2P table
+     * @param blockSequences Youngest write sequence of each block, BlockCount entries
+     * @param eraseCounts Erase count of each block, BlockCount entries
+     * @param sequence Latest write sequence
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::INVALID_PARAMETER Table sizes do not fit the region
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> create(etl::span<const uint32_t> mapping,
+                                                            etl::span<const uint32_t> blockSequences,
+                                                            etl::span<const uint32_t> eraseCounts, uint32_t sequence);
+
+    /**
+     * @brief Load the latest checkpoint and replay the journal on top of it.
+     *
+     * @param[out] mapping L2P table
+     * @param[out] blockSequences Youngest write sequence of each block, BlockCount entries
+     * @param[out] eraseCounts Erase count of each block, BlockCount entries
+     *
+     * @return Latest write sequence found or specific error code
+     * @retval NANDErrorCode::INVALID_PARAMETER Table sizes do not fit the region
+     * @retval NANDErrorCode::JOURNAL_INVALID No valid header, or one for another sector count or capacity
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access failed
+     */
+    [[nodiscard]] etl::expected<uint32_t, NANDErrorCode> load(etl::span<uint32_t> mapping,
+                                                              etl::span<uint32_t> blockSequences,
+                                                              etl::span<uint32_t> eraseCounts);
+
+    /**
+     * @brief Append one L2P change or block erase.
+     *
+     * @pre create() or load() succeeded and the journal is not full
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED No checkpoint created or loaded
+     * @retval NANDErrorCode::NO_SPACE Journal full, checkpoint() first
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> append(const Record& record);
+
+    /**
+     * @brief Fold the journal into the image and start an empty journal.
+     *
+     * @details Writes the image entry of every journaled sector (re-reading the sectors from the
+     *          journal), both block tables and the next header. Costs about journal length * 20 +
+     *          BlockCount * 8 bytes of MRAM traffic.
+     *
+     * @param mapping L2P table, including every journaled change
+     * @param blockSequences Youngest write sequence of each block, BlockCount entries
+     * @param eraseCounts Erase count of each block, BlockCount entries
+     * @param sequence Latest write sequence
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED No checkpoint created or loaded
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> checkpoint(etl::span<const uint32_t> mapping,
+                                                                etl::span<const uint32_t> blockSequences,
+                                                                etl::span<const uint32_t> eraseCounts,
+                                                                uint32_t sequence);
+
+    [[nodiscard]] bool isFull() const {
+        return journalLength >= journalCapacity;
+    }
+
+    [[nodiscard]] uint32_t getJournalLength() const {
+        return journalLength;
+    }
+
+    [[nodiscard]] uint32_t getJournalCapacity() const {
+        return journalCapacity;
+    }
+
+    /**
+     * @brief MRAM bytes needed for a table of sectorCount sectors.
+     */
+    [[nodiscard]] static constexpr uint32_t getRequiredBytes(uint32_t sectorCount, uint32_t journalCapacity) {
+        return (2U * HeaderSlotBytes) + (2U * BlockCount * sizeof(uint32_t)) + (sectorCount * sizeof(uint32_t)) +
+               (journalCapacity * RecordBytes);
+    }
+
+private:
+    static constexpr etl::array<uint8_t, 4> HeaderMagic = { 'F', 'T', 'L', 'J' };
+
+    static constexpr size_t HeaderSectorCountOffset = 4U;
+
+    static constexpr size_t HeaderCapacityOffset = 8U;
+
+    static constexpr size_t HeaderGenerationOffset = 12U;
+
+    static constexpr size_t HeaderSequenceOffset = 16U;
+
+    static constexpr size_t HeaderCrcOffset = 20U;
+
+    static constexpr size_t RecordPageOffset = 4U;
+
+    static constexpr size_t RecordSequenceOffset = 8U;
+
+    static constexpr size_t RecordGenerationOffset = 12U;
+
+    static constexpr size_t RecordCrcOffset = 14U;
+
+    static constexpr uint32_t BlockTableOffset = 2U * HeaderSlotBytes;
+
+    static constexpr uint32_t EraseCountTableOffset = BlockTableOffset + (BlockCount * sizeof(uint32_t));
+
+    static constexpr uint32_t ImageOffset = EraseCountTableOffset + (BlockCount * sizeof(uint32_t));
+
+    static constexpr size_t TransferEntries = 64U;   /*!< uint32_t entries moved per MRAM access */
+
+    using HeaderSlot = etl::array<uint8_t, HeaderSlotBytes>;
+
+    using RecordBytesArray = etl::array<uint8_t, RecordBytes>;
+
+    MRAM& mram;
+
+    const uint32_t baseAddress;
+
+    const uint32_t regionBytes;
+
+    const uint32_t journalCapacity;
+
+    bool isLoaded = false;
+
+    uint32_t sectorCount = 0U;
+
+    uint32_t generation = 0U;
+
+    uint8_t headerSlot = 0U;    /*!< Slot holding the current header */
+
+    uint32_t journalLength = 0U;
+
+    [[nodiscard]] uint32_t getJournalOffset() const {
+        return ImageOffset + (sectorCount * sizeof(uint32_t));
+    }
+
+    [[nodiscard]] bool fitsRegion(size_t mappingSize, size_t blockSequencesSize, size_t eraseCountsSize) const;
+
+    /**
+     * @brief Write the header of the next generation into the other slot, which commits a checkpoint.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> commitHeader(uint32_t sequence);
+
+    /**
+     * @brief Parse a header slot.
+     *
+     * @return Generation of a valid header matching the geometry, or JOURNAL_INVALID
+     */
+    [[nodiscard]] etl::expected<uint32_t, NANDErrorCode> parseHeader(const HeaderSlot& slot, uint32_t& sequence) const;
+
+    [[nodiscard]] RecordBytesArray encodeRecord(const Record& record) const;
+
+    /**
+     * @return false if the record is torn or belongs to an older generation
+     */
+    [[nodiscard]] bool decodeRecord(const RecordBytesArray& bytes, Record& record) const;
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> writeWords(uint32_t offset, etl::span<const uint32_t> words);
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readWords(uint32_t offset, etl::span<uint32_t> words);
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> writeBytes(uint32_t offset, etl::span<const uint8_t> bytes);
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readBytes(uint32_t offset, etl::span<uint8_t> bytes);
+};
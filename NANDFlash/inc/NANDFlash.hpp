@@ -1,12 +1,20 @@
 #pragma once
 
 #include "SMC.hpp"
+#include "NANDBus.hpp"
+#include "MT29FGeometry.hpp"
+#include "NANDDma.hpp"
+#include "BCHCodec.hpp"
+#include "ONFITiming.hpp"
+#include "TaskNotification.hpp"
+#include "LatencyHistogram.hpp"
 #include "definitions.h"
 #include <etl/expected.h>
 #include <etl/span.h>
 #include <etl/array.h>
 #include <etl/bitset.h>
 #include <etl/delegate.h>
+#include <etl/optional.h>
 
 /**
  * @brief Error codes for NAND flash operations.
@@ -24,6 +32,13 @@ enum class NANDErrorCode : uint8_t {
     MULTIPLANE_FAILED,      /*!< Multi-plane operation failed (FAIL bit set in status) */
     PLANE_MISMATCH,         /*!< Blocks not in different planes (multi-plane erase requires one even + one odd block) */
     ALREADY_INITIALIZED,    /*!< Driver already initialized (initialize() called twice) */
+    DMA_FAILED,             /*!< DMA data phase failed or timed out (page register contents undefined) */
+    PAGE_NOT_OPEN,          /*!< No page open for column reads (openPage() not called or another command issued since) */
+    ECC_UNCORRECTABLE,      /*!< A codeword has more bit errors than the ECC can correct */
+    NO_SPACE,               /*!< No free block can be reclaimed for a write (NANDFTL) */
+    JOURNAL_INVALID,        /*!< No valid mapping checkpoint in MRAM, or one for another geometry (NANDFTLJournal) */
+    JOURNAL_IO_FAILED,      /*!< MRAM access failed (NANDFTLJournal, NANDLogStore index mirror) */
+    QUEUE_FULL,             /*!< No free request slot (NANDRequestQueue) */
 };
 
 /**
@@ -43,9 +58,12 @@ using YieldDelegate = etl::delegate<void(uint32_t)>;
  * @note Thread Safety:
  *       - Driver requires external synchronization.
  *       - Caller must hold external mutex during all operations.
+ *       - Alternatively, let a NANDRequestQueue own the driver and submit prioritized requests to it.
  *
  *       Bad Block Management:
  *       - Driver maintains bad block table (factory + runtime discovered).
+ *       - The table is persisted in the last ReservedBlocksPerLun blocks and loaded at initialization;
+ *         the factory marker scan only runs when no valid copy is found.
  *       - Query via isBlockBad() before operations.
  *       - Driver does NOT enforce checks on read/program/erase (caller responsibility).
  *       - Caller must mark the runtime bad blocks via markBadBlock().
@@ -58,12 +76,14 @@ using YieldDelegate = etl::delegate<void(uint32_t)>;
 class MT29F : public SMC {
 public:
     /* ============== MT29F64G08AFAAAWP device constants =============== */
-    static constexpr uint32_t DataBytesPerPage = 8192U;
-    static constexpr uint16_t SpareBytesPerPage = 448U;
-    static constexpr uint32_t TotalBytesPerPage = DataBytesPerPage + SpareBytesPerPage;
-    static constexpr uint8_t PagesPerBlock = 128U;
-    static constexpr uint16_t BlocksPerLun = 4096U;
-    static constexpr uint8_t LunsPerCe = 1U;
+    static constexpr uint32_t DataBytesPerPage = MT29FGeometry::DataBytesPerPage;
+    static constexpr uint16_t SpareBytesPerPage = MT29FGeometry::SpareBytesPerPage;
+    static constexpr uint32_t TotalBytesPerPage = MT29FGeometry::TotalBytesPerPage;
+    static constexpr uint8_t PagesPerBlock = MT29FGeometry::PagesPerBlock;
+    static constexpr uint16_t BlocksPerLun = MT29FGeometry::BlocksPerLun;
+    static constexpr uint8_t LunsPerCe = MT29FGeometry::LunsPerCe;
+    static constexpr uint8_t ReservedBlocksPerLun = 4U;    /*!< Last blocks of LUN 0, holding the persistent bad block table */
+    static constexpr uint16_t UsableBlocksPerLun = BlocksPerLun - ReservedBlocksPerLun;
 
     /**
      * @brief NAND address structure.
@@ -81,6 +101,22 @@ public:
             , column{column} {}
     };
 
+    /**
+     * @brief Column range of a page and the buffer it is read into, for readPageSegments().
+     */
+    struct ReadSegment {
+        uint16_t column;
+        etl::span<uint8_t> data;
+    };
+
+    /**
+     * @brief Column range of a page and the buffer it is programmed from, for programPageSegments().
+     */
+    struct ProgramSegment {
+        uint16_t column;
+        etl::span<const uint8_t> data;
+    };
+
     /**
      * @brief Constructor for MT29F NAND flash driver.
      *
@@ -91,12 +127,31 @@ public:
      */
     MT29F(ChipSelect chipSelect, PIO_PIN readyBusyPin, PIO_PIN writeProtectPin, YieldDelegate yieldMs)
         : SMC{chipSelect}
+        , nandChipSelect{chipSelect}
         , nandReadyBusyPin{readyBusyPin}
         , nandWriteProtectPin{writeProtectPin}
         , yieldMilliseconds{yieldMs} {
         enableNandFlashMode(chipSelect);
     }
 
+    /**
+     * @brief Constructor for MT29F NAND flash driver running on a custom bus backend.
+     *
+     * @details All command, address and data cycles as well as R/B# sampling are routed through
+     *          the backend instead of the SMC. The EBI is left untouched, so this constructor
+     *          can be used off-target (e.g. with the host-side MT29FSimulator).
+     *
+     * @param bus Bus backend (must outlive the driver)
+     * @param yieldMs Delegate for yielding to OS during long operations
+     */
+    MT29F(NANDBus& bus, YieldDelegate yieldMs)
+        : SMC{NCS0}
+        , nandChipSelect{NCS0}
+        , nandReadyBusyPin{PIO_PIN_NONE}
+        , nandWriteProtectPin{PIO_PIN_NONE}
+        , busBackend{&bus}
+        , yieldMilliseconds{yieldMs} {}
+
     MT29F(const MT29F&) = delete;
     MT29F& operator=(const MT29F&) = delete;
     MT29F(MT29F&&) = delete;
@@ -114,10 +169,12 @@ public:
      * @post If successful, driver is reset
      * @post Bad block table is populated with factory-marked bad blocks
      * @post Write protection is enabled if a WP# pin has been provided (WP# asserted)
+     * @post Device and SMC run in the fastest timing mode advertised by the parameter page
      *
      * @return Success (empty expected) or specific error code
      * @retval NANDErrorCode::ALREADY_INITIALIZED Driver already initialized
-     * @retval NANDErrorCode::TIMEOUT Device not responding
+     * @retval NANDErrorCode::TIMEOUT Device not responding, also while loading the bad block table
+     *                                 (the factory markers are only scanned when no table is found)
      *
      * @note Parameter page and device ID validations are non-fatal. If all three ONFI 
      *       parameter page copies or the ID fail validation (e.g. due to bit flips),
@@ -144,7 +201,8 @@ public:
      *          first command after power-on before any other operations.
      *
      * @pre Device must be powered on
-     * @post Device is in known initial state (async timing mode 0)
+     * @post Device is in known initial state. Once initialized, the timing mode selected by
+     *       initialize() is negotiated again; otherwise device and SMC stay in timing mode 0.
      *
      * @return Success (empty expected) or specific error code
      * @retval NANDErrorCode::TIMEOUT Device not responding within timeout period
@@ -161,6 +219,39 @@ public:
     [[nodiscard]] etl::expected<void, NANDErrorCode> reset();
 
 
+    /**
+     * @brief Wait for R/B# through a PIO edge interrupt instead of polling.
+     *
+     * @details While the device is busy, waitForReady() enables the R/B# pin interrupt and blocks the
+     *          calling task in waitNotification until the interrupt (or the timeout) wakes it, so
+     *          completions are seen immediately and no CPU time is spent polling during tR/tPROG/tBERS.
+     *          Without this mode (or without an R/B# pin) the polling path is used.
+     *
+     * @param waitNotification Delegate blocking the calling task until notified
+     * @param notifyFromIsr Delegate waking the task blocked in waitNotification (interrupt context)
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::INVALID_PARAMETER No R/B# pin configured, bus backend in use, or a delegate is missing
+     *
+     * @note The pin must be configured for a rising edge interrupt (PIO_PinInterruptCallbackRegister API)
+     *       and the PIO interrupt of its port enabled in the NVIC.
+     *
+     * @note Spurious or stale notifications are tolerated: the waiting task re-samples R/B# after
+     *       every wakeup.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> enableReadyBusyInterrupt(NotificationWaitDelegate waitNotification,
+                                                                              NotificationGiveDelegate notifyFromIsr);
+
+    /**
+     * @brief Get the ONFI asynchronous timing mode the device and the SMC currently run in.
+     *
+     * @return Timing mode (0 to 5)
+     */
+    [[nodiscard]] uint8_t getTimingMode() const {
+        return activeTiming->mode;
+    }
+
+
     /* ================== Data Operations ================== */
 
     /**
@@ -248,6 +339,628 @@ public:
     [[nodiscard]] etl::expected<void, NANDErrorCode> eraseBlock(uint16_t block, uint8_t lun = 0U);
 
 
+    /* ================== Scatter-Gather Operations ================== */
+
+    /**
+     * @brief Read several column ranges of one page straight into separate buffers.
+     *
+     * @details One 00h-addr-30h loads the page, then each segment is fetched with CHANGE READ COLUMN
+     *          (05h-col-E0h, tCCS) directly into its buffer, so that e.g. the payload and the spare area
+     *          metadata land in their own structures without a page sized bounce buffer. A segment
+     *          starting where the previous one ended is streamed without a column change.
+     *
+     * @param address Page to read (column is ignored)
+     * @param segments Column ranges in any order, spare area included; may overlap
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+     * @retval NANDErrorCode::INVALID_PARAMETER No segment, or a segment exceeds the page
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Address validation failed
+     * @retval NANDErrorCode::DEVICE_BUSY Device busy
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     * @retval NANDErrorCode::DMA_FAILED DMA data phase failed
+     *
+     * @note Thread Safety: Caller must hold external mutex for duration of read operation.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readPageSegments(const NANDAddress& address,
+                                                                      etl::span<const ReadSegment> segments);
+
+    /**
+     * @brief Program several column ranges of one page from separate buffers in one PAGE PROGRAM.
+     *
+     * @details The first segment follows 80h-addr, every other one CHANGE WRITE COLUMN (85h-col, tCCS),
+     *          and a single 10h programs them all. Columns not covered by any segment stay erased.
+     *          A segment starting where the previous one ended is streamed without a column change.
+     *
+     * @param address Page to program (column is ignored)
+     * @param segments Column ranges in any order, spare area included. Where segments overlap the
+     *                 last one sent wins.
+     *
+     * @pre Target page must be in erased state (all 0xFF)
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::INVALID_PARAMETER No segment, a segment exceeds the page, or a segment
+     *                                          holds an invalid block marker value at column 8192
+     * @retval NANDErrorCode::PROGRAM_FAILED Status register indicates program failure
+     *
+     * @note Counts as one partial program of the page, whatever the number of segments.
+     *
+     * @see programPage() for the other errors
+     * @see MT29F datasheet section "CHANGE WRITE COLUMN (85h)"
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> programPageSegments(const NANDAddress& address,
+                                                                         etl::span<const ProgramSegment> segments);
+
+
+    /* ================== Erased Page Detection ================== */
+
+    /**
+     * @brief Check whether a page, spare area included, is erased (all 0xFF).
+     *
+     * @details The page is streamed from the device with 32-bit accesses and checked one word at a time,
+     *          without any buffer: an all-ones word costs a single compare, any other word adds its 0 bits
+     *          to the running count. The scan stops at the first word taking the count above
+     *          bitFlipTolerance, so a written page usually costs tR plus a few bus cycles.
+     *
+     * @param address Page to check (column is ignored)
+     * @param bitFlipTolerance Number of 0 bits still reported as erased (bits flipped by read disturb or
+     *                         stuck cells)
+     *
+     * @return true if the page has at most bitFlipTolerance 0 bits, or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Address validation failed
+     * @retval NANDErrorCode::DEVICE_BUSY Device busy
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     *
+     * @note Thread Safety: Caller must hold external mutex for duration of read operation.
+     */
+    [[nodiscard]] etl::expected<bool, NANDErrorCode> isPageErased(const NANDAddress& address,
+                                                                  uint32_t bitFlipTolerance = 0U);
+
+
+    /* ================== Split-Phase Operations ================== */
+
+    /**
+     * @brief Start reading a page into the data register and return while the array is busy (tR).
+     *
+     * @details Split-phase operations let the caller drive other devices while this one is busy,
+     *          e.g. the chips of a NANDStripedVolume. Finish with completeOperation().
+     *
+     * @param address Page to read, the column is where completeOperation() starts the transfer
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Address validation failed
+     * @retval NANDErrorCode::DEVICE_BUSY Device busy, or an operation is still pending
+     *
+     * @note Thread Safety: Caller must hold external mutex until completeOperation() returns.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> startReadPage(const NANDAddress& address);
+
+    /**
+     * @brief Send a page program and return while the array is busy (tPROG).
+     *
+     * @details The data phase runs before this returns, the caller's buffer is free afterwards.
+     *          WP# stays deasserted until completeOperation().
+     *
+     * @return Same errors as programPage() except PROGRAM_FAILED and TIMEOUT, reported by completeOperation()
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> startProgramPage(const NANDAddress& address,
+                                                                      etl::span<const uint8_t> data);
+
+    /**
+     * @brief Send a block erase and return while the array is busy (tBERS).
+     *
+     * @return Same errors as eraseBlock() except ERASE_FAILED and TIMEOUT, reported by completeOperation()
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> startEraseBlock(uint16_t block, uint8_t lun = 0U);
+
+    /**
+     * @brief Wait for the pending split-phase operation and report its outcome.
+     *
+     * @param[out] data Page data of a pending read, from the column given to startReadPage().
+     *                  Ignored for programs and erases.
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::INVALID_PARAMETER No operation pending, or data.size() exceeds the page
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     * @retval NANDErrorCode::PROGRAM_FAILED Status register indicates program failure
+     * @retval NANDErrorCode::ERASE_FAILED Status register indicates erase failure
+     *
+     * @note The operation is no longer pending afterwards, whatever the outcome.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> completeOperation(etl::span<uint8_t> data = {});
+
+    [[nodiscard]] bool isOperationPending() const {
+        return pendingOperation != PendingOperation::NONE;
+    }
+
+
+    /* ================== Random Column Read Operations ================== */
+
+    /**
+     * @brief Load a page into the page register for random column reads.
+     *
+     * @details Issues 00h-addr-30h once and keeps the page open, so that any number of column
+     *          ranges can then be fetched with readOpenPage() at the cost of tCCS each instead of tR.
+     *          The page stays open until closePage() or until any other operation is issued.
+     *
+     * @param address Page to open (column is ignored)
+     *
+     * @pre Driver must be initialized
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Invalid address
+     * @retval NANDErrorCode::DEVICE_BUSY Device busy
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> openPage(const NANDAddress& address);
+
+    /**
+     * @brief Read a column range of the open page with CHANGE READ COLUMN (05h-col-E0h).
+     *
+     * @param column Column to start reading from (0 - TotalBytesPerPage-1, spare area included)
+     * @param[out] data Destination buffer
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::PAGE_NOT_OPEN No page open, or it was closed by another operation
+     * @retval NANDErrorCode::INVALID_PARAMETER Range exceeds the page
+     * @retval NANDErrorCode::DMA_FAILED DMA data phase failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readOpenPage(uint16_t column, etl::span<uint8_t> data);
+
+    /**
+     * @brief Close the page opened with openPage().
+     */
+    void closePage() {
+        isPageOpen = false;
+    }
+
+    /**
+     * @return Address of the open page, if any
+     */
+    [[nodiscard]] etl::optional<NANDAddress> getOpenPage() const {
+        if (not isPageOpen) {
+            return etl::nullopt;
+        }
+
+        return openPageAddress;
+    }
+
+
+    /* ================== ECC Protected Data Operations ================== */
+
+    /*
+     * Spare area layout of pages written with programPageEcc() (offsets relative to BlockMarkerOffset):
+     *
+     *   0        bad block marker (0xFF, not ECC protected)
+     *   1 - 32   caller metadata, protected by its own BCH codeword
+     *   33 - 63  reserved (0xFF)
+     *   64 -     BCH parity of data sectors 0-7, then of the metadata (9 x 42 bytes)
+     */
+
+    static constexpr uint16_t EccSectorBytes = 1024U;                               /*!< Data bytes per BCH codeword */
+
+    static constexpr uint8_t EccSectorsPerPage = DataBytesPerPage / EccSectorBytes;
+
+    static constexpr uint16_t EccMetadataBytes = 32U;                               /*!< Caller metadata bytes per page */
+
+    static constexpr uint16_t EccMetadataOffset = 1U;                               /*!< Metadata offset in the spare area */
+
+    static constexpr uint16_t EccParityOffset = 64U;                                /*!< Parity offset in the spare area */
+
+    static_assert(EccParityOffset + ((EccSectorsPerPage + 1U) * BCHCodec::ParityBytes) <= SpareBytesPerPage,
+                  "ECC parity does not fit the spare area");
+
+    /**
+     * @brief Outcome of an ECC protected page read.
+     */
+    struct EccStatus {
+        uint16_t correctedBits = 0U;    /*!< Bit errors corrected over all codewords of the page */
+        uint8_t maxCorrectedBits = 0U;  /*!< Most bit errors corrected in a single codeword */
+        bool isErased = false;          /*!< Page was erased (never programmed); data and metadata read as 0xFF */
+    };
+
+    /**
+     * @brief Read a page written by programPageEcc() and correct bit errors.
+     *
+     * @details Reads data and spare area in one pass and decodes the eight data codewords and the
+     *          metadata codeword. Codewords without errors only cost a parity recomputation.
+     *          Erased codewords (at most BCHCodec::CorrectableBits bits at 0) are returned as 0xFF.
+     *          An uncorrectable page is read again with the other read retry options (see ReadRetryOptions).
+     *
+     * @param address Page to read (column must be 0)
+     * @param[out] data Page data, exactly DataBytesPerPage bytes
+     * @param[out] metadata Optional buffer for the first metadata.size() metadata bytes (at most EccMetadataBytes)
+     *
+     * @pre Driver must be initialized
+     *
+     * @return Corrected bit counts or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+     * @retval NANDErrorCode::INVALID_PARAMETER Column not 0, wrong data size or metadata too long
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Address validation failed
+     * @retval NANDErrorCode::DEVICE_BUSY Device busy
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     * @retval NANDErrorCode::DMA_FAILED DMA data phase failed
+     * @retval NANDErrorCode::ECC_UNCORRECTABLE A codeword could not be corrected (data holds the raw page)
+     */
+    [[nodiscard]] etl::expected<EccStatus, NANDErrorCode> readPageEcc(const NANDAddress& address, etl::span<uint8_t> data,
+                                                                       etl::span<uint8_t> metadata = {});
+
+    /**
+     * @brief Program a full page with BCH parity in the spare area.
+     *
+     * @param address Page to program (column must be 0)
+     * @param data Page data, exactly DataBytesPerPage bytes
+     * @param metadata Optional metadata (at most EccMetadataBytes, padded with 0xFF)
+     *
+     * @pre Driver must be initialized
+     * @pre Target page must be in erased state
+     *
+     * @return Success (empty expected) or specific error code, as programPage()
+     * @retval NANDErrorCode::INVALID_PARAMETER Column not 0, wrong data size or metadata too long
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> programPageEcc(const NANDAddress& address,
+                                                                    etl::span<const uint8_t> data,
+                                                                    etl::span<const uint8_t> metadata = {});
+
+    /**
+     * @brief Read and correct only the metadata of a page written by programPageEcc().
+     *
+     * @details Opens the page and fetches the metadata and its parity with CHANGE READ COLUMN, so
+     *          only 74 bytes cross the bus instead of the full page. Intended for scans that need
+     *          the per-page metadata of many pages (e.g. rebuilding a logical to physical mapping).
+     *          Read retry applies as for readPageEcc().
+     *
+     * @param address Page to read (column is ignored)
+     * @param[out] metadata Buffer for the first metadata.size() metadata bytes (at most EccMetadataBytes)
+     *
+     * @pre Driver must be initialized
+     *
+     * @return Corrected bit count of the metadata codeword or specific error code
+     * @retval NANDErrorCode::INVALID_PARAMETER Metadata too long
+     * @retval NANDErrorCode::ECC_UNCORRECTABLE The metadata codeword could not be corrected
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     */
+    [[nodiscard]] etl::expected<EccStatus, NANDErrorCode> readPageMetadataEcc(const NANDAddress& address,
+                                                                               etl::span<uint8_t> metadata);
+
+
+    /* ================== Read Retry ================== */
+
+    /*
+     * readPageEcc() and readPageMetadataEcc() recover pages whose threshold voltages have drifted (retention,
+     * read disturb, wear). When a read is uncorrectable, it is repeated with the next read retry option
+     * (SET FEATURES 89h), which shifts the read reference voltages, until ECC succeeds or every option has
+     * been tried. The device is set back to the default option afterwards, so raw reads are unaffected.
+     *
+     * The option that worked is remembered per block (4 bits of RAM each) and tried first on the next
+     * read of that block, so a degraded block costs one SET FEATURES pair instead of a series of failed tR.
+     * Erasing the block forgets it.
+     */
+
+    static constexpr uint8_t ReadRetryOptions = MT29FGeometry::ReadRetryOptions;
+
+    static_assert(ReadRetryOptions <= 16U, "Read retry options are stored in 4 bits");
+
+    /**
+     * @return Read retry option the next ECC read of the block starts with, 0 for a healthy block
+     */
+    [[nodiscard]] uint8_t getReadRetryOption(uint16_t block) const {
+        constexpr uint8_t OptionBits = 4U;
+        constexpr uint8_t OptionMask = 0x0FU;
+
+        if (block >= BlocksPerLun) {
+            return 0U;
+        }
+
+        return (readRetryOptions[block / 2U] >> ((block & 1U) * OptionBits)) & OptionMask;
+    }
+
+
+    /* ================== Cache Read Operations ================== */
+
+    /**
+     * @brief Forward-only view of the page held in the device's cache register.
+     *
+     * @details Handed to a PageSink during readPagesSequential(). Each read() pulls the next bytes
+     *          of the page straight from the NAND data phase into caller memory, so the sink can
+     *          scatter the page wherever it needs it without an intermediate page buffer.
+     *          Bytes that are not consumed are simply discarded when the sink returns.
+     */
+    class PageDataStream {
+    public:
+        /**
+         * @brief Read the next bytes of the page.
+         *
+         * @param[out] data Destination buffer
+         *
+         * @return Number of bytes read (less than data.size() only at the end of the page)
+         */
+        size_t read(etl::span<uint8_t> data);
+
+        /**
+         * @return Number of page bytes not yet read
+         */
+        [[nodiscard]] size_t remaining() const {
+            return remainingBytes;
+        }
+
+    private:
+        friend class MT29F;
+
+        PageDataStream(MT29F& nand, size_t length) : nand{nand}, remainingBytes{length} {}
+
+        MT29F& nand;
+
+        size_t remainingBytes;
+    };
+
+    /**
+     * @brief Consumer of pages delivered by readPagesSequential().
+     *
+     * @details Called once per page with the page address and a stream positioned at column 0.
+     *          Return false to stop the sequence early.
+     *
+     * @note While the sink runs, the device is already transferring the next page from the array
+     *       into its data register, so time spent in the sink overlaps with tR.
+     */
+    using PageSink = etl::delegate<bool(const NANDAddress&, PageDataStream&)>;
+
+    /**
+     * @brief Read consecutive pages using the READ CACHE pipeline.
+     *
+     * @details Issues 00h-addr-30h for the first page and then READ CACHE SEQUENTIAL (31h) for
+     *          every following page, or READ CACHE RANDOM (00h-addr-31h) when the sequence crosses
+     *          into the next block. The last page is fetched with READ CACHE END (3Fh), and so is
+     *          the page already being loaded when the sink stops early, to leave the cache read mode.
+     *          After each 31h the device copies the page into the cache register and immediately
+     *          starts loading the next one into the data register, so the host only waits tRCBSY
+     *          instead of a full tR per page.
+     *
+     * @param startAddress First page to read (column must be 0). Pages continue into the following blocks.
+     * @param pageCount Number of pages to read
+     * @param sink Consumer invoked for every page, in order
+     *
+     * @pre Driver must be initialized
+     *
+     * @return Success (empty expected) or specific error code. Stopping early from the sink is not an error.
+     * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+     * @retval NANDErrorCode::INVALID_PARAMETER Column is not 0 or no sink provided
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Start address invalid or the range runs past the end of the LUN
+     * @retval NANDErrorCode::DEVICE_BUSY Device busy
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     *
+     * @note Bad blocks inside the range are not skipped (caller responsibility).
+     *
+     * @note Thread Safety: Caller must hold external mutex for the whole sequence, including the sink calls.
+     *
+     * @see MT29F datasheet sections "READ CACHE SEQUENTIAL (31h)", "READ CACHE RANDOM (00h-31h)"
+     *      and "READ CACHE END (3Fh)"
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readPagesSequential(const NANDAddress& startAddress, uint32_t pageCount,
+                                                                         PageSink sink);
+
+
+    /* ================== Cache Program Operations ================== */
+
+    /**
+     * @brief Consumer of per-page program results reported by CacheProgramWriter.
+     *
+     * @details Called exactly once for every page passed to the writer, in order, as soon as the
+     *          device reports the outcome of that page (false = program failed).
+     */
+    using ProgramStatusSink = etl::delegate<void(const NANDAddress&, bool)>;
+
+    /**
+     * @brief Streaming page writer using the PAGE PROGRAM CACHE pipeline.
+     *
+     * @details Every page except the last one is written with 80h-addr-data-15h. After 15h the
+     *          device moves the page to its data register, starts programming it and frees the
+     *          cache register after tCBSY, so the data input of the next page overlaps with the
+     *          array program of the previous one. The last page is written through finish() with
+     *          80h-addr-data-10h, which waits for the whole pipeline to drain.
+     *
+     *          Program results arrive one page late: after 15h, status bit 1 (FAILC) reports the
+     *          page programmed before, and after the final 10h, bit 0 (FAIL) reports the last page.
+     *          The writer keeps track of the page still in flight and reports every page through
+     *          the ProgramStatusSink.
+     *
+     *          WP# is deasserted by the first write() and asserted again by finish() or on destruction.
+     *
+     * @note Thread Safety: Caller must hold external mutex from the first write() until finish() returns.
+     *
+     * @see MT29F datasheet section "PROGRAM PAGE CACHE (80h-15h)"
+     */
+    class CacheProgramWriter {
+    public:
+        /**
+         * @param nand Initialized driver to write through
+         * @param statusSink Optional consumer of per-page program results
+         */
+        explicit CacheProgramWriter(MT29F& nand, ProgramStatusSink statusSink = ProgramStatusSink{})
+            : nand{nand}
+            , statusSink{statusSink} {}
+
+        /**
+         * @brief Drains an unfinished stream (waits for the array) and re-asserts WP#.
+         */
+        ~CacheProgramWriter();
+
+        CacheProgramWriter(const CacheProgramWriter&) = delete;
+        CacheProgramWriter& operator=(const CacheProgramWriter&) = delete;
+        CacheProgramWriter(CacheProgramWriter&&) = delete;
+        CacheProgramWriter& operator=(CacheProgramWriter&&) = delete;
+
+        /**
+         * @brief Queue one page with 80h-addr-data-15h.
+         *
+         * @param address Page to write
+         * @param data Data to write, same rules as MT29F::programPage()
+         *
+         * @return Success (empty expected) or specific error code
+         * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+         * @retval NANDErrorCode::INVALID_PARAMETER Data too long or invalid block marker value
+         * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Address validation failed
+         * @retval NANDErrorCode::DEVICE_BUSY Device busy when the stream was started
+         * @retval NANDErrorCode::WRITE_PROTECTED Device is write protected
+         * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+         * @retval NANDErrorCode::PROGRAM_FAILED The previously queued page failed to program
+         */
+        [[nodiscard]] etl::expected<void, NANDErrorCode> write(const NANDAddress& address, etl::span<const uint8_t> data);
+
+        /**
+         * @brief Write the last page with 80h-addr-data-10h and wait for the pipeline to drain.
+         *
+         * @param address Page to write
+         * @param data Data to write, same rules as MT29F::programPage()
+         *
+         * @return Success (empty expected) or specific error code, as write()
+         * @retval NANDErrorCode::PROGRAM_FAILED The previously queued page or the last page failed to program
+         */
+        [[nodiscard]] etl::expected<void, NANDErrorCode> finish(const NANDAddress& address, etl::span<const uint8_t> data);
+
+    private:
+        MT29F& nand;
+
+        ProgramStatusSink statusSink;
+
+        bool isStreaming = false;   /*!< WP# deasserted and a page may still be in flight */
+
+        bool hasPageInFlight = false;
+
+        NANDAddress pageInFlight;   /*!< Page whose program result has not been reported yet */
+
+        /**
+         * @brief Send 80h-addr-data-confirm for one page and wait until the cache register is free.
+         */
+        [[nodiscard]] etl::expected<void, NANDErrorCode> sendPage(const NANDAddress& address, etl::span<const uint8_t> data,
+                                                                  bool isLastPage);
+
+        /**
+         * @brief Report a page result to the sink.
+         *
+         * @return true if the page programmed successfully
+         */
+        bool report(const NANDAddress& address, bool programSucceeded);
+
+        /**
+         * @brief Wait for the array and re-assert WP#.
+         */
+        void endStream();
+    };
+
+
+    /* ==================== DMA Data Transfers ==================== */
+
+    /**
+     * @brief Counters of how page data phases were carried out.
+     */
+    struct DataPhaseStatistics {
+        uint32_t dmaTransfers = 0U;     /*!< Data phases completed by the DMA engine */
+        uint32_t cpuTransfers = 0U;     /*!< Data phases moved by the CPU (no engine, short transfer or no free channel) */
+        uint32_t dmaFailures = 0U;      /*!< DMA data phases that failed or timed out */
+    };
+
+    /**
+     * @brief Offload the data phase of page transfers to a DMA engine.
+     *
+     * @details Used by readPage(), programPage(), the multi-plane operations and CacheProgramWriter
+     *          for transfers of at least DmaMinimumTransferBytes. The calling task blocks in
+     *          NANDDmaEngine::waitForCompletion() while the page is moved. If the engine has no
+     *          free channel the transfer is done by the CPU instead.
+     *
+     * @param engine DMA engine (must outlive the driver), nullptr to use the CPU only
+     *
+     * @note Buffers passed to the data operations must then be accessible by the DMA controller
+     *       (not in TCM) and, on targets with a data cache, 32-byte aligned.
+     */
+    void attachDmaEngine(NANDDmaEngine* engine) {
+        dmaEngine = engine;
+    }
+
+    /**
+     * @return Data phase counters since construction
+     */
+    [[nodiscard]] const DataPhaseStatistics& getDataPhaseStatistics() const {
+        return dataPhaseStatistics;
+    }
+
+
+    /* ==================== Instrumentation ==================== */
+
+    /**
+     * @brief Latency histograms and error counters of the device operations.
+     *
+     * @details Durations are measured with the DWT cycle counter (enabled by initialize()) on target
+     *          and with the steady clock on the host, so they include the data phase, the time spent
+     *          yielding and any wait on the device. The cycle counter wraps every 2^32 cycles (about 14 s
+     *          at 300 MHz), far beyond the longest timeout.
+     */
+    struct OperationStatistics {
+        LatencyHistogram read;          /*!< Page, segment, ECC, multi-plane and copyback reads */
+        LatencyHistogram program;       /*!< Page, segment, ECC, multi-plane and copyback programs */
+        LatencyHistogram erase;         /*!< eraseBlock() and eraseBlockMultiPlane() */
+        LatencyHistogram waitForReady;  /*!< Every wait for the device to become ready */
+        uint32_t timeouts = 0U;         /*!< Waits for ready that timed out */
+        uint32_t statusFailures = 0U;   /*!< Program, erase or copyback status with a FAIL bit set */
+        uint32_t retries = 0U;          /*!< Repeated attempts of a failed read (block marker, read retry options) */
+        uint32_t readRetryRecoveries = 0U;  /*!< ECC reads that only succeeded with another read retry option */
+        uint32_t badBlocksMarked = 0U;  /*!< Blocks newly marked bad by markBadBlock() */
+        uint64_t spinUs = 0U;           /*!< Time spent busy-waiting for ready (CPU burnt) */
+    };
+
+    /**
+     * @brief Array operations whose busy time the ready wait learns.
+     */
+    enum class BusyOperation : uint8_t {
+        ARRAY_READ = 0U,    /*!< tR */
+        PROGRAM,            /*!< tPROG */
+        ERASE,              /*!< tBERS */
+        OTHER,              /*!< Not learned: reset, features, cache and multi-plane queueing */
+    };
+
+    /**
+     * @return Learned busy time of an operation in microseconds, 0 before the first completion or for OTHER
+     */
+    [[nodiscard]] uint32_t getBusyTimeEstimateUs(BusyOperation operation) const {
+        return (operation == BusyOperation::OTHER)
+                   ? 0U
+                   : (busyTimeEstimates[static_cast<uint8_t>(operation)] >> BusyEstimateShift);
+    }
+
+    /**
+     * @return Counters since construction or the last resetOperationStatistics()
+     *
+     * @note Thread Safety: The histograms are updated by the task holding the driver, read them from
+     *       that task for a consistent snapshot.
+     */
+    [[nodiscard]] const OperationStatistics& getOperationStatistics() const {
+        return operationStatistics;
+    }
+
+    void resetOperationStatistics() {
+        operationStatistics = OperationStatistics {};
+    }
+
+    /**
+     * @return Free-running CPU cycle count: DWT CYCCNT on target, the steady clock scaled to
+     *         CPU_CLOCK_FREQUENCY on the host. Also used by the layers above the driver for their
+     *         own timing counters.
+     */
+    [[nodiscard]] static uint32_t readCycleCounter();
+
+    /**
+     * @return Microseconds since startCycles (valid for up to 2^32 cycles)
+     */
+    [[nodiscard]] static uint32_t getElapsedMicroseconds(uint32_t startCycles) {
+        constexpr uint32_t CpuMhz = CPU_CLOCK_FREQUENCY / 1000000U;
+
+        return (readCycleCounter() - startCycles) / CpuMhz;
+    }
+
+
     /* ==================== Bad Block Management ==================== */
 
     /**
@@ -261,6 +974,9 @@ public:
      * @return true if block is bad, false if good or specific error code
      * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Block or LUN exceeds device geometry
      *
+     * @note Blocks reserved for the persistent bad block table (UsableBlocksPerLun and above) are
+     *       always reported as bad.
+     *
      * @note Thread Safety: Read-only access to bad block bitset so it's safe for concurrent reads.
      */
     [[nodiscard]] etl::expected<bool, NANDErrorCode> isBlockBad(uint16_t block, uint8_t lun = 0U) const;
@@ -277,6 +993,13 @@ public:
      * @return Success (empty expected) or specific error code
      * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Block or LUN exceeds device geometry
      *
+     * @details Once the driver is initialized, a 0x00 marker is programmed into the spare area of
+     *          page 0 of a newly marked block, so a later factory marker scan still finds it, and the
+     *          block is written back to the persistent bad block table right away.
+     *
+     * @retval NANDErrorCode::PROGRAM_FAILED No copy of the persistent table could be updated
+     *                                       (the block is still marked bad in RAM)
+     *
      * @warning The driver does not auto-mark blocks. The caller is responsible for
      *          bad block policy decisions.
      *          Call this when program/erase operations fail.
@@ -285,6 +1008,21 @@ public:
      */
     [[nodiscard]] etl::expected<void, NANDErrorCode> markBadBlock(uint16_t block, uint8_t lun = 0U);
 
+    /**
+     * @brief Discard the persistent bad block table and rebuild it from the factory markers.
+     *
+     * @details Runs the full factory marker scan and writes the result as a new table generation.
+     *          Blocks marked bad at runtime are kept, as markBadBlock() programs their marker, unless
+     *          that program failed.
+     *
+     * @pre Driver must be initialized
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+     * @retval NANDErrorCode::PROGRAM_FAILED No copy of the persistent table could be written
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> rebuildBadBlockTable();
+
 
     /* ==================== Plane Helpers ==================== */
 
@@ -338,6 +1076,72 @@ public:
      */
     [[nodiscard]] etl::expected<void, NANDErrorCode> eraseBlockMultiPlane(uint16_t block0, uint16_t block1, uint8_t lun = 0U);
 
+    /**
+     * @brief Program the same page of two blocks from different planes with a single tPROG.
+     *
+     * @param block0 First block (must be in different plane than block1)
+     * @param block1 Second block (must be in different plane than block0)
+     * @param page Page number inside both blocks
+     * @param data0 Data for block0, written from column 0. Same rules as programPage().
+     * @param data1 Data for block1, written from column 0. Same rules as programPage().
+     * @param lun LUN number (typically 0)
+     *
+     * @pre Driver must be initialized
+     * @pre Blocks must be in different planes (one even, one odd)
+     * @pre Target pages must be in erased state (all 0xFF)
+     * @post On success, both pages are programmed
+     *
+     * @return Success or error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+     * @retval NANDErrorCode::PLANE_MISMATCH Both blocks in same plane
+     * @retval NANDErrorCode::INVALID_PARAMETER Data exceeds the page size or invalid block marker value
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Block, page or LUN out of range
+     * @retval NANDErrorCode::DEVICE_BUSY Device busy
+     * @retval NANDErrorCode::WRITE_PROTECTED Device is write protected
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     * @retval NANDErrorCode::MULTIPLANE_FAILED Program operation failed on at least one plane
+     *
+     * @note Thread Safety: Caller must hold external mutex. Modifies device array state.
+     *
+     * @see MT29F datasheet section "PROGRAM PAGE MULTI-PLANE (80h-11h + 81h-10h)"
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> programPageMultiPlane(uint16_t block0, uint16_t block1, uint8_t page,
+                                                                           etl::span<const uint8_t> data0,
+                                                                           etl::span<const uint8_t> data1,
+                                                                           uint8_t lun = 0U);
+
+    /**
+     * @brief Read the same page of two blocks from different planes with a single tR.
+     *
+     * @details Both pages are loaded with 00h-addr-32h + 00h-addr-30h and then read out one plane at
+     *          a time through CHANGE READ COLUMN ENHANCED (06h-addr-E0h).
+     *
+     * @param block0 First block (must be in different plane than block1)
+     * @param block1 Second block (must be in different plane than block0)
+     * @param page Page number inside both blocks
+     * @param[out] data0 Buffer for block0, read from column 0 (up to TotalBytesPerPage bytes)
+     * @param[out] data1 Buffer for block1, read from column 0 (up to TotalBytesPerPage bytes)
+     * @param lun LUN number (typically 0)
+     *
+     * @pre Driver must be initialized
+     * @pre Blocks must be in different planes (one even, one odd)
+     *
+     * @return Success or error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Driver not initialized
+     * @retval NANDErrorCode::PLANE_MISMATCH Both blocks in same plane
+     * @retval NANDErrorCode::INVALID_PARAMETER A buffer exceeds the page size
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Block, page or LUN out of range
+     * @retval NANDErrorCode::DEVICE_BUSY Device busy
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     *
+     * @note Thread Safety: Caller must hold external mutex for duration of read operation.
+     *
+     * @see MT29F datasheet sections "READ PAGE MULTI-PLANE (00h-32h)" and "CHANGE READ COLUMN ENHANCED (06h-E0h)"
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readPageMultiPlane(uint16_t block0, uint16_t block1, uint8_t page,
+                                                                        etl::span<uint8_t> data0, etl::span<uint8_t> data1,
+                                                                        uint8_t lun = 0U);
+
 
     /* ==================== Copyback Operations ==================== */
 
@@ -391,6 +1195,17 @@ public:
                                                                      const NANDAddress& destinationAddress,
                                                                      etl::span<uint8_t> buffer);
 
+    /**
+     * @brief ONFI CRC-16 (polynomial 0x8005, initial value 0x4F4E, MSB first).
+     *
+     * @details Also protects the bad block table records and the NANDFTLJournal records.
+     *
+     * @param data Bytes to checksum
+     *
+     * @return CRC of data
+     */
+    [[nodiscard]] static uint16_t computeCrc16(etl::span<const uint8_t> data);
+
 
 private:
     /* ============= ONFI Protocol Definitions ============= */
@@ -409,6 +1224,10 @@ private:
         READ_PARAM_PAGE = 0xECU,            /*!< ECh: Read ONFI parameter page (followed by address 00h) */
         READ_UNIQ_ID = 0xEDU,               /*!< EDh: Read unique device identifier */
 
+        /* Feature Operations */
+        SET_FEATURES = 0xEFU,               /*!< EFh: Set feature parameters (EFh-addr-P1..P4) */
+        GET_FEATURES = 0xEEU,               /*!< EEh: Read feature parameters (EEh-addr, then P1..P4 output) */
+
         /* Status */
         READ_STATUS = 0x70U,                /*!< 70h: Read status register (immediate, no address cycles) */
 
@@ -419,10 +1238,13 @@ private:
         /* Read Operations */
         READ_MODE = 0x00U,                  /*!< 00h: Start read sequence (followed by 5 address cycles) */
         READ_CONFIRM = 0x30U,               /*!< 30h: Confirm read and start array-to-register transfer (00h-addr-30h) */
+        READ_CACHE_SEQUENTIAL = 0x31U,      /*!< 31h: Move data register to cache and load the next page (or 00h-addr-31h: load given page) */
+        READ_CACHE_END = 0x3FU,             /*!< 3Fh: Move data register to cache without loading another page */
 
         /* Program Operations */
         PAGE_PROGRAM = 0x80U,               /*!< 80h: Start program sequence (followed by 5 address cycles + data) */
         PAGE_PROGRAM_CONFIRM = 0x10U,       /*!< 10h: Confirm and execute page program (80h-addr-data-10h) */
+        PAGE_PROGRAM_CACHE = 0x15U,         /*!< 15h: Confirm page program and release the cache register (80h-addr-data-15h) */
 
         /* Copyback Operations (internal data move, no host transfer) */
         COPYBACK_READ_CONFIRM = 0x35U,      /*!< 35h: Load page to internal register (00h-addr-35h, same-plane only) */
@@ -430,6 +1252,15 @@ private:
 
         /* Multi-Plane Operations */
         ERASE_MULTIPLANE_CONFIRM = 0xD1U,   /*!< D1h: Queue block for multi-plane erase (60h-addr-D1h, then 60h-addr-D0h) */
+        PAGE_PROGRAM_MULTIPLANE_CONFIRM = 0x11U, /*!< 11h: Queue page for multi-plane program (80h-addr-data-11h, then 81h-addr-data-10h) */
+        PAGE_PROGRAM_MULTIPLANE = 0x81U,    /*!< 81h: Start program sequence for the second plane of a multi-plane program */
+        READ_MULTIPLANE = 0x32U,            /*!< 32h: Queue page for multi-plane read (00h-addr-32h, then 00h-addr-30h) */
+
+        /* Column Change Operations */
+        CHANGE_READ_COLUMN = 0x05U,         /*!< 05h: Select column for data output within the current page (05h-col-E0h, 2 address cycles) */
+        CHANGE_READ_COLUMN_ENHANCED = 0x06U, /*!< 06h: Select plane and column for data output (06h-addr-E0h, 5 address cycles) */
+        CHANGE_READ_COLUMN_CONFIRM = 0xE0U, /*!< E0h: Confirm change read column */
+        CHANGE_WRITE_COLUMN = 0x85U,        /*!< 85h: Select column for data input inside a program sequence (85h-col, 2 address cycles) */
     };
 
     /**
@@ -440,9 +1271,19 @@ private:
         ONFI_SIGNATURE = 0x20U,
     };
 
+    /**
+     * @brief Feature addresses for SET/GET FEATURES.
+     */
+    enum class FeatureAddress : uint8_t {
+        TIMING_MODE = 0x01U,     /*!< P1[3:0]: timing mode, P1[5:4]: data interface (0 = asynchronous) */
+        READ_RETRY = 0x89U,      /*!< P1: read retry option (0 = default read reference voltages) */
+    };
+
+    using FeatureParameters = etl::array<uint8_t, 4>;
+
     static constexpr uint8_t StatusFail = 0x01U;           /*!< Program/Erase operation failed */
 
-    static constexpr uint8_t StatusFailCommand = 0x02U;   /*!< Program/Erase command failed */
+    static constexpr uint8_t StatusFailCommand = 0x02U;   /*!< Program/Erase command failed (cache program: previous page failed) */
 
     static constexpr uint8_t StatusArrayReady = 0x20U;    /*!< Array ready */
 
@@ -458,18 +1299,24 @@ private:
     static constexpr uint32_t GpioSettleTimeNs = 100U; /*!< WP# GPIO settling time */
 
 
-    /* ============= ONFI Timing Parameters (Timing Mode 0) ============= */
-    /** @see MT29F datasheet AC Timing Tables for Mode 0 parameters */
+    /* ============= ONFI Timing Parameters ============= */
+    /** @see ONFITiming for the per-mode values used between cycles (tWHR, tADL, tRHW, tRR, tWB) */
+
+    static constexpr uint32_t TccsNs = 200U;   /*!< tCCS: change column setup time to data in/out (parameter page, all modes) */
+
+    static constexpr uint32_t SmcClockFrequency = CPU_CLOCK_FREQUENCY / 2U;   /*!< MCK clocking the SMC (HCLK/2) */
+
+    static_assert(SmcClockFrequency <= 150000000U, "MCK must not exceed 150 MHz");
 
-    static constexpr uint32_t TwhrNs = 120U;   /*!< tWHR: WE# HIGH to RE# LOW (command to read) */
+    static constexpr etl::array<ONFITiming::SmcCycles, ONFITiming::ModeCount> SmcTimings = ONFITiming::toSmcCycles(SmcClockFrequency);
 
-    static constexpr uint32_t TadlNs = 200U;   /*!< tADL: ALE LOW to data input valid */
+    static_assert(ONFITiming::fitsSmcRegisters(SmcTimings), "SMC timings exceed the register fields");
 
-    static constexpr uint32_t TrhwNs = 200U;   /*!< tRHW: RE# HIGH to WE# LOW (read to write turnaround) */
+    const ONFITiming::Mode* activeTiming = &ONFITiming::Modes[0];   /*!< Mode the device and the SMC run in */
 
-    static constexpr uint32_t TrrNs = 40U;     /*!< tRR: R/B# rising edge to RE# falling edge */
+    uint16_t supportedTimingModes = 1U;   /*!< Parameter page bytes 129-130, bit N = mode N (mode 0 until read) */
 
-    static constexpr uint32_t TwbNs = 200U;    /*!< tWB: WE# HIGH to R/B# falling edge */
+    bool isTimingModeNegotiated = false;  /*!< initialize() has selected a timing mode, restored after reset() */
 
 
     /* ============= Operation Timeout Values ============= */
@@ -483,6 +1330,10 @@ private:
 
     static constexpr uint32_t TimeoutResetUs = 5000U;    /*!< tRST timeout (datasheet max: 1ms) */
 
+    static constexpr uint32_t TimeoutDummyBusyUs = 10U;  /*!< tDBSY timeout (datasheet max: 1us) */
+
+    static constexpr uint32_t TimeoutFeatureUs = 10U;    /*!< tFEAT timeout (datasheet max: 1us) */
+
     /**
      * @brief Type alias for 5-cycle NAND addressing.
      *
@@ -533,6 +1384,16 @@ private:
      */
     [[nodiscard]] etl::expected<uint8_t, NANDErrorCode> readBlockMarker(uint16_t block, uint8_t lun = 0U);
 
+    /**
+     * @brief Program BadBlockMarker into the marker byte of page 0 of a block.
+     *
+     * @details Bypasses the marker check of programPage(). Programming only clears bits, so the rest of
+     *          the page keeps its content.
+     *
+     * @see executeProgramCommandSequence(const NANDAddress&, etl::span<const uint8_t>, etl::span<const uint8_t>) for the errors
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> programBlockMarker(uint16_t block, uint8_t lun);
+
     /**
      * @brief Scan all blocks in a LUN for factory bad block markers.
      *
@@ -554,6 +1415,86 @@ private:
     [[nodiscard]] etl::expected<void, NANDErrorCode> scanFactoryBadBlocks(uint8_t lun = 0U);
 
 
+    /* ============= Persistent Bad Block Table ============= */
+
+    /*
+     * Every good reserved block holds a copy of the table. Each update appends a record with the next
+     * generation number to the first erased page of every copy (the block is erased first when full),
+     * so at any time at most one copy lacks the latest record. A record is written as a partial page:
+     *
+     *   0 - 3    magic "BBT0"
+     *   4        format version
+     *   5        LUN count
+     *   6 - 7    blocks per LUN (little endian)
+     *   8 - 11   generation (little endian)
+     *   12 -     bad block bitset, one bit per block, LUN after LUN (bit 0 of byte 0 = block 0)
+     *   ...      CRC-16 of all preceding bytes (little endian)
+     *   ...      BCH parity of all preceding bytes
+     */
+
+    static constexpr etl::array<uint8_t, 4> BbtMagic { 'B', 'B', 'T', '0' };
+
+    static constexpr uint8_t BbtVersion = 1U;
+
+    static constexpr size_t BbtGenerationOffset = 8U;
+
+    static constexpr size_t BbtBitsetOffset = 12U;
+
+    static constexpr size_t BbtBitsetBytes = BlocksPerLun / 8U;
+
+    static constexpr size_t BbtCrcOffset = BbtBitsetOffset + (LunsPerCe * BbtBitsetBytes);
+
+    static constexpr size_t BbtRecordBytes = BbtCrcOffset + sizeof(uint16_t);
+
+    static_assert(BbtRecordBytes <= BCHCodec::MaxDataBytes, "Bad block table record exceeds one BCH codeword");
+
+    static constexpr uint8_t BbtProgrammedZeroBits = 8U;   /*!< Zero bits in the magic above which a page counts as programmed */
+
+    using BbtRecord = etl::array<uint8_t, BbtRecordBytes + BCHCodec::ParityBytes>;
+
+    uint32_t bbtGeneration = 0U;   /*!< Generation of the table in RAM */
+
+    etl::array<uint8_t, ReservedBlocksPerLun> bbtNextPage{};   /*!< First erased page of each reserved block */
+
+    /**
+     * @brief Load the newest valid table record from the reserved blocks.
+     *
+     * @details Finds the first erased page of every reserved block by binary search on the record
+     *          magic and walks back from there to the newest record that passes ECC, CRC and header checks.
+     *
+     * @return true if a record was loaded, false if no reserved block holds a valid one, or specific error code
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     */
+    [[nodiscard]] etl::expected<bool, NANDErrorCode> loadBadBlockTable();
+
+    /**
+     * @brief Append the table in RAM as a new generation to every good reserved block.
+     *
+     * @details Reserved blocks failing to erase or program are marked bad and skipped.
+     *
+     * @return Success (empty expected) if at least one copy was written
+     * @retval NANDErrorCode::PROGRAM_FAILED No copy could be written
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> persistBadBlockTable();
+
+    /**
+     * @brief Binary search for the first page of a reserved block without a table record.
+     *
+     * @return Page number (PagesPerBlock if the block is full) or specific error code
+     */
+    [[nodiscard]] etl::expected<uint8_t, NANDErrorCode> findFirstErasedBbtPage(uint16_t block);
+
+    /**
+     * @brief Read and validate a table record.
+     *
+     * @param[out] record Corrected record
+     *
+     * @return true if the record is valid, false if it is uncorrectable or fails the header/CRC checks,
+     *         or the error code of the read
+     */
+    [[nodiscard]] etl::expected<bool, NANDErrorCode> readBbtRecord(uint16_t block, uint8_t page, BbtRecord& record);
+
+
     /* ============= Write Protection ============= */
 
     /**
@@ -607,16 +1548,25 @@ private:
         DEASSERTED = true,   /*!< Active-low signal driven HIGH (inactive state) */
     };
 
+    const ChipSelect nandChipSelect; /*!< SMC chip select whose timings are programmed */
+
     const PIO_PIN nandReadyBusyPin; /*!< GPIO pin for monitoring R/B# (Ready/Busy) signal */
 
     const PIO_PIN nandWriteProtectPin; /*!< GPIO pin for controlling WP# (Write Protect) signal */
 
+    NANDBus* const busBackend = nullptr; /*!< Optional bus backend replacing the SMC accesses (nullptr = SMC/EBI) */
+
     /**
      * @brief Send data byte to NAND flash.
      *
      * @param data Data byte to send
      */
     void sendData(uint8_t data) {
+        if (busBackend != nullptr) {
+            busBackend->writeData(data);
+            return;
+        }
+
         smcWriteByte(moduleBaseAddress, data);
     }
 
@@ -626,15 +1576,32 @@ private:
      * @param address Address byte to send
      */
     void sendAddress(uint8_t address) {
+        if (busBackend != nullptr) {
+            busBackend->writeAddress(address);
+            return;
+        }
+
         smcWriteByte(TriggerNANDAleAddress, address);
     }
 
     /**
      * @brief Send command to NAND flash (triggers CLE).
      *
+     * @details Any command other than 05h/E0h replaces the page register contents or the data
+     *          output, so it closes the page opened with openPage().
+     *
      * @param command NAND command to send
      */
     void sendCommand(Commands command) {
+        if ((command != Commands::CHANGE_READ_COLUMN) and (command != Commands::CHANGE_READ_COLUMN_CONFIRM)) {
+            isPageOpen = false;
+        }
+
+        if (busBackend != nullptr) {
+            busBackend->writeCommand(static_cast<uint8_t>(command));
+            return;
+        }
+
         smcWriteByte(TriggerNANDCleAddress, static_cast<uint8_t>(command));
     }
 
@@ -644,17 +1611,117 @@ private:
      * @return Data byte read from device
      */
     uint8_t readData() {
+        if (busBackend != nullptr) {
+            return busBackend->readData();
+        }
+
         return smcReadByte(moduleBaseAddress);
     }
 
+    /**
+     * @brief Read four data bytes with one 32-bit access.
+     *
+     * @return The bytes in output order, the first one in the least significant byte
+     */
+    uint32_t readDataWord() {
+        constexpr uint8_t BitsPerByte = 8U;
+
+        if (busBackend != nullptr) {
+            uint32_t word = 0U;
+
+            for (uint8_t byte = 0U; byte < sizeof(uint32_t); byte++) {
+                word |= static_cast<uint32_t>(busBackend->readData()) << (byte * BitsPerByte);
+            }
+
+            return word;
+        }
+
+        return smcReadWord(moduleBaseAddress);
+    }
+
+    /**
+     * @brief Check whether an R/B# line is available (GPIO pin or bus backend).
+     */
+    [[nodiscard]] bool hasReadyBusyLine() const {
+        return (busBackend != nullptr) or (nandReadyBusyPin != PIO_PIN_NONE);
+    }
+
+    /**
+     * @brief Sample the R/B# line.
+     *
+     * @pre hasReadyBusyLine() is true
+     *
+     * @retval true R/B# is LOW (device busy)
+     * @retval false R/B# is HIGH (device ready)
+     */
+    [[nodiscard]] bool isReadyBusyAsserted() const {
+        if (busBackend != nullptr) {
+            return busBackend->isBusy();
+        }
+
+        return PIO_PinRead(nandReadyBusyPin) == static_cast<bool>(ActiveLowPin::ASSERTED);
+    }
+
 
     /* ============= State Management ============= */
 
     bool isInitialized = false; /*!< Driver initialization status */
 
+    enum class PendingOperation : uint8_t {
+        NONE,
+        READ,
+        PROGRAM,
+        ERASE,
+    };
+
+    PendingOperation pendingOperation = PendingOperation::NONE;   /*!< Split-phase operation started and not completed */
+
+    NANDAddress pendingAddress;
+
+    uint32_t pendingStartCycles = 0U;
+
+    bool isPageOpen = false;    /*!< Page register holds openPageAddress (cleared by any command except 05h/E0h) */
+
+    NANDAddress openPageAddress;
+
 
     /* ============= Command Sequences ============= */
 
+    /**
+     * @brief Execute 80h-addr-data-10h PAGE PROGRAM with WP# deasserted and check the status.
+     *
+     * @param address NAND address to write to
+     * @param data Bytes sent from address.column on
+     * @param trailingData Bytes sent right after data (e.g. the spare area), may be empty
+     *
+     * @return Success (empty expected) or error code
+     * @retval NANDErrorCode::WRITE_PROTECTED WP# is asserted (status WP bit clear)
+     * @retval NANDErrorCode::DMA_FAILED DMA data phase failed
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     * @retval NANDErrorCode::PROGRAM_FAILED Status register indicates program failure
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> executeProgramCommandSequence(const NANDAddress& address,
+                                                                                   etl::span<const uint8_t> data,
+                                                                                   etl::span<const uint8_t> trailingData);
+
+    /**
+     * @brief Execute 80h-addr-data-[85h-col-data]-10h PAGE PROGRAM of several column ranges.
+     *
+     * @param address Page to write to (column is ignored)
+     * @param segments Validated, non-empty list of column ranges
+     *
+     * @see executeProgramCommandSequence(const NANDAddress&, etl::span<const uint8_t>, etl::span<const uint8_t>) for the errors
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> executeProgramCommandSequence(const NANDAddress& address,
+                                                                                   etl::span<const ProgramSegment> segments);
+
+    /**
+     * @brief Send a 2 cycle column change: 05h-col-E0h for CHANGE_READ_COLUMN, 85h-col for CHANGE_WRITE_COLUMN.
+     *
+     * @details Waits tCCS afterwards, before the data phase.
+     */
+    void sendColumnChange(Commands command, uint16_t column);
+
     /**
      * @brief Execute 00h-30h READ PAGE command sequence and wait for array transfer completion.
      *
@@ -665,6 +1732,35 @@ private:
      */
     [[nodiscard]] etl::expected<void, NANDErrorCode> executeReadCommandSequence(const NANDAddress& address);
 
+    /**
+     * @brief Issue the cache read command for the next page of a readPagesSequential() run and
+     *        wait until the cache register holds the current page.
+     *
+     * @param nextAddress Page to load into the data register, or nullptr for READ CACHE END (3Fh)
+     * @param isSequential true if nextAddress directly follows the page in the data register (31h),
+     *                     false to address it explicitly (00h-addr-31h)
+     *
+     * @return Success (empty expected) or error code
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> executeCacheReadCommand(const NANDAddress* nextAddress, bool isSequential);
+
+    /**
+     * @brief Select plane and column for data output with 06h-addr-E0h.
+     *
+     * @param address Page address (the block selects the plane) and column to continue reading from
+     */
+    void changeReadColumnEnhanced(const NANDAddress& address);
+
+    /**
+     * @brief Validate a two-plane block pair.
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Block or LUN exceeds device geometry
+     * @retval NANDErrorCode::PLANE_MISMATCH Both blocks in same plane
+     */
+    [[nodiscard]] static etl::expected<void, NANDErrorCode> validatePlanePair(uint16_t block0, uint16_t block1, uint8_t lun);
+
     
     /* ============= internal Helpers for Copyback Operations ============= */
     
@@ -793,6 +1889,82 @@ private:
      */
     [[nodiscard]] static etl::expected<void, NANDErrorCode> validateAddress(const NANDAddress& address);
 
+    /**
+     * @brief Decode one codeword of an ECC page, handling erased codewords.
+     *
+     * @param data Codeword data, corrected in place
+     * @param parity Codeword parity, corrected in place
+     * @param[in,out] status Accumulated page status
+     *
+     * @return Success (empty expected) or error code
+     * @retval NANDErrorCode::ECC_UNCORRECTABLE Too many bit errors
+     */
+    [[nodiscard]] static etl::expected<void, NANDErrorCode> decodeEccCodeword(etl::span<uint8_t> data,
+                                                                              etl::span<uint8_t, BCHCodec::ParityBytes> parity,
+                                                                              EccStatus& status);
+
+    /**
+     * @brief Run an ECC read, stepping through the read retry options while it is uncorrectable.
+     *
+     * @param block Block read by readAttempt, gives the first option to try
+     * @param readAttempt Callable performing one read, returning etl::expected<EccStatus, NANDErrorCode>
+     *
+     * @return Result of the first successful attempt, or of the last one
+     */
+    /**
+     * @brief One readPageEcc() attempt with the current read retry option.
+     */
+    [[nodiscard]] etl::expected<EccStatus, NANDErrorCode> readPageEccAttempt(const NANDAddress& address,
+                                                                              etl::span<uint8_t> data,
+                                                                              etl::span<uint8_t> metadata);
+
+    /**
+     * @brief One readPageMetadataEcc() attempt with the current read retry option.
+     */
+    [[nodiscard]] etl::expected<EccStatus, NANDErrorCode> readPageMetadataEccAttempt(const NANDAddress& address,
+                                                                                      etl::span<uint8_t> metadata);
+
+    template <typename ReadAttempt>
+    [[nodiscard]] etl::expected<EccStatus, NANDErrorCode> readWithRetry(uint16_t block, ReadAttempt readAttempt);
+
+    /**
+     * @brief Select a read retry option with SET FEATURES 89h.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> selectReadRetryOption(uint8_t option);
+
+    void storeReadRetryOption(uint16_t block, uint8_t option) {
+        constexpr uint8_t OptionBits = 4U;
+        constexpr uint8_t OptionMask = 0x0FU;
+
+        const uint8_t Shift = (block & 1U) * OptionBits;
+        uint8_t& packed = readRetryOptions[block / 2U];
+
+        packed = static_cast<uint8_t>((packed & ~(OptionMask << Shift)) | ((option & OptionMask) << Shift));
+    }
+
+    /**
+     * @brief Count the 0 bits of a buffer, 32 bits at a time.
+     *
+     * @param limit Counting stops as soon as the count exceeds it
+     *
+     * @return Number of 0 bits, or a value above limit
+     */
+    [[nodiscard]] static uint32_t countZeroBits(etl::span<const uint8_t> bytes, uint32_t limit = UINT32_MAX);
+
+    /**
+     * @brief Validate the parameters of a page program request.
+     *
+     * @param address NAND address to write to
+     * @param data Data to write
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::INVALID_PARAMETER data.size() exceeds (TotalBytesPerPage - address.column),
+     *                                          or invalid block marker value at column 8192
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Address validation failed
+     */
+    [[nodiscard]] static etl::expected<void, NANDErrorCode> validateProgramRequest(const NANDAddress& address,
+                                                                                   etl::span<const uint8_t> data);
+
     /**
      * @brief Read NAND status register.
      *
@@ -855,6 +2027,39 @@ private:
     [[nodiscard]] etl::expected<void, NANDErrorCode> verifyWriteEnabled();
 
 
+    /* ============= Data Phase ============= */
+
+    static constexpr size_t DmaMinimumTransferBytes = 64U;  /*!< Shorter transfers are not worth the DMA setup */
+
+    static constexpr uint32_t TimeoutDmaTransferUs = 5000U; /*!< Full page at timing mode 0 takes ~0.9ms */
+
+    NANDDmaEngine* dmaEngine = nullptr; /*!< Optional DMA engine for the data phase (nullptr = CPU) */
+
+    DataPhaseStatistics dataPhaseStatistics;
+
+    OperationStatistics operationStatistics;
+
+    /**
+     * @brief Read a block of data bytes, by DMA when possible.
+     *
+     * @param data Destination buffer
+     *
+     * @return Success or specific error code
+     * @retval NANDErrorCode::DMA_FAILED The DMA transfer failed or timed out
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readDataBlock(etl::span<uint8_t> data);
+
+    /**
+     * @brief Send a block of data bytes, by DMA when possible.
+     *
+     * @param data Source buffer
+     *
+     * @return Success or specific error code
+     * @retval NANDErrorCode::DMA_FAILED The DMA transfer failed or timed out
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> sendDataBlock(etl::span<const uint8_t> data);
+
+
     /* ============= Wait Policy ============= */
 
     static constexpr uint32_t BusyWaitThresholdUs = 1000U;   /*!< Threshold for switching from busy-wait to OS yield (1ms) */
@@ -863,21 +2068,127 @@ private:
 
     static constexpr uint32_t YieldIntervalMs = 1U;          /*!< Yield interval during hybrid wait (1ms) */
 
+    static constexpr uint32_t AdaptiveWakeMarginUs = 20U;    /*!< Tight polling starts this long before the expected completion */
+
+    static constexpr uint8_t BusyEstimateShift = 3U;         /*!< Weight 1/8 of a new busy time sample in the estimate */
+
+    etl::array<uint8_t, BlocksPerLun / 2U> readRetryOptions{};  /*!< Read retry option of each block, 4 bits per block */
+
+    etl::array<uint32_t, static_cast<size_t>(BusyOperation::OTHER)> busyTimeEstimates{};  /*!< Busy time of each learned BusyOperation, scaled by 2^BusyEstimateShift */
+
     YieldDelegate yieldMilliseconds; /*!< Delegate for yielding to OS during long operations */
 
+    static constexpr uint8_t MaxSpuriousWakeups = 2U;      /*!< Stale notifications tolerated per interrupt driven wait */
+
+    bool isReadyBusyInterruptEnabled = false;
+
+    NotificationWaitDelegate waitForNotification;    /*!< Blocks the task until the R/B# interrupt fires */
+
+    NotificationGiveDelegate notifyTaskFromIsr;      /*!< Wakes the task from the R/B# interrupt */
+
+    /**
+     * @brief Block on the R/B# rising edge interrupt until the device is ready.
+     *
+     * @param timeoutUs Timeout in microseconds, shared by every wakeup of the wait
+     *
+     * @return Success or specific error code
+     * @retval NANDErrorCode::TIMEOUT R/B# still LOW after the timeout
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> waitForReadyBusyInterrupt(uint32_t timeoutUs);
+
+    /**
+     * @brief PIO callback of the R/B# pin (interrupt context).
+     */
+    static void readyBusyCallback(PIO_PIN /* pin */, uintptr_t context);
+
     /**
      * @brief Wait for NAND device to become ready.
      *
-     * @details Uses hybrid busy-wait/yield approach:
+     * @details With enableReadyBusyInterrupt() the task blocks on the R/B# interrupt. Otherwise
+     *          uses an adaptive hybrid busy-wait/yield approach:
+     *          - For a learned operation, sleep (yield, then busy-wait) until AdaptiveWakeMarginUs before
+     *            the expected completion, without touching the bus
      *          - If timeout <= BusyWaitThresholdUs (1ms): pure busy-wait with 5µs polling
-     *          - If timeout > BusyWaitThresholdUs: busy-wait first 1ms, then yield 1ms intervals
+     *          - If timeout > BusyWaitThresholdUs: poll for 1ms more, then yield 1ms intervals
+     *
+     *          Every successful wait of a learned operation updates its busy time estimate, which
+     *          therefore follows the wear of the device. When the device is already ready at the first
+     *          look after sleeping, the sample is the planned wake-up time, so an estimate that is too
+     *          long shrinks by at least AdaptiveWakeMarginUs / 8 per operation.
      *
      * @param timeoutUs Timeout in microseconds
+     * @param readyStatusMask Status bits that must be set. Cache operations only wait for RDY
+     *                        (StatusReady), while the array (ARDY) may still be busy.
+     * @param operation Operation the device is busy with, to learn and use its busy time
      *
      * @return Success or specific error code
      * @retval NANDErrorCode::TIMEOUT Device not ready within timeout period
      */
-    [[nodiscard]] etl::expected<void, NANDErrorCode> waitForReady(uint32_t timeoutUs);
+    [[nodiscard]] etl::expected<void, NANDErrorCode> waitForReady(uint32_t timeoutUs,
+                                                                  uint8_t readyStatusMask = StatusReady | StatusArrayReady,
+                                                                  BusyOperation operation = BusyOperation::OTHER);
+
+    /**
+     * @brief Sleep through most of the learned busy time of an operation.
+     *
+     * @param startCycles Cycle count when the operation started
+     *
+     * @return Planned wake-up time in microseconds since startCycles, 0 if nothing is learned yet
+     */
+    uint32_t sleepForExpectedBusyTime(BusyOperation operation, uint32_t timeoutUs, uint32_t startCycles);
+
+    /**
+     * @brief One step of the ready poll: spin BusyWaitPollIntervalUs, or yield YieldIntervalMs.
+     *
+     * @param isSpinning Busy-wait instead of yielding
+     * @param[in,out] elapsedUs Time spent in the wait, advanced by the step
+     */
+    void waitPollInterval(bool isSpinning, uint32_t& elapsedUs);
+
+    /**
+     * @brief Fold the busy time of a completed operation into its estimate.
+     */
+    void recordBusyTime(BusyOperation operation, uint32_t busyUs);
+
+
+    /* ============= Timing Mode Negotiation ============= */
+
+    /**
+     * @brief Switch the device to the fastest supported timing mode and program the SMC to match.
+     *
+     * @details Picks the highest mode set in supportedTimingModes, sends it with SET FEATURES and
+     *          reads it back with GET FEATURES in the new mode. If the device does not report the
+     *          requested mode, it is set back to mode 0.
+     *
+     * @return Success or specific error code
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> negotiateTimingMode();
+
+    /**
+     * @brief Issue SET FEATURES (EFh) and wait for tFEAT.
+     *
+     * @return Success or specific error code
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> setFeatures(FeatureAddress feature, const FeatureParameters& parameters);
+
+    /**
+     * @brief Issue GET FEATURES (EEh) and read the four parameter bytes.
+     *
+     * @return Success or specific error code
+     * @retval NANDErrorCode::TIMEOUT Device not ready within timeout
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> getFeatures(FeatureAddress feature, FeatureParameters& parameters);
+
+    /**
+     * @brief Use a timing mode for the software delays and program it into the SMC chip select.
+     *
+     * @details The SMC registers are left untouched when a bus backend is in use.
+     *
+     * @param mode Timing mode (0 to ONFITiming::ModeCount - 1)
+     */
+    void applyTimingMode(uint8_t mode);
 
 
     /* ============= Timing Utilities ============= */
@@ -886,6 +2197,7 @@ private:
      * @brief Low-level cycle-accurate delay.
      * 
      * @details Implementation uses tight assembly loop executed from RAM.
+     *          Host (non-ARM) builds spin on the steady clock for the equivalent duration instead.
      * @param cycles Number of CPU cycles to delay
      */
     static void busyWaitCycles(uint32_t cycles);
@@ -923,6 +2235,36 @@ private:
         busyWaitCycles(Cycles);
     }
 
+    /**
+     * @brief Start the DWT cycle counter (no-op on the host).
+     */
+    static void enableCycleCounter();
+
+    /**
+     * @brief RAII probe recording the lifetime of a scope into a latency histogram.
+     *
+     * @details Constructed once the arguments are validated and the device is ready, so that
+     *          rejected calls do not add empty samples to the histogram.
+     */
+    class LatencyProbe {
+    public:
+        explicit LatencyProbe(LatencyHistogram& h) : histogram{h}, startCycles{readCycleCounter()} {}
+
+        ~LatencyProbe() {
+            histogram.record(getElapsedMicroseconds(startCycles));
+        }
+
+        LatencyProbe(const LatencyProbe&) = delete;
+        LatencyProbe& operator=(const LatencyProbe&) = delete;
+        LatencyProbe(LatencyProbe&&) = delete;
+        LatencyProbe& operator=(LatencyProbe&&) = delete;
+
+    private:
+        LatencyHistogram& histogram;
+
+        const uint32_t startCycles;
+    };
+
 
     /* ============= Hardware Configuration ============= */
 
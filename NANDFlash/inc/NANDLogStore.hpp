@@ -0,0 +1,472 @@
+#pragma once
+
+#include "NANDFlash.hpp"
+#include "LZCodec.hpp"
+#include "MR4A08BUYS45.hpp"
+#include <etl/array.h>
+#include <etl/delegate.h>
+#include <etl/expected.h>
+#include <etl/span.h>
+
+/**
+ * @brief Append-only log of timestamped records on a range of NAND blocks, queried by time range.
+ *
+ * @details The log owns the blocks firstBlock to firstBlock + index.size() - 1. Each block is one
+ *          segment, filled page by page with programPageEcc() and used in ring order: when every
+ *          segment holds data, the oldest one is erased and the log keeps the most recent data.
+ *
+ *          Records are packed back to back into the page data. A record that does not fit in the rest
+ *          of a page goes on at the start of the next page of the log, in the next segment if needed:
+ *
+ *            0 - 1    stored length (little endian, 1 to MaxPayloadBytes), CompressedFlag set when the
+ *                     stored bytes are the payload compressed into an LZ4 block
+ *            2 - 5    timestamp (little endian)
+ *            6 -      stored bytes
+ *
+ *          The page metadata (spare area, ECC protected) is the page header:
+ *
+ *            0 - 3    magic "TLOG"
+ *            4 - 7    sequence number of the segment (little endian)
+ *            8 - 11   timestamp of the first record (little endian)
+ *            12 - 15  timestamp of the last record (little endian)
+ *            16 - 17  bytes of page data used by records (little endian)
+ *            18 - 19  count of the records starting in the page (little endian)
+ *            20 - 21  bytes at the start of the page data ending the record split off the previous page
+ *                     (little endian)
+ *
+ *          The first and last timestamps are those of the first and last record with bytes in the page.
+ *
+ *          Timestamps are in any caller unit and must not decrease from one record to the next. The
+ *          sparse time index holds, in RAM, the sequence number and first timestamp of each segment. A
+ *          query picks the segment from the index without touching the NAND, then binary searches its
+ *          page headers with readPageMetadataEcc() (at most 7 metadata reads) and streams records from
+ *          the first page that may hold the start time. A split record is joined in RAM before it goes
+ *          to the sink; one with an unreadable part is skipped.
+ *
+ *          Records are collected in a RAM page and programmed once it is full, or on flush(). Queries
+ *          also return the records not programmed yet. A page programmed by flush() is closed, so
+ *          frequent flushes waste the rest of their pages. With the MRAM mirror attached, flush()
+ *          instead saves the new bytes of the RAM page to MRAM, and mount() restores them: flushes
+ *          then cost no NAND space, but the log must always be mounted with its mirror.
+ *
+ *          append() may compress a record with LZCodec. The record is kept compressed only when that
+ *          makes it smaller, whatever room is left in the page, and queries hand the decompressed
+ *          payload to the sink. The statistics give the compression ratio (payloadBytes / storedBytes) and the effective
+ *          append throughput (payloadBytes / busyUs).
+ *
+ *          mount() rebuilds the index from the page 0 header of every segment, one metadata read per
+ *          block. With an MRAM mirror attached (attachIndexMirror()), every index change is also written
+ *          to MRAM and mount() reads the index from there; entries torn by a reset fall back to the
+ *          metadata read of their segment only.
+ *
+ * @note The index is caller provided, one IndexEntry per segment. Besides it the log takes four page
+ *       buffers and the LZCodec hash table (about 40 KiB) of RAM.
+ *
+ * @note Thread Safety: Requires external synchronization, like MT29F. The log must be the only user of
+ *       its blocks.
+ */
+class NANDLogStore {
+public:
+    static constexpr uint8_t RecordHeaderBytes = 6U;
+
+    static constexpr uint16_t MaxPayloadBytes = MT29F::DataBytesPerPage - RecordHeaderBytes;
+
+    static constexpr uint16_t CompressedFlag = 0x8000U;   /*!< Stored length flag of a compressed record */
+
+    static constexpr uint8_t PageHeaderBytes = 22U;
+
+    static constexpr uint32_t EmptySequence = UINT32_MAX;   /*!< Sequence of an index entry without a segment */
+
+    static constexpr uint8_t MirrorHeaderBytes = 16U;
+
+    static constexpr uint8_t MirrorEntryBytes = 10U;
+
+    static constexpr uint8_t StagedHeaderBytes = PageHeaderBytes + 4U;   /*!< Header of the RAM page saved by flush() */
+
+    /**
+     * @brief Index entry of one segment.
+     */
+    struct IndexEntry {
+        uint32_t sequence = EmptySequence;   /*!< Segments are written in increasing sequence order */
+        uint32_t firstTimestamp = 0U;        /*!< Timestamp of the first record of the segment */
+    };
+
+    /**
+     * @brief Type alias for the delegate receiving the records of a query.
+     *
+     * @details The payload is only valid during the call. Return false to end the query.
+     */
+    using RecordSink = etl::delegate<bool(uint32_t timestamp, etl::span<const uint8_t> payload)>;
+
+    struct Statistics {
+        uint32_t appendedRecords = 0U;
+        uint32_t programmedPages = 0U;
+        uint32_t flushedPages = 0U;       /*!< Pages programmed partially full by flush() */
+        uint32_t stagedFlushes = 0U;      /*!< flush() calls saving the RAM page to the MRAM mirror instead */
+        uint32_t erasedSegments = 0U;
+        uint32_t droppedSegments = 0U;    /*!< Segments holding data erased to make room */
+        uint32_t failedPrograms = 0U;     /*!< Pages moved to the next segment after a program failure */
+        uint32_t skippedPages = 0U;       /*!< Uncorrectable pages skipped by queries */
+        uint32_t skippedRecords = 0U;     /*!< Records skipped by queries: split with a part lost, or not decoding */
+        uint32_t headerReads = 0U;        /*!< Page headers read by mount() and the query seeks */
+        uint32_t compressedRecords = 0U;  /*!< Records stored compressed, the others did not shrink */
+        uint64_t payloadBytes = 0U;       /*!< Bytes given to append() */
+        uint64_t storedBytes = 0U;        /*!< Record bytes put into pages, headers included */
+        uint64_t compressUs = 0U;         /*!< Time spent compressing */
+        uint64_t busyUs = 0U;             /*!< Time spent in append() and flush(), compression and programs included */
+    };
+
+    /**
+     * @param nand Initialized driver (must outlive the log)
+     * @param firstBlock First block of the log
+     * @param index One entry per segment, its size sets the number of blocks of the log (at least 2)
+     */
+    NANDLogStore(MT29F& nand, uint16_t firstBlock, etl::span<IndexEntry> index)
+        : nand{nand}
+        , firstBlock{firstBlock}
+        , index{index} {}
+
+    NANDLogStore(const NANDLogStore&) = delete;
+    NANDLogStore& operator=(const NANDLogStore&) = delete;
+    NANDLogStore(NANDLogStore&&) = delete;
+    NANDLogStore& operator=(NANDLogStore&&) = delete;
+
+    ~NANDLogStore() = default;
+
+    /**
+     * @brief Mirror the index into an MRAM region, before format() or mount().
+     *
+     * @details The region also receives the RAM page on flush().
+     *
+     * @param mram MRAM driver (must outlive the log), nullptr to detach
+     * @param baseAddress First MRAM address of the region, getRequiredMirrorBytes() long
+     */
+    void attachIndexMirror(MRAM* mram, uint32_t baseAddress) {
+        this->mram = mram;
+        mirrorAddress = baseAddress;
+    }
+
+    /**
+     * @brief Erase every block of the log and start an empty log.
+     *
+     * @details Blocks failing to erase are marked bad.
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::ALREADY_INITIALIZED Log already mounted
+     * @retval NANDErrorCode::INVALID_PARAMETER Fewer than 2 segments, or blocks beyond the usable ones
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access of the mirror failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> format();
+
+    /**
+     * @brief Load the index and find the end of the log.
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::ALREADY_INITIALIZED Log already mounted
+     * @retval NANDErrorCode::INVALID_PARAMETER Fewer than 2 segments, or blocks beyond the usable ones
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access of the mirror failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> mount();
+
+    /**
+     * @brief Append one record.
+     *
+     * @details Programs the RAM page once the record fills it, the rest of the record going on in the
+     *          next page.
+     *
+     * @param timestamp Not older than the timestamp of the previous record
+     * @param payload 1 to MaxPayloadBytes bytes
+     * @param isCompressing Store the payload LZ4 compressed if that makes it smaller
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Log not mounted
+     * @retval NANDErrorCode::INVALID_PARAMETER Payload size or timestamp out of order
+     * @retval NANDErrorCode::NO_SPACE No block of the log can be erased anymore
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> append(uint32_t timestamp, etl::span<const uint8_t> payload,
+                                                            bool isCompressing = false);
+
+    /**
+     * @brief Make the records collected in RAM survive a reset.
+     *
+     * @details Saves them to the MRAM mirror if attached, else programs the RAM page.
+     *
+     * @return Success (empty expected) or specific error code, as append()
+     * @retval NANDErrorCode::JOURNAL_IO_FAILED MRAM access of the mirror failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> flush();
+
+    /**
+     * @brief Stream the records with a timestamp in [startTime, endTime], oldest first.
+     *
+     * @param sink Called for every record, in log order
+     *
+     * @return Success (empty expected), also when the sink ended the query, or specific error code
+     * @retval NANDErrorCode::NOT_INITIALIZED Log not mounted
+     * @retval NANDErrorCode::INVALID_PARAMETER startTime after endTime
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readRange(uint32_t startTime, uint32_t endTime, RecordSink sink);
+
+    [[nodiscard]] uint16_t getSegmentCount() const {
+        return static_cast<uint16_t>(index.size());
+    }
+
+    [[nodiscard]] const Statistics& getStatistics() const {
+        return statistics;
+    }
+
+    void resetStatistics() {
+        statistics = Statistics{};
+    }
+
+    /**
+     * @brief MRAM bytes of the index mirror of a log of segmentCount segments.
+     */
+    [[nodiscard]] static constexpr uint32_t getRequiredMirrorBytes(uint16_t segmentCount) {
+        return getStagedHeaderOffset(segmentCount) + (2U * StagedHeaderBytes) + MT29F::DataBytesPerPage;
+    }
+
+private:
+    static constexpr uint16_t NoSegment = 0xFFFFU;
+
+    static constexpr uint16_t PagesPerSegment = MT29F::PagesPerBlock;
+
+    static constexpr etl::array<uint8_t, 4> PageMagic = { 'T', 'L', 'O', 'G' };
+
+    static constexpr etl::array<uint8_t, 4> MirrorMagic = { 'T', 'L', 'G', 'I' };
+
+    static constexpr uint8_t MirrorTransferEntries = 32U;   /*!< Entries moved per MRAM access at mount */
+
+    static constexpr uint8_t NoStagedSlot = 0xFFU;
+
+    /**
+     * @brief Decoded page header.
+     */
+    struct PageHeader {
+        uint32_t sequence = 0U;
+        uint32_t firstTimestamp = 0U;
+        uint32_t lastTimestamp = 0U;
+        uint16_t usedBytes = 0U;
+        uint16_t recordCount = 0U;
+        uint16_t continuedBytes = 0U;
+    };
+
+    using PageHeaderBytesArray = etl::array<uint8_t, PageHeaderBytes>;
+
+    MT29F& nand;
+
+    const uint16_t firstBlock;
+
+    etl::span<IndexEntry> index;
+
+    MRAM* mram = nullptr;
+
+    uint32_t mirrorAddress = 0U;
+
+    bool mounted = false;
+
+    uint16_t writeSegment = NoSegment;    /*!< Segment receiving pages, NoSegment until the next one is opened */
+
+    uint16_t lastSegment = NoSegment;     /*!< Most recently opened segment */
+
+    uint8_t writePage = 0U;               /*!< Next page of writeSegment */
+
+    uint32_t nextSequence = 0U;
+
+    bool hasRecords = false;
+
+    uint32_t lastTimestamp = 0U;
+
+    etl::array<uint8_t, MT29F::DataBytesPerPage> writeBuffer{};   /*!< Records not programmed yet */
+
+    uint16_t bufferedBytes = 0U;
+
+    uint16_t bufferedRecords = 0U;
+
+    uint16_t bufferedContinuedBytes = 0U;   /*!< Bytes ending the record split off the last programmed page */
+
+    uint32_t bufferFirstTimestamp = 0U;
+
+    uint32_t bufferLastTimestamp = 0U;
+
+    uint16_t stagedBytes = 0U;            /*!< Bytes of the RAM page already saved to MRAM by flush() */
+
+    uint8_t stagedGeneration = 0U;        /*!< Generation of the newest staged header, which is in slot generation % 2 */
+
+    /**
+     * @brief Page read by a query in the upper half, the head of a record split off the previous page
+     *        right below it, so that the record is contiguous.
+     */
+    etl::array<uint8_t, 2U * MT29F::DataBytesPerPage> readBuffer{};
+
+    uint16_t pendingBytes = 0U;           /*!< Bytes of the split record below the page in readBuffer */
+
+    etl::array<uint8_t, MaxPayloadBytes> payloadBuffer{};   /*!< Decompressed payload handed to the query sink */
+
+    LZCodec codec;
+
+    Statistics statistics;
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> validateGeometry() const;
+
+    [[nodiscard]] uint16_t toBlock(uint16_t segment) const {
+        return firstBlock + segment;
+    }
+
+    [[nodiscard]] MT29F::NANDAddress toAddress(uint16_t segment, uint8_t page) const {
+        return MT29F::NANDAddress { 0U, toBlock(segment), page, 0U };
+    }
+
+    /**
+     * @return Pages of a segment holding records
+     */
+    [[nodiscard]] uint8_t getWrittenPages(uint16_t segment) const {
+        return (segment == writeSegment) ? writePage : PagesPerSegment;
+    }
+
+    /* ----- Write Path ----- */
+
+    /**
+     * @brief Copy the bytes of a record, header and stored bytes, from offset on into destination.
+     */
+    static void copyRecordBytes(etl::span<const uint8_t> header, etl::span<const uint8_t> stored, size_t offset,
+                                etl::span<uint8_t> destination);
+
+    /**
+     * @brief Program the RAM page into the next page of the log, opening a segment if needed.
+     *
+     * @param header Header of the page, the sequence is filled in here
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> programBufferedPage(PageHeader header);
+
+    /**
+     * @brief Save the bytes of the RAM page not saved yet, then its header, to the MRAM mirror.
+     *
+     * @details Opens the segment receiving the page first, so the header names its final place. The
+     *          two header slots alternate, so a reset while writing one leaves the previous one valid.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> stageBufferedPage();
+
+    /**
+     * @brief Load the RAM page saved by flush(), if it belongs at the end of the log.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> restoreStagedPage();
+
+    [[nodiscard]] PageHeader getBufferedPageHeader() const;
+
+    /**
+     * @brief Erase the next good block of the ring (dropping its segment) and make it writeSegment.
+     *
+     * @retval NANDErrorCode::NO_SPACE Every block of the log failed
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> openSegment(uint32_t firstTimestamp);
+
+    /**
+     * @brief Set an index entry and its mirror.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> setIndexEntry(uint16_t segment, const IndexEntry& entry);
+
+    void resetWriteBuffer();
+
+    /* ----- Index ----- */
+
+    /**
+     * @brief Index entry of a segment from its page 0 header.
+     */
+    [[nodiscard]] etl::expected<IndexEntry, NANDErrorCode> scanSegment(uint16_t segment);
+
+    /**
+     * @brief Load the index from the MRAM mirror, scanning the segments of torn entries.
+     *
+     * @retval NANDErrorCode::JOURNAL_INVALID No mirror header for this geometry
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> loadMirror();
+
+    /**
+     * @brief Write the mirror header and every entry.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> writeMirror();
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> writeMirrorEntry(uint16_t segment);
+
+    static void encodeMirrorEntry(const IndexEntry& entry, etl::span<uint8_t> bytes);
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> writeMirrorBytes(uint32_t offset, etl::span<const uint8_t> bytes);
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readMirrorBytes(uint32_t offset, etl::span<uint8_t> bytes);
+
+    /**
+     * @return Offset of the staged page headers in the mirror, the staged page data follows them
+     */
+    [[nodiscard]] static constexpr uint32_t getStagedHeaderOffset(uint16_t segmentCount) {
+        return MirrorHeaderBytes + (static_cast<uint32_t>(segmentCount) * MirrorEntryBytes);
+    }
+
+    /**
+     * @brief Find the end of the newest segment and the state of the write path.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> locateEnd();
+
+    /* ----- Query ----- */
+
+    /**
+     * @return Last segment whose first record is older than startTime, else the oldest segment, or NoSegment
+     */
+    [[nodiscard]] uint16_t seekSegment(uint32_t startTime) const;
+
+    /**
+     * @return Segment written after segment, or NoSegment
+     */
+    [[nodiscard]] uint16_t getNextSegment(uint16_t segment) const;
+
+    /**
+     * @return First page of the segment whose last record is not older than startTime
+     */
+    [[nodiscard]] etl::expected<uint8_t, NANDErrorCode> seekPage(uint16_t segment, uint32_t startTime);
+
+    /**
+     * @brief Read the header of a page.
+     *
+     * @return The header, or an error; INVALID_PARAMETER for an erased page or one not written by the log
+     */
+    [[nodiscard]] etl::expected<PageHeader, NANDErrorCode> readPageHeader(uint16_t segment, uint8_t page);
+
+    /**
+     * @brief Pass the records of the page in readBuffer in [startTime, endTime] to the sink, decompressed.
+     *
+     * @details Joins the record split off the previous page first, and keeps the head of a record split
+     *          off this page below it for the next call.
+     *
+     * @return false once the query is over (record after endTime, or the sink declined)
+     */
+    [[nodiscard]] bool deliverPage(const PageHeader& header, uint32_t startTime, uint32_t endTime, RecordSink& sink);
+
+    /**
+     * @brief Pass one complete record to the sink if in [startTime, endTime], decompressed.
+     *
+     * @return false once the query is over
+     */
+    [[nodiscard]] bool deliverRecord(etl::span<const uint8_t> record, uint32_t startTime, uint32_t endTime,
+                                     RecordSink& sink);
+
+    /**
+     * @return Bytes of the record starting at the first of bytes, header included (at least its length field)
+     */
+    [[nodiscard]] static size_t getRecordBytes(etl::span<const uint8_t> bytes);
+
+    /**
+     * @brief Forget the head of a split record whose next page could not be read.
+     */
+    void dropPendingRecord();
+
+    [[nodiscard]] etl::span<uint8_t> getReadPage() {
+        return etl::span<uint8_t>(readBuffer).subspan(MT29F::DataBytesPerPage);
+    }
+
+    [[nodiscard]] static PageHeaderBytesArray encodePageHeader(const PageHeader& header);
+
+    /**
+     * @return false if the bytes are not a page header of the log
+     */
+    [[nodiscard]] static bool decodePageHeader(etl::span<const uint8_t> bytes, PageHeader& header);
+};
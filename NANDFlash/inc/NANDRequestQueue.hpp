@@ -0,0 +1,241 @@
+#pragma once
+
+#include "NANDFlash.hpp"
+#include "TaskNotification.hpp"
+#include <etl/array.h>
+#include <etl/delegate.h>
+#include <etl/expected.h>
+#include <etl/span.h>
+
+/**
+ * @brief Prioritized request queue in front of an MT29F, owned by a single worker task.
+ *
+ * @details Any task submits read, program and erase requests with submit(); the worker task, which
+ *          alone touches the MT29F, runs them through serviceRequests(). The next request is the
+ *          pending one of highest priority (first submitted first within a priority), so an urgent read
+ *          overtakes the bulk writes queued before it instead of waiting on a coarse driver mutex. An
+ *          operation already started on the device is not preempted: an urgent read waits at most for
+ *          one page program or block erase.
+ *
+ *          Priority never reorders requests on the same data: a request waits for every older pending
+ *          request of another kind on its page, and for every older one on its block when either is an
+ *          erase, whatever their priority. So an urgent read queued after a bulk program of its page
+ *          returns the programmed data, and an urgent erase does not overtake a program of its block.
+ *
+ *          Before a read of a page from column 0 runs, the pending reads of the following pages (any
+ *          priority, also from column 0, under the same rule) are coalesced with it into one READ CACHE
+ *          sequence (readPagesSequential()), up to MaxCoalescedReads pages.
+ *
+ *          Completion callbacks run in the worker task, in completion order, with no lock held. They
+ *          may submit new requests.
+ *
+ *          Only the slot table is shared between tasks. It is guarded by the enter/exit critical
+ *          section delegates, held for a few hundred cycles at most (capacity is small and every scan
+ *          is O(Capacity)).
+ *
+ * @note While a queue owns an MT29F, every other access to it (NANDFTL included) must run in the
+ *       worker task, e.g. from a completion callback or between two serviceRequests() calls.
+ */
+class NANDRequestQueue {
+public:
+    static constexpr uint8_t Capacity = 16U;
+
+    static constexpr uint8_t MaxCoalescedReads = 8U;
+
+    using NANDAddress = MT29F::NANDAddress;
+
+    /**
+     * @brief Type alias for the delegates entering and leaving the critical section guarding the queue.
+     *
+     * @note For FreeRTOS bind to wrappers calling taskENTER_CRITICAL() and taskEXIT_CRITICAL().
+     */
+    using CriticalSectionDelegate = etl::delegate<void()>;
+
+    /**
+     * @brief Type alias for the delegate waking the worker task after a submission.
+     *
+     * @details Called from task context.
+     *
+     * @note For FreeRTOS bind to wrapper calling xTaskNotifyGive() for the worker task, which waits
+     *       with the NotificationWaitDelegate given to serviceRequests().
+     */
+    using WakeDelegate = etl::delegate<void()>;
+
+    enum class Priority : uint8_t {
+        URGENT = 0U,    /*!< Housekeeping and time critical reads */
+        NORMAL,
+        BULK,           /*!< Payload data, may wait behind everything else */
+    };
+
+    enum class Operation : uint8_t {
+        READ,
+        PROGRAM,
+        ERASE,
+    };
+
+    struct Request;
+
+    /**
+     * @brief Type alias for the delegate told the outcome of a request.
+     *
+     * @details Called once per accepted request from the worker task. The request is a copy; its
+     *          buffers are not used by the queue anymore.
+     */
+    using CompletionCallback = etl::delegate<void(const Request&, etl::expected<void, NANDErrorCode>)>;
+
+    struct Request {
+        Operation operation = Operation::READ;
+        Priority priority = Priority::NORMAL;
+        NANDAddress address{};                /*!< Page and column, or block and LUN for ERASE */
+        etl::span<uint8_t> readData;          /*!< READ destination, must stay valid until completion */
+        etl::span<const uint8_t> programData; /*!< PROGRAM source, must stay valid until completion */
+        CompletionCallback onComplete;        /*!< Optional */
+    };
+
+    struct Statistics {
+        uint32_t submitted = 0U;
+        uint32_t rejected = 0U;          /*!< Submissions refused because the queue was full */
+        uint32_t completed = 0U;
+        uint32_t failed = 0U;            /*!< Completed requests that returned an error */
+        uint32_t coalescedReads = 0U;    /*!< Reads served by the READ CACHE sequence of another read */
+        uint8_t maxDepth = 0U;           /*!< Most requests pending at once */
+    };
+
+    /**
+     * @param nand Driver the queue owns (must outlive the queue)
+     * @param enterCritical Delegate entering the critical section guarding the queue
+     * @param exitCritical Delegate leaving it
+     * @param wakeWorker Delegate waking the worker task, optional if the worker polls
+     */
+    NANDRequestQueue(MT29F& nand, CriticalSectionDelegate enterCritical, CriticalSectionDelegate exitCritical,
+                     WakeDelegate wakeWorker)
+        : nand{nand}
+        , enterCritical{enterCritical}
+        , exitCritical{exitCritical}
+        , wakeWorker{wakeWorker} {}
+
+    NANDRequestQueue(const NANDRequestQueue&) = delete;
+    NANDRequestQueue& operator=(const NANDRequestQueue&) = delete;
+    NANDRequestQueue(NANDRequestQueue&&) = delete;
+    NANDRequestQueue& operator=(NANDRequestQueue&&) = delete;
+
+    ~NANDRequestQueue() = default;
+
+    /**
+     * @brief Queue a request and wake the worker task.
+     *
+     * @return Success (empty expected) or specific error code
+     * @retval NANDErrorCode::INVALID_PARAMETER Missing buffer for the operation
+     * @retval NANDErrorCode::QUEUE_FULL Capacity requests already pending
+     *
+     * @note Thread Safety: Callable from any task, not from interrupt context.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> submit(const Request& request);
+
+    /**
+     * @brief Run pending requests until the queue is empty, then wait for a submission.
+     *
+     * @details Meant to be called in a loop by the worker task.
+     *
+     * @param waitNotification Delegate blocking until wakeWorker is called, may be invalid to return at once
+     * @param idleTimeoutUs Longest wait when the queue is empty
+     *
+     * @return Number of requests completed
+     *
+     * @note Thread Safety: Only the worker task may call this.
+     */
+    uint32_t serviceRequests(NotificationWaitDelegate waitNotification, uint32_t idleTimeoutUs);
+
+    /**
+     * @brief Run the pending request of highest priority, with the reads coalesced into it.
+     *
+     * @return Number of requests completed, 0 if none was pending
+     *
+     * @note Thread Safety: Only the worker task may call this.
+     */
+    uint32_t serviceNext();
+
+    [[nodiscard]] uint8_t getPendingCount() const {
+        return pendingCount;
+    }
+
+    [[nodiscard]] const Statistics& getStatistics() const {
+        return statistics;
+    }
+
+private:
+    static constexpr uint8_t NoSlot = 0xFFU;
+
+    struct Slot {
+        Request request;
+        uint32_t order = 0U;    /*!< Submission number, FIFO order within a priority */
+        bool isPending = false;
+    };
+
+    MT29F& nand;
+
+    CriticalSectionDelegate enterCritical;
+
+    CriticalSectionDelegate exitCritical;
+
+    WakeDelegate wakeWorker;
+
+    etl::array<Slot, Capacity> slots{};
+
+    uint8_t pendingCount = 0U;
+
+    uint32_t nextOrder = 0U;
+
+    Statistics statistics;
+
+    void lock() {
+        if (enterCritical.is_valid()) {
+            enterCritical();
+        }
+    }
+
+    void unlock() {
+        if (exitCritical.is_valid()) {
+            exitCritical();
+        }
+    }
+
+    /**
+     * @brief Take the request of highest priority not waiting on an older one, and the reads of the
+     *        pages following it.
+     *
+     * @param[out] batch Taken requests, in page order for a read batch
+     *
+     * @return Number of requests taken
+     */
+    uint8_t takeNext(etl::array<Request, MaxCoalescedReads>& batch);
+
+    /**
+     * @return Pending slot holding a read of the page following address from column 0, or NoSlot
+     *
+     * @details A read waiting on an older request (see dependsOnOlder()) is left pending, so it still
+     *          sees its result.
+     */
+    [[nodiscard]] uint8_t findFollowingRead(const NANDAddress& address) const;
+
+    /**
+     * @return true if slot has to wait for an older pending request: one on the same page unless both
+     *         are reads, or one on the same block when either is an erase
+     *
+     * @details The oldest pending request never waits, so takeNext() always finds one to run.
+     */
+    [[nodiscard]] bool dependsOnOlder(uint8_t slot) const;
+
+    /**
+     * @return true if slot was submitted before other
+     */
+    [[nodiscard]] bool isOlder(uint8_t slot, uint8_t other) const {
+        return (slots[slot].order - slots[other].order) > (UINT32_MAX / 2U);
+    }
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> execute(const Request& request);
+
+    [[nodiscard]] etl::expected<void, NANDErrorCode> executeReads(etl::span<const Request> reads);
+
+    void complete(const Request& request, etl::expected<void, NANDErrorCode> result);
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "NANDFlash.hpp"
+#include <etl/array.h>
+#include <etl/expected.h>
+#include <etl/span.h>
+
+/**
+ * @brief Several MT29F on different chip selects exposed as one device with wider blocks.
+ *
+ * @details Volume block b is made of block b of every chip. Its pages are striped round-robin over the
+ *          chips: volume page p lives on chip p % chipCount, page p / chipCount. A volume block therefore
+ *          holds chipCount * MT29F::PagesPerBlock pages, and a run of consecutive pages touches every chip
+ *          in turn.
+ *
+ *          Multi-page operations use the split-phase driver calls: the program of one page is sent to
+ *          its chip, and while that array is busy (tPROG) the next page is transferred to the next chip.
+ *          A chip is only waited for when it is needed again, so with n chips up to n array operations
+ *          overlap and the volume bandwidth approaches n times that of one chip, until the shared bus
+ *          saturates. Reads start the array read of every chip of the run first, then collect the pages
+ *          in order. Erases start on every chip before waiting for any.
+ *
+ *          A volume block is bad when the block is bad on any chip. Marking a volume block bad marks it
+ *          on every chip.
+ *
+ * @note Raw page access only, without ECC. Thread Safety: the volume drives all its chips, the caller
+ *       must hold one external mutex for the volume.
+ */
+class NANDStripedVolume {
+public:
+    static constexpr uint8_t MaxChips = 4U;    /*!< One per SMC chip select, NCS0 to NCS3 */
+
+    static constexpr uint16_t BlockCount = MT29F::UsableBlocksPerLun;
+
+    /**
+     * @param chips Initialized drivers, one per chip select (must outlive the volume). Only the first
+     *              MaxChips are used.
+     */
+    explicit NANDStripedVolume(etl::span<MT29F* const> chips) : chipCount{0U} {
+        for (MT29F* chip : chips) {
+            if ((chip != nullptr) and (chipCount < MaxChips)) {
+                this->chips[chipCount] = chip;
+                chipCount++;
+            }
+        }
+    }
+
+    NANDStripedVolume(const NANDStripedVolume&) = delete;
+    NANDStripedVolume& operator=(const NANDStripedVolume&) = delete;
+    NANDStripedVolume(NANDStripedVolume&&) = delete;
+    NANDStripedVolume& operator=(NANDStripedVolume&&) = delete;
+
+    ~NANDStripedVolume() = default;
+
+
+    /* ================== Geometry ================== */
+
+    [[nodiscard]] uint8_t getChipCount() const {
+        return chipCount;
+    }
+
+    [[nodiscard]] uint32_t getPagesPerBlock() const {
+        return static_cast<uint32_t>(chipCount) * MT29F::PagesPerBlock;
+    }
+
+    [[nodiscard]] static constexpr uint16_t getBlockCount() {
+        return BlockCount;
+    }
+
+    [[nodiscard]] uint64_t getCapacityBytes() const {
+        return static_cast<uint64_t>(BlockCount) * getPagesPerBlock() * MT29F::DataBytesPerPage;
+    }
+
+
+    /* ================== Data Operations ================== */
+
+    /**
+     * @brief Read consecutive pages of a volume block, overlapping the array reads of the chips.
+     *
+     * @param block Volume block
+     * @param firstPage First volume page inside the block
+     * @param pageCount Number of pages
+     * @param[out] data pageCount pages of data.size() / pageCount bytes each, from column 0
+     *
+     * @return Success (empty expected) or the first error of any chip
+     * @retval NANDErrorCode::INVALID_PARAMETER No chip, or data does not split into pages of at most TotalBytesPerPage
+     * @retval NANDErrorCode::ADDRESS_OUT_OF_BOUNDS Block or page range outside the volume
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> readPages(uint16_t block, uint32_t firstPage, uint32_t pageCount,
+                                                               etl::span<uint8_t> data);
+
+    /**
+     * @brief Program consecutive pages of a volume block, overlapping tPROG of one chip with the data
+     *        transfer to the next.
+     *
+     * @param data pageCount pages of data.size() / pageCount bytes each, from column 0
+     *
+     * @return Success (empty expected) or the first error of any chip
+     * @retval NANDErrorCode::PROGRAM_FAILED A page failed; the other pages were still completed
+     *
+     * @see readPages() for the other parameters and errors
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> programPages(uint16_t block, uint32_t firstPage, uint32_t pageCount,
+                                                                  etl::span<const uint8_t> data);
+
+    /**
+     * @brief Erase a volume block on every chip at once.
+     *
+     * @return Success (empty expected) or the first error of any chip
+     * @retval NANDErrorCode::ERASE_FAILED The block failed on at least one chip
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> eraseBlock(uint16_t block);
+
+
+    /* ================== Bad Block Management ================== */
+
+    /**
+     * @return true if the block is bad on any chip, or specific error code
+     */
+    [[nodiscard]] etl::expected<bool, NANDErrorCode> isBlockBad(uint16_t block) const;
+
+    /**
+     * @brief Mark a volume block bad on every chip.
+     */
+    [[nodiscard]] etl::expected<void, NANDErrorCode> markBadBlock(uint16_t block);
+
+private:
+    etl::array<MT29F*, MaxChips> chips{};
+
+    uint8_t chipCount;
+
+    /**
+     * @brief Driver address of a volume page.
+     */
+    [[nodiscard]] MT29F::NANDAddress toChipAddress(uint16_t block, uint32_t page) const {
+        return MT29F::NANDAddress { 0U, block, page / chipCount, 0U };
+    }
+
+    [[nodiscard]] etl::expected<size_t, NANDErrorCode> validateRange(uint16_t block, uint32_t firstPage,
+                                                                     uint32_t pageCount, size_t dataSize) const;
+
+    /**
+     * @brief Complete the pending operation of every chip.
+     *
+     * @return The first error, or previousResult if it already holds one
+     */
+    etl::expected<void, NANDErrorCode> completeAll(etl::expected<void, NANDErrorCode> previousResult);
+};
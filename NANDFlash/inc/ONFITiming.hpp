@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <etl/array.h>
+#include <etl/algorithm.h>
+
+/**
+ * @brief ONFI asynchronous timing modes and their translation into ATSAMV71 SMC cycle counts.
+ *
+ * @details A device advertises the timing modes it supports in the parameter page (bytes 129-130)
+ *          and switches to one with SET FEATURES (EFh) on feature address 01h. RESET returns it to
+ *          mode 0. The same table drives both the SMC signal timings (NWE/NRD waveforms of the data,
+ *          command and address cycles) and the software delays between cycles (tWHR, tADL, ...).
+ *
+ *          SMC mapping (NCS asserted for the whole cycle, NRD/NWE controlled, 8-bit bus):
+ *          - NWE setup covers the CLE/ALE/CE# setup time that is not already covered by tWP
+ *          - NWE cycle covers tWC and the CLE/ALE/CE# hold time / tWH after the rising edge
+ *          - NRD is sampled on its rising edge, so its pulse must also cover tREA plus the EBI data setup
+ *          - Data float time (TDF) covers tRHZ, clamped to the 15 cycles the register can hold
+ *
+ * @see https://onfi.org/files/onfi_2_0_gold.pdf "Timing Parameters"
+ * @see http://ww1.microchip.com/downloads/en/DeviceDoc/NAND-Flash-Interface-with-EBI-on-Cortex-M-Based-MCUs-DS90003184A.pdf
+ */
+class ONFITiming {
+public:
+    /**
+     * @brief Timing parameters of one mode in nanoseconds (minimums unless noted).
+     */
+    struct Mode {
+        uint8_t mode;
+        uint16_t rcNs;            /*!< tRC: read cycle time */
+        uint16_t rpNs;            /*!< tRP: RE# pulse width */
+        uint16_t rehNs;           /*!< tREH: RE# HIGH hold time */
+        uint16_t reaNs;           /*!< tREA: RE# access time (maximum) */
+        uint16_t wcNs;            /*!< tWC: write cycle time */
+        uint16_t wpNs;            /*!< tWP: WE# pulse width */
+        uint16_t whNs;            /*!< tWH: WE# HIGH hold time */
+        uint16_t latchSetupNs;    /*!< max(tCLS, tALS, tCS): CLE/ALE/CE# setup to WE# rising edge */
+        uint16_t latchHoldNs;     /*!< max(tCLH, tALH, tCH): CLE/ALE/CE# hold after WE# rising edge */
+        uint16_t whrNs;           /*!< tWHR: WE# HIGH to RE# LOW (command to read) */
+        uint16_t adlNs;           /*!< tADL: ALE LOW to data input valid */
+        uint16_t rhwNs;           /*!< tRHW: RE# HIGH to WE# LOW (read to write turnaround) */
+        uint16_t rrNs;            /*!< tRR: R/B# rising edge to RE# falling edge */
+        uint16_t wbNs;            /*!< tWB: WE# HIGH to R/B# falling edge (maximum) */
+        uint16_t rhzNs;           /*!< tRHZ: RE# HIGH to output high-Z (maximum) */
+    };
+
+    static constexpr uint8_t ModeCount = 6U;
+
+    static constexpr etl::array<Mode, ModeCount> Modes {{
+        /* mode tRC   tRP  tREH tREA tWC   tWP  tWH  setup hold tWHR  tADL  tRHW  tRR  tWB   tRHZ */
+        { 0U, 100U, 50U, 30U, 40U, 100U, 50U, 30U, 70U, 20U, 120U, 200U, 200U, 40U, 200U, 200U },
+        { 1U, 50U,  25U, 15U, 30U, 45U,  25U, 15U, 35U, 10U, 80U,  100U, 100U, 20U, 100U, 100U },
+        { 2U, 35U,  17U, 15U, 25U, 35U,  17U, 15U, 25U, 10U, 80U,  100U, 100U, 20U, 100U, 100U },
+        { 3U, 30U,  15U, 10U, 20U, 30U,  15U, 10U, 25U, 5U,  60U,  100U, 100U, 20U, 100U, 100U },
+        { 4U, 25U,  12U, 10U, 20U, 25U,  12U, 10U, 20U, 5U,  60U,  70U,  100U, 20U, 100U, 100U },
+        { 5U, 20U,  10U, 7U,  16U, 20U,  10U, 7U,  15U, 5U,  60U,  70U,  100U, 20U, 100U, 100U },
+    }};
+
+    /**
+     * @brief SMC waveform of one mode, in SMC clock cycles.
+     */
+    struct SmcCycles {
+        uint8_t writeSetup;     /*!< NWE_SETUP */
+        uint8_t writePulse;     /*!< NWE_PULSE */
+        uint8_t writeCycle;     /*!< NWE_CYCLE, also NCS_WR_PULSE */
+        uint8_t readPulse;      /*!< NRD_PULSE */
+        uint8_t readCycle;      /*!< NRD_CYCLE, also NCS_RD_PULSE */
+        uint8_t dataFloat;      /*!< TDF_CYCLES */
+    };
+
+    static constexpr uint32_t EbiDataSetupNs = 10U;    /*!< Data setup before the NRD rising edge (SMC read timing) */
+
+    static constexpr uint8_t MaxDataFloatCycles = 15U;
+
+    /**
+     * @brief Round a duration up to whole clock cycles.
+     */
+    static constexpr uint32_t toClockCycles(uint32_t nanoseconds, uint32_t clockHz) {
+        constexpr uint64_t NanosecondsPerSecond = 1000000000ULL;
+
+        return static_cast<uint32_t>(((static_cast<uint64_t>(nanoseconds) * clockHz) + NanosecondsPerSecond - 1U) /
+                                     NanosecondsPerSecond);
+    }
+
+    /**
+     * @brief SMC cycle counts meeting every timing of a mode.
+     *
+     * @param timing Timing mode
+     * @param smcClockHz SMC clock (MCK) frequency
+     */
+    static constexpr SmcCycles toSmcCycles(const Mode& timing, uint32_t smcClockHz) {
+        const uint32_t WriteSetup = (timing.latchSetupNs > timing.wpNs)
+                                        ? toClockCycles(timing.latchSetupNs - timing.wpNs, smcClockHz)
+                                        : 0U;
+        const uint32_t WritePulse = toClockCycles(timing.wpNs, smcClockHz);
+        const uint32_t WriteHold = toClockCycles(etl::max(timing.whNs, timing.latchHoldNs), smcClockHz);
+        const uint32_t WriteCycle = etl::max(toClockCycles(timing.wcNs, smcClockHz), WriteSetup + WritePulse + WriteHold);
+
+        const uint32_t ReadPulse = etl::max(toClockCycles(timing.rpNs, smcClockHz),
+                                            toClockCycles(timing.reaNs + EbiDataSetupNs, smcClockHz));
+        const uint32_t ReadCycle = etl::max(toClockCycles(timing.rcNs, smcClockHz),
+                                            ReadPulse + toClockCycles(timing.rehNs, smcClockHz));
+
+        const uint32_t DataFloat = etl::min(toClockCycles(timing.rhzNs, smcClockHz),
+                                            static_cast<uint32_t>(MaxDataFloatCycles));
+
+        return { static_cast<uint8_t>(WriteSetup), static_cast<uint8_t>(WritePulse), static_cast<uint8_t>(WriteCycle),
+                 static_cast<uint8_t>(ReadPulse), static_cast<uint8_t>(ReadCycle), static_cast<uint8_t>(DataFloat) };
+    }
+
+    /**
+     * @brief SMC cycle counts of every mode.
+     *
+     * @param smcClockHz SMC clock (MCK) frequency
+     */
+    static constexpr etl::array<SmcCycles, ModeCount> toSmcCycles(uint32_t smcClockHz) {
+        etl::array<SmcCycles, ModeCount> cycles{};
+
+        for (uint8_t mode = 0U; mode < ModeCount; mode++) {
+            cycles[mode] = toSmcCycles(Modes[mode], smcClockHz);
+        }
+
+        return cycles;
+    }
+
+    /**
+     * @brief Check that cycle counts can be written to the SMC registers without the coarse
+     *        encodings (SETUP < 32, PULSE < 64 cycles). Cycle lengths are also written as NCS pulses.
+     */
+    static constexpr bool fitsSmcRegisters(const etl::array<SmcCycles, ModeCount>& cycles) {
+        constexpr uint8_t SetupLimit = 32U;
+        constexpr uint8_t PulseLimit = 64U;
+
+        for (const auto& mode : cycles) {
+            if ((mode.writeSetup >= SetupLimit) or (mode.writePulse >= PulseLimit) or (mode.readPulse >= PulseLimit)
+                or (mode.writeCycle >= PulseLimit) or (mode.readCycle >= PulseLimit)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
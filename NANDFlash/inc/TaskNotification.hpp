@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <etl/delegate.h>
+
+/**
+ * @brief Type alias for the delegate blocking the calling task until it is notified.
+ *
+ * @details Called with a timeout in microseconds. Returns true if a notification was received,
+ *          false if the timeout expired. Used by drivers waiting for interrupt driven completions.
+ *
+ * @note For FreeRTOS bind to wrapper returning ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(...)) != 0,
+ *       rounding the timeout up to at least one tick.
+ */
+using NotificationWaitDelegate = etl::delegate<bool(uint32_t)>;
+
+/**
+ * @brief Type alias for the delegate waking the task blocked in a NotificationWaitDelegate.
+ *
+ * @details Called from interrupt context.
+ *
+ * @note For FreeRTOS bind to wrapper calling vTaskNotifyGiveFromISR() for the waiting task,
+ *       followed by portYIELD_FROM_ISR().
+ */
+using NotificationGiveDelegate = etl::delegate<void()>;
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "NANDDma.hpp"
+#include "TaskNotification.hpp"
+#include "definitions.h"
+
+/**
+ * @brief NANDDmaEngine running the page data phase on an ATSAMV71 XDMAC channel.
+ *
+ * @details Each transfer is a software triggered memory-to-memory transfer of byte wide single
+ *          beats between RAM (incremented address) and the NAND data register (fixed address).
+ *          Completion is signalled from the XDMAC interrupt, which wakes the waiting task through
+ *          notifyFromIsr. The caller task sleeps in waitNotification meanwhile.
+ *
+ *          The channel may be shared with other users. If it is busy when a transfer is requested,
+ *          startRead()/startWrite() return false and MT29F moves the page with the CPU instead.
+ *          The channel callback is registered on every transfer for the same reason.
+ *
+ *          Data cache maintenance is handled here: source buffers are cleaned before a write and
+ *          destination buffers are invalidated around a read. Reads into buffers that are not
+ *          cache line aligned (address and length) are rejected, so that invalidation can never
+ *          discard neighbouring data; those reads fall back to the CPU.
+ *
+ * @note If waitNotification is not provided, the task polls the completion flag instead.
+ *
+ * @note The XDMAC interrupt must be enabled (XDMAC_InterruptHandler installed by Harmony).
+ */
+class XDMACNANDDma final : public NANDDmaEngine {
+public:
+    /**
+     * @param dmaChannel XDMAC channel used for the data phase
+     * @param waitNotification Delegate blocking the calling task until notified
+     * @param notifyFromIsr Delegate waking the task blocked in waitNotification
+     */
+    XDMACNANDDma(XDMAC_CHANNEL dmaChannel, NotificationWaitDelegate waitNotification,
+                 NotificationGiveDelegate notifyFromIsr)
+        : channel{dmaChannel}
+        , waitForNotification{waitNotification}
+        , notifyTaskFromIsr{notifyFromIsr} {}
+
+    XDMACNANDDma(const XDMACNANDDma&) = delete;
+    XDMACNANDDma& operator=(const XDMACNANDDma&) = delete;
+    XDMACNANDDma(XDMACNANDDma&&) = delete;
+    XDMACNANDDma& operator=(XDMACNANDDma&&) = delete;
+
+    ~XDMACNANDDma() override = default;
+
+    bool startRead(uint32_t dataRegisterAddress, etl::span<uint8_t> destination) override;
+
+    bool startWrite(etl::span<const uint8_t> source, uint32_t dataRegisterAddress) override;
+
+    bool waitForCompletion(uint32_t timeoutUs) override;
+
+private:
+    static constexpr uint32_t CacheLineSize = 32U;
+
+    static constexpr uint8_t MaxSpuriousWakeups = 2U;   /*!< Stale notifications tolerated per wait */
+
+    /**
+     * @brief Channel configuration shared by both directions: software triggered memory transfer
+     *        of single byte beats, both interfaces on AHB IF1 (EBI and SRAM).
+     */
+    static constexpr XDMAC_CHANNEL_CONFIG ChannelConfigBase = XDMAC_CC_TYPE_MEM_TRAN | XDMAC_CC_MBSIZE_SINGLE |
+                                                              XDMAC_CC_SWREQ_SWR_CONNECTED |
+                                                              XDMAC_CC_MEMSET_NORMAL_MODE | XDMAC_CC_CSIZE_CHK_1 |
+                                                              XDMAC_CC_DWIDTH_BYTE | XDMAC_CC_SIF_AHB_IF1 |
+                                                              XDMAC_CC_DIF_AHB_IF1;
+
+    static constexpr XDMAC_CHANNEL_CONFIG ChannelConfigRead = ChannelConfigBase | XDMAC_CC_SAM_FIXED_AM |
+                                                              XDMAC_CC_DAM_INCREMENTED_AM;
+
+    static constexpr XDMAC_CHANNEL_CONFIG ChannelConfigWrite = ChannelConfigBase | XDMAC_CC_SAM_INCREMENTED_AM |
+                                                               XDMAC_CC_DAM_FIXED_AM;
+
+    const XDMAC_CHANNEL channel;
+
+    NotificationWaitDelegate waitForNotification;
+
+    NotificationGiveDelegate notifyTaskFromIsr;
+
+    volatile bool isTransferComplete = false;
+
+    volatile bool hasTransferFailed = false;
+
+    bool isTransferActive = false;
+
+    etl::span<uint8_t> readDestination; /*!< Invalidated again once a read completes */
+
+    /**
+     * @brief Configure the channel and trigger the transfer.
+     *
+     * @return false if the channel is busy
+     */
+    bool start(XDMAC_CHANNEL_CONFIG config, const void* source, void* destination, size_t length);
+
+    /**
+     * @brief Spin on the completion flag for at most timeoutUs (used without a wait delegate).
+     */
+    void pollForCompletion(uint32_t timeoutUs) const;
+
+    /**
+     * @brief XDMAC channel callback (interrupt context).
+     */
+    static void transferCallback(XDMAC_TRANSFER_EVENT event, uintptr_t context);
+
+    [[nodiscard]] static bool isCacheLineAligned(etl::span<uint8_t> buffer) {
+        return ((reinterpret_cast<uintptr_t>(buffer.data()) % CacheLineSize) == 0U) and
+               ((buffer.size() % CacheLineSize) == 0U);
+    }
+};
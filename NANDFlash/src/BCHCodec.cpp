@@ -0,0 +1,338 @@
+#include "BCHCodec.hpp"
+#include <etl/array.h>
+
+namespace {
+    constexpr uint32_t FieldSize = 1U << BCHCodec::GaloisFieldDegree;
+    constexpr uint32_t FieldOrder = FieldSize - 1U;         /*!< Order of the multiplicative group (period of alpha) */
+    constexpr uint32_t PrimitivePolynomial = 0x402BU;       /*!< x^14 + x^5 + x^3 + x + 1 */
+    constexpr uint8_t SyndromeCount = 2U * BCHCodec::CorrectableBits;
+    constexpr uint8_t RemainderWords = (BCHCodec::ParityBits + 31U) / 32U;
+    constexpr uint8_t BitsPerByte = 8U;
+    constexpr uint8_t BitsPerWord = 32U;
+
+    static_assert((BCHCodec::MaxDataBytes * BitsPerByte) + BCHCodec::ParityBits <= FieldOrder,
+                  "Codeword does not fit the Galois field");
+
+    /**
+     * @brief Division remainder as 32-bit words, MSB first. The coefficient of degree ParityBits-1
+     *        is bit 31 of word 0; the unused low bits of the last word are always zero.
+     */
+    using Remainder = etl::array<uint32_t, RemainderWords>;
+
+    struct GaloisField {
+        etl::array<uint16_t, FieldOrder> exponent{};    /*!< alpha^i */
+        etl::array<uint16_t, FieldSize> logarithm{};    /*!< log_alpha(x), entry 0 unused */
+    };
+
+    constexpr GaloisField buildGaloisField() {
+        GaloisField field{};
+        uint32_t element = 1U;
+
+        for (uint32_t power = 0U; power < FieldOrder; power++) {
+            field.exponent[power] = static_cast<uint16_t>(element);
+            field.logarithm[element] = static_cast<uint16_t>(power);
+
+            element <<= 1U;
+
+            if ((element & FieldSize) != 0U) {
+                element ^= PrimitivePolynomial;
+            }
+        }
+
+        return field;
+    }
+
+    constexpr GaloisField Field = buildGaloisField();
+
+    constexpr uint16_t multiply(uint16_t lhs, uint16_t rhs) {
+        if ((lhs == 0U) or (rhs == 0U)) {
+            return 0U;
+        }
+
+        return Field.exponent[(Field.logarithm[lhs] + Field.logarithm[rhs]) % FieldOrder];
+    }
+
+    constexpr uint16_t divide(uint16_t dividend, uint16_t divisor) {
+        if (dividend == 0U) {
+            return 0U;
+        }
+
+        return Field.exponent[(Field.logarithm[dividend] + FieldOrder - Field.logarithm[divisor]) % FieldOrder];
+    }
+
+    /**
+     * @brief Binary coefficients of the generator polynomial, indexed by degree.
+     */
+    using GeneratorPolynomial = etl::array<uint8_t, BCHCodec::ParityBits + 1U>;
+
+    /**
+     * @brief g(x) = LCM of the minimal polynomials of alpha^1, alpha^3, ..., alpha^(2t-1).
+     */
+    constexpr GeneratorPolynomial buildGenerator() {
+        GeneratorPolynomial generator{};
+        generator[0] = 1U;
+        uint16_t generatorDegree = 0U;
+
+        etl::array<bool, FieldOrder> isRoot{};
+
+        for (uint32_t power = 1U; power < SyndromeCount; power += 2U) {
+            if (isRoot[power]) {
+                continue;
+            }
+
+            etl::array<uint16_t, BCHCodec::GaloisFieldDegree + 1U> minimal{};
+            minimal[0] = 1U;
+            uint8_t minimalDegree = 0U;
+            uint32_t conjugate = power;
+
+            do {
+                isRoot[conjugate] = true;
+
+                const uint16_t Root = Field.exponent[conjugate];
+
+                for (uint8_t degree = minimalDegree + 1U; degree > 0U; degree--) {
+                    minimal[degree] = minimal[degree - 1U] ^ multiply(minimal[degree], Root);
+                }
+
+                minimal[0] = multiply(minimal[0], Root);
+                minimalDegree++;
+                conjugate = (conjugate * 2U) % FieldOrder;
+            } while (conjugate != power);
+
+            GeneratorPolynomial product{};
+
+            for (uint16_t degree = 0U; degree <= generatorDegree; degree++) {
+                if (generator[degree] == 0U) {
+                    continue;
+                }
+
+                for (uint8_t minimalIndex = 0U; minimalIndex <= minimalDegree; minimalIndex++) {
+                    product[degree + minimalIndex] ^= static_cast<uint8_t>(minimal[minimalIndex]);
+                }
+            }
+
+            generator = product;
+            generatorDegree += minimalDegree;
+        }
+
+        return generator;
+    }
+
+    constexpr GeneratorPolynomial Generator = buildGenerator();
+
+    static_assert(Generator[BCHCodec::ParityBits] == 1U, "Generator polynomial degree must equal ParityBits");
+
+    constexpr void shiftLeft(Remainder& remainder, uint8_t bits) {
+        for (uint8_t word = 0U; word < (RemainderWords - 1U); word++) {
+            remainder[word] = (remainder[word] << bits) | (remainder[word + 1U] >> (BitsPerWord - bits));
+        }
+
+        remainder[RemainderWords - 1U] <<= bits;
+    }
+
+    constexpr bool isRemainderBitSet(const Remainder& remainder, uint16_t position) {
+        return ((remainder[position / BitsPerWord] >> (BitsPerWord - 1U - (position % BitsPerWord))) & 1U) != 0U;
+    }
+
+    /**
+     * @brief remainderTable[v] = v(x) * x^ParityBits mod g(x), for every byte value v.
+     */
+    constexpr etl::array<Remainder, 256> buildRemainderTable() {
+        Remainder generatorLow{};
+
+        for (uint16_t degree = 0U; degree < BCHCodec::ParityBits; degree++) {
+            if (Generator[degree] != 0U) {
+                const uint16_t Position = BCHCodec::ParityBits - 1U - degree;
+                generatorLow[Position / BitsPerWord] |= 1UL << (BitsPerWord - 1U - (Position % BitsPerWord));
+            }
+        }
+
+        etl::array<Remainder, 256> table{};
+
+        for (uint16_t value = 0U; value < 256U; value++) {
+            Remainder remainder{};
+
+            for (int8_t bit = BitsPerByte - 1; bit >= 0; bit--) {
+                const uint32_t Feedback = (remainder[0] >> (BitsPerWord - 1U)) ^ ((value >> bit) & 1U);
+
+                shiftLeft(remainder, 1U);
+
+                if (Feedback != 0U) {
+                    for (uint8_t word = 0U; word < RemainderWords; word++) {
+                        remainder[word] ^= generatorLow[word];
+                    }
+                }
+            }
+
+            table[value] = remainder;
+        }
+
+        return table;
+    }
+
+    constexpr etl::array<Remainder, 256> RemainderTable = buildRemainderTable();
+
+    Remainder computeRemainder(etl::span<const uint8_t> data) {
+        constexpr uint8_t TopByteShift = BitsPerWord - BitsPerByte;
+
+        Remainder remainder{};
+
+        for (const auto byte : data) {
+            const Remainder& Row = RemainderTable[(remainder[0] >> TopByteShift) ^ byte];
+
+            shiftLeft(remainder, BitsPerByte);
+
+            for (uint8_t word = 0U; word < RemainderWords; word++) {
+                remainder[word] ^= Row[word];
+            }
+        }
+
+        return remainder;
+    }
+
+    constexpr uint8_t parityShift(size_t parityByte) {
+        return BitsPerWord - BitsPerByte - (BitsPerByte * (parityByte % 4U));
+    }
+
+    void flipBit(etl::span<uint8_t> bytes, uint32_t bitIndex) {
+        bytes[bitIndex / BitsPerByte] ^= static_cast<uint8_t>(0x80U >> (bitIndex % BitsPerByte));
+    }
+}
+
+void BCHCodec::encode(etl::span<const uint8_t> data, etl::span<uint8_t, ParityBytes> parity) {
+    const Remainder Parity = computeRemainder(data);
+
+    for (size_t index = 0U; index < ParityBytes; index++) {
+        parity[index] = static_cast<uint8_t>(Parity[index / 4U] >> parityShift(index));
+    }
+}
+
+etl::optional<uint8_t> BCHCodec::decode(etl::span<uint8_t> data, etl::span<uint8_t, ParityBytes> parity) {
+    Remainder remainder = computeRemainder(data);
+    bool isClean = true;
+
+    for (size_t index = 0U; index < ParityBytes; index++) {
+        remainder[index / 4U] ^= static_cast<uint32_t>(parity[index]) << parityShift(index);
+    }
+
+    for (const auto word : remainder) {
+        isClean = isClean and (word == 0U);
+    }
+
+    if (isClean) {
+        return 0U;
+    }
+
+    /* Syndromes S1..S2t of the received word equal those of its remainder, S2j = Sj^2 */
+    etl::array<uint16_t, SyndromeCount + 1U> syndromes{};
+
+    for (uint16_t position = 0U; position < ParityBits; position++) {
+        if (not isRemainderBitSet(remainder, position)) {
+            continue;
+        }
+
+        const uint32_t Degree = ParityBits - 1U - position;
+
+        for (uint32_t index = 1U; index < SyndromeCount; index += 2U) {
+            syndromes[index] ^= Field.exponent[(index * Degree) % FieldOrder];
+        }
+    }
+
+    for (uint8_t index = 2U; index <= SyndromeCount; index += 2U) {
+        syndromes[index] = multiply(syndromes[index / 2U], syndromes[index / 2U]);
+    }
+
+    /* Berlekamp-Massey: error locator polynomial */
+    etl::array<uint16_t, SyndromeCount + 1U> locator{};
+    etl::array<uint16_t, SyndromeCount + 1U> previousLocator{};
+    locator[0] = 1U;
+    previousLocator[0] = 1U;
+    uint8_t locatorDegree = 0U;
+    uint8_t shift = 1U;
+    uint16_t previousDiscrepancy = 1U;
+
+    for (uint8_t step = 0U; step < SyndromeCount; step++) {
+        uint16_t discrepancy = syndromes[step + 1U];
+
+        for (uint8_t index = 1U; index <= locatorDegree; index++) {
+            discrepancy ^= multiply(locator[index], syndromes[step + 1U - index]);
+        }
+
+        if (discrepancy == 0U) {
+            shift++;
+            continue;
+        }
+
+        const uint16_t Scale = divide(discrepancy, previousDiscrepancy);
+        const auto CurrentLocator = locator;
+
+        for (uint8_t index = 0U; (index + shift) <= SyndromeCount; index++) {
+            locator[index + shift] ^= multiply(Scale, previousLocator[index]);
+        }
+
+        if ((2U * locatorDegree) <= step) {
+            locatorDegree = step + 1U - locatorDegree;
+            previousLocator = CurrentLocator;
+            previousDiscrepancy = discrepancy;
+            shift = 1U;
+        } else {
+            shift++;
+        }
+    }
+
+    if (locatorDegree > CorrectableBits) {
+        return etl::nullopt;
+    }
+
+    /* Chien search: bit of degree e is in error if locator(alpha^-e) = 0 */
+    constexpr int32_t NoTerm = -1;
+
+    const uint32_t CodewordBits = (data.size() * BitsPerByte) + ParityBits;
+    etl::array<int32_t, CorrectableBits + 1U> terms{};
+    etl::array<uint32_t, CorrectableBits> errorDegrees{};
+    uint8_t errorCount = 0U;
+
+    for (uint8_t index = 1U; index <= locatorDegree; index++) {
+        terms[index] = (locator[index] == 0U) ? NoTerm : static_cast<int32_t>(Field.logarithm[locator[index]]);
+    }
+
+    for (uint32_t degree = 0U; (degree < CodewordBits) and (errorCount < locatorDegree); degree++) {
+        uint16_t sum = 1U;
+
+        for (uint8_t index = 1U; index <= locatorDegree; index++) {
+            if (terms[index] == NoTerm) {
+                continue;
+            }
+
+            sum ^= Field.exponent[terms[index]];
+
+            terms[index] -= index;
+
+            if (terms[index] < 0) {
+                terms[index] += FieldOrder;
+            }
+        }
+
+        if (sum == 0U) {
+            errorDegrees[errorCount++] = degree;
+        }
+    }
+
+    if (errorCount != locatorDegree) {
+        return etl::nullopt;
+    }
+
+    const uint32_t DataBits = data.size() * BitsPerByte;
+
+    for (uint8_t error = 0U; error < errorCount; error++) {
+        const uint32_t StreamIndex = CodewordBits - 1U - errorDegrees[error];
+
+        if (StreamIndex < DataBits) {
+            flipBit(data, StreamIndex);
+        } else {
+            flipBit(parity, StreamIndex - DataBits);
+        }
+    }
+
+    return errorCount;
+}
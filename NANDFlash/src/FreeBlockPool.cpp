@@ -0,0 +1,93 @@
+#include "FreeBlockPool.hpp"
+
+void FreeBlockPool::clear() {
+    heapSizes.fill(0U);
+    positions.fill(NoPosition);
+}
+
+void FreeBlockPool::insert(uint16_t block) {
+    const uint8_t Plane = getPlane(block);
+    const uint16_t Position = heapSizes[Plane];
+
+    heapSizes[Plane]++;
+    place(Plane, Position, block);
+    siftUp(Plane, Position);
+}
+
+void FreeBlockPool::remove(uint16_t block) {
+    if (not contains(block)) {
+        return;
+    }
+
+    const uint8_t Plane = getPlane(block);
+    const uint16_t Position = positions[block];
+    const uint16_t Last = heaps[Plane][heapSizes[Plane] - 1U];
+
+    heapSizes[Plane]--;
+    positions[block] = NoPosition;
+
+    if (Last == block) {
+        return;
+    }
+
+    place(Plane, Position, Last);
+    siftUp(Plane, Position);
+    siftDown(Plane, positions[Last]);
+}
+
+uint16_t FreeBlockPool::findMostWorn(uint8_t plane) const {
+    uint16_t mostWorn = NoBlock;
+
+    /* The maximum of a min-heap is one of its leaves */
+    for (uint16_t position = heapSizes[plane] / 2U; position < heapSizes[plane]; position++) {
+        const uint16_t Block = heaps[plane][position];
+
+        if ((mostWorn == NoBlock) or isLessWorn(mostWorn, Block)) {
+            mostWorn = Block;
+        }
+    }
+
+    return mostWorn;
+}
+
+void FreeBlockPool::siftUp(uint8_t plane, uint16_t position) {
+    const uint16_t Block = heaps[plane][position];
+
+    while (position > 0U) {
+        const uint16_t Parent = (position - 1U) / 2U;
+
+        if (not isLessWorn(Block, heaps[plane][Parent])) {
+            break;
+        }
+
+        place(plane, position, heaps[plane][Parent]);
+        position = Parent;
+    }
+
+    place(plane, position, Block);
+}
+
+void FreeBlockPool::siftDown(uint8_t plane, uint16_t position) {
+    const uint16_t Block = heaps[plane][position];
+    const uint16_t Size = heapSizes[plane];
+
+    while (true) {
+        const uint16_t Left = (2U * position) + 1U;
+
+        if (Left >= Size) {
+            break;
+        }
+
+        const uint16_t Right = Left + 1U;
+        const uint16_t Child = ((Right < Size) and isLessWorn(heaps[plane][Right], heaps[plane][Left])) ? Right : Left;
+
+        if (not isLessWorn(heaps[plane][Child], Block)) {
+            break;
+        }
+
+        place(plane, position, heaps[plane][Child]);
+        position = Child;
+    }
+
+    place(plane, position, Block);
+}
@@ -0,0 +1,217 @@
+#include "LZCodec.hpp"
+#include "LittleEndian.hpp"
+#include <etl/algorithm.h>
+
+namespace {
+    constexpr size_t MinMatchBytes = 4U;
+    constexpr size_t LastLiteralBytes = 5U;     /*!< The block ends with at least this many literals */
+    constexpr size_t MatchStartLimit = 12U;     /*!< The last match starts at least this far from the end */
+    constexpr uint8_t RunMask = 0x0FU;
+    constexpr uint8_t LengthByteMax = 255U;
+    constexpr uint8_t SkipShift = 6U;           /*!< Search step grows by 1 every 64 literals */
+    constexpr size_t MaxOffset = 65535U;
+
+    size_t hashWord(uint32_t word) {
+        constexpr uint32_t Multiplier = 2654435761U;     /*!< Knuth's multiplicative hash */
+
+        return (word * Multiplier) >> (32U - LZCodec::HashBits);
+    }
+
+    /**
+     * @brief Write the extension bytes of a length whose nibble saturated.
+     *
+     * @return false if the output is too small
+     */
+    bool writeLength(size_t length, etl::span<uint8_t> output, size_t& position) {
+        while (length >= LengthByteMax) {
+            if (position >= output.size()) {
+                return false;
+            }
+
+            output[position] = LengthByteMax;
+            position++;
+            length -= LengthByteMax;
+        }
+
+        if (position >= output.size()) {
+            return false;
+        }
+
+        output[position] = static_cast<uint8_t>(length);
+        position++;
+
+        return true;
+    }
+
+    /**
+     * @brief Read the extension bytes of a length whose nibble saturated.
+     *
+     * @return false if the input ends inside the length
+     */
+    bool readLength(etl::span<const uint8_t> input, size_t& position, size_t& length) {
+        uint8_t byte = LengthByteMax;
+
+        while (byte == LengthByteMax) {
+            if (position >= input.size()) {
+                return false;
+            }
+
+            byte = input[position];
+            position++;
+            length += byte;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Write one sequence: token, literals and, unless matchLength is 0, the match.
+     *
+     * @return false if the output is too small
+     */
+    bool writeSequence(etl::span<const uint8_t> literals, size_t offset, size_t matchLength, etl::span<uint8_t> output,
+                       size_t& position) {
+        const size_t MatchCode = (matchLength > 0U) ? (matchLength - MinMatchBytes) : 0U;
+
+        if (position >= output.size()) {
+            return false;
+        }
+
+        const size_t TokenPosition = position;
+
+        output[TokenPosition] = static_cast<uint8_t>((etl::min<size_t>(literals.size(), RunMask) << 4U) |
+                                                     etl::min<size_t>(MatchCode, RunMask));
+        position++;
+
+        if ((literals.size() >= RunMask) and not writeLength(literals.size() - RunMask, output, position)) {
+            return false;
+        }
+
+        if (literals.size() > (output.size() - position)) {
+            return false;
+        }
+
+        etl::copy(literals.begin(), literals.end(), output.begin() + position);
+        position += literals.size();
+
+        if (matchLength == 0U) {
+            return true;
+        }
+
+        if ((output.size() - position) < sizeof(uint16_t)) {
+            return false;
+        }
+
+        LittleEndian::storeHalfWord(output, position, static_cast<uint16_t>(offset));
+        position += sizeof(uint16_t);
+
+        return (MatchCode < RunMask) or writeLength(MatchCode - RunMask, output, position);
+    }
+}
+
+etl::optional<size_t> LZCodec::compress(etl::span<const uint8_t> input, etl::span<uint8_t> output) {
+    if (input.size() > MaxInputBytes) {
+        return etl::nullopt;
+    }
+
+    size_t outputPosition = 0U;
+    size_t anchor = 0U;      /*!< First input byte not encoded yet */
+    size_t position = 0U;
+
+    /* Stale entries from earlier blocks are harmless: a candidate is only used if it lies before
+     * the current position and its bytes match */
+    while ((position + MatchStartLimit) <= input.size()) {
+        const uint32_t Word = LittleEndian::loadWord(input, position);
+        const size_t Hash = hashWord(Word);
+        const size_t Candidate = hashTable[Hash];
+
+        hashTable[Hash] = static_cast<uint16_t>(position);
+
+        if ((Candidate >= position) or ((position - Candidate) > MaxOffset) or (LittleEndian::loadWord(input, Candidate) != Word)) {
+            position += 1U + ((position - anchor) >> SkipShift);
+            continue;
+        }
+
+        size_t matchLength = MinMatchBytes;
+        const size_t MatchEndLimit = input.size() - LastLiteralBytes;
+
+        while (((position + matchLength) < MatchEndLimit) and (input[Candidate + matchLength] == input[position + matchLength])) {
+            matchLength++;
+        }
+
+        if (not writeSequence(input.subspan(anchor, position - anchor), position - Candidate, matchLength, output,
+                              outputPosition)) {
+            return etl::nullopt;
+        }
+
+        position += matchLength;
+        anchor = position;
+    }
+
+    if (not writeSequence(input.subspan(anchor), 0U, 0U, output, outputPosition)) {
+        return etl::nullopt;
+    }
+
+    return outputPosition;
+}
+
+etl::optional<size_t> LZCodec::decompress(etl::span<const uint8_t> input, etl::span<uint8_t> output) {
+    size_t inputPosition = 0U;
+    size_t outputPosition = 0U;
+
+    while (inputPosition < input.size()) {
+        const uint8_t Token = input[inputPosition];
+        size_t literalLength = Token >> 4U;
+
+        inputPosition++;
+
+        if ((literalLength == RunMask) and not readLength(input, inputPosition, literalLength)) {
+            return etl::nullopt;
+        }
+
+        if ((literalLength > (input.size() - inputPosition)) or (literalLength > (output.size() - outputPosition))) {
+            return etl::nullopt;
+        }
+
+        etl::copy_n(input.begin() + inputPosition, literalLength, output.begin() + outputPosition);
+        inputPosition += literalLength;
+        outputPosition += literalLength;
+
+        /* The last sequence has no match */
+        if (inputPosition == input.size()) {
+            return outputPosition;
+        }
+
+        if ((input.size() - inputPosition) < sizeof(uint16_t)) {
+            return etl::nullopt;
+        }
+
+        const size_t Offset = LittleEndian::loadHalfWord(input, inputPosition);
+        size_t matchLength = Token & RunMask;
+
+        inputPosition += sizeof(uint16_t);
+
+        if ((Offset == 0U) or (Offset > outputPosition)) {
+            return etl::nullopt;
+        }
+
+        if ((matchLength == RunMask) and not readLength(input, inputPosition, matchLength)) {
+            return etl::nullopt;
+        }
+
+        matchLength += MinMatchBytes;
+
+        if (matchLength > (output.size() - outputPosition)) {
+            return etl::nullopt;
+        }
+
+        /* Byte by byte: the match may overlap the bytes it produces */
+        for (size_t index = 0U; index < matchLength; index++) {
+            output[outputPosition] = output[outputPosition - Offset];
+            outputPosition++;
+        }
+    }
+
+    /* Empty input, or a block ending with a match */
+    return etl::nullopt;
+}
@@ -0,0 +1,146 @@
+#include "NANDDownlinkStreamer.hpp"
+#include <etl/algorithm.h>
+#include <etl/array.h>
+
+/* ============= Public Interface ============= */
+
+etl::expected<uint32_t, NANDErrorCode> NANDDownlinkStreamer::stream(const MT29F::NANDAddress& startAddress,
+                                                                    uint64_t byteCount, PacketSink sink) {
+    if (not isFormatValid() or not sink.is_valid()) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    const uint64_t PageCount = (byteCount + MT29F::DataBytesPerPage - 1U) / MT29F::DataBytesPerPage;
+
+    if (PageCount > UINT32_MAX) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    const size_t SlotCount = packetRing.size() / getPacketBytes();
+    size_t slot = 0U;
+    uint16_t filledBytes = 0U;
+    uint64_t remainingBytes = byteCount;
+    uint32_t sentPackets = 0U;
+    bool isStopped = false;
+
+    auto sendPacket = [&]() {
+        const etl::span<uint8_t> Packet = packetRing.subspan(slot * getPacketBytes(), format.headerBytes + filledBytes);
+        const etl::span<uint8_t> Header = Packet.first(format.headerBytes);
+
+        if (headerWriter.is_valid()) {
+            headerWriter(sequenceCount, filledBytes, Header);
+        } else {
+            etl::fill(Header.begin(), Header.end(), 0U);
+            writeCcsdsPrimaryHeader(format.apid, sequenceCount, (format.headerBytes - CcsdsPrimaryHeaderBytes) + filledBytes,
+                                    Header);
+        }
+
+        sequenceCount++;
+        sentPackets++;
+        statistics.packets++;
+        statistics.payloadBytes += filledBytes;
+
+        slot = (slot + 1U) % SlotCount;
+        filledBytes = 0U;
+
+        isStopped = not sink(Packet);
+    };
+
+    auto sendPageBytes = [&](MT29F::PageDataStream& pageStream, uint16_t pageBytes) {
+        while ((pageBytes > 0U) and not isStopped) {
+            const uint16_t Length = etl::min<uint16_t>(format.payloadBytes - filledBytes, pageBytes);
+            const etl::span<uint8_t> Payload =
+                packetRing.subspan((slot * getPacketBytes()) + format.headerBytes + filledBytes, Length);
+
+            (void) pageStream.read(Payload);
+
+            filledBytes += Length;
+            pageBytes -= Length;
+
+            if (filledBytes == format.payloadBytes) {
+                sendPacket();
+            }
+        }
+    };
+
+    auto pageLambda = [&](const MT29F::NANDAddress&, MT29F::PageDataStream& pageStream) -> bool {
+        const uint16_t DataBytes = static_cast<uint16_t>(etl::min<uint64_t>(MT29F::DataBytesPerPage, remainingBytes));
+
+        statistics.pages++;
+        remainingBytes -= DataBytes;
+
+        if (not format.includeParity) {
+            sendPageBytes(pageStream, DataBytes);
+        } else {
+            const uint16_t SectorCount = (DataBytes + MT29F::EccSectorBytes - 1U) / MT29F::EccSectorBytes;
+            const uint16_t SectorBytes = SectorCount * MT29F::EccSectorBytes;
+
+            sendPageBytes(pageStream, SectorBytes);
+
+            /* The parity of the sectors sits in the spare area, past the unsent sectors and the metadata */
+            uint16_t skippedBytes = (MT29F::DataBytesPerPage - SectorBytes) + MT29F::EccParityOffset;
+            etl::array<uint8_t, MT29F::EccParityOffset> discarded {};
+
+            while ((skippedBytes > 0U) and not isStopped) {
+                const uint16_t Length = etl::min<uint16_t>(discarded.size(), skippedBytes);
+
+                (void) pageStream.read(etl::span<uint8_t>(discarded.data(), Length));
+                skippedBytes -= Length;
+            }
+
+            sendPageBytes(pageStream, static_cast<uint16_t>(SectorCount * BCHCodec::ParityBytes));
+        }
+
+        return (remainingBytes > 0U) and not isStopped;
+    };
+
+    if (auto readResult = nand.readPagesSequential(startAddress, static_cast<uint32_t>(PageCount),
+                                                   MT29F::PageSink(pageLambda));
+        not readResult.has_value()) {
+        return etl::unexpected(readResult.error());
+    }
+
+    if ((filledBytes > 0U) and not isStopped) {
+        sendPacket();
+    }
+
+    return sentPackets;
+}
+
+void NANDDownlinkStreamer::writeCcsdsPrimaryHeader(uint16_t apid, uint32_t sequenceCount, uint32_t dataFieldBytes,
+                                                   etl::span<uint8_t> header) {
+    constexpr uint8_t UnsegmentedFlags = 0xC0U;
+
+    /* Version 0, telemetry, no secondary header flag */
+    header[0] = static_cast<uint8_t>((apid & CcsdsMaxApid) >> 8U);
+    header[1] = static_cast<uint8_t>(apid);
+
+    const uint16_t Count = static_cast<uint16_t>(sequenceCount) & CcsdsSequenceCountMask;
+
+    header[2] = UnsegmentedFlags | static_cast<uint8_t>(Count >> 8U);
+    header[3] = static_cast<uint8_t>(Count);
+
+    /* The length field holds the data field length minus one */
+    const uint16_t LengthField = static_cast<uint16_t>(dataFieldBytes - 1U);
+
+    header[4] = static_cast<uint8_t>(LengthField >> 8U);
+    header[5] = static_cast<uint8_t>(LengthField);
+}
+
+
+/* ============= Helpers ============= */
+
+bool NANDDownlinkStreamer::isFormatValid() const {
+    constexpr uint32_t CcsdsMaxDataFieldBytes = 65536U;
+
+    const uint32_t PacketBytes = static_cast<uint32_t>(format.headerBytes) + format.payloadBytes;
+
+    if ((format.payloadBytes == 0U) or (PacketBytes > UINT16_MAX) or ((packetRing.size() / PacketBytes) < 2U)) {
+        return false;
+    }
+
+    /* The default header needs room for the primary header and a representable data field */
+    return headerWriter.is_valid() or
+           ((format.headerBytes >= CcsdsPrimaryHeaderBytes) and (format.apid <= CcsdsMaxApid) and
+            ((PacketBytes - CcsdsPrimaryHeaderBytes) <= CcsdsMaxDataFieldBytes));
+}
@@ -0,0 +1,1146 @@
+#include "NANDFTL.hpp"
+#include "LittleEndian.hpp"
+#include <etl/algorithm.h>
+#include <Logger.hpp>
+
+/* ============= Public Interface ============= */
+
+etl::expected<void, NANDErrorCode> NANDFTL::format() {
+    if (auto prepareResult = prepare(); not prepareResult.has_value()) {
+        return prepareResult;
+    }
+
+    etl::bitset<BlockCount> knownEraseCounts;
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        if (nand.isBlockBad(block).value_or(true)) {
+            continue;
+        }
+
+        /* Carry over the erase count of blocks holding FTL data */
+        Tag tag;
+
+        if (auto tagResult = nand.readPageMetadataEcc(toAddress(static_cast<uint32_t>(block) * PagesPerBlock), tag);
+            tagResult.has_value()) {
+            if (not tagResult->isErased) {
+                eraseCounts[block] = decodeTag(tag).eraseCount;
+                knownEraseCounts.set(block);
+            }
+        } else if (tagResult.error() != NANDErrorCode::ECC_UNCORRECTABLE) {
+            return etl::unexpected(tagResult.error());
+        }
+    }
+
+    estimateEraseCounts(knownEraseCounts);
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        if (nand.isBlockBad(block).value_or(true)) {
+            continue;
+        }
+
+        if (auto eraseResult = nand.eraseBlock(block); not eraseResult.has_value()) {
+            if (eraseResult.error() != NANDErrorCode::ERASE_FAILED) {
+                return eraseResult;
+            }
+
+            (void) nand.markBadBlock(block);
+            statistics.retiredBlocks++;
+            continue;
+        }
+
+        statistics.blockErases++;
+        eraseCounts[block]++;
+        erasedPool.insert(block);
+    }
+
+    if (journal != nullptr) {
+        if (auto createResult = journal->create(mapping, blockMaxSequence, eraseCounts, sequence);
+            not createResult.has_value()) {
+            return createResult;
+        }
+    }
+
+    mounted = true;
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::mount() {
+    if (auto prepareResult = prepare(); not prepareResult.has_value()) {
+        return prepareResult;
+    }
+
+    if (journal != nullptr) {
+        auto loadResult = loadJournal();
+
+        if (loadResult.has_value()) {
+            mounted = true;
+            return {};
+        }
+
+        if (loadResult.error() != NANDErrorCode::JOURNAL_INVALID) {
+            return loadResult;
+        }
+
+        LOG_INFO << "FTL: No valid journal checkpoint found. Scanning the NAND";
+
+        if (auto prepareResult = prepare(); not prepareResult.has_value()) {
+            return prepareResult;
+        }
+    }
+
+    etl::bitset<BlockCount> knownEraseCounts;
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        if (nand.isBlockBad(block).value_or(true)) {
+            continue;
+        }
+
+        bool isEraseCountKnown = false;
+
+        if (auto scanResult = scanBlock(block, isEraseCountKnown); not scanResult.has_value()) {
+            return scanResult;
+        }
+
+        knownEraseCounts.set(block, isEraseCountKnown);
+    }
+
+    estimateEraseCounts(knownEraseCounts);
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        if ((validPages[block] == 0U) and (not nand.isBlockBad(block).value_or(true))) {
+            dirtyPool.insert(block);
+        }
+    }
+
+    if (journal != nullptr) {
+        if (auto createResult = journal->create(mapping, blockMaxSequence, eraseCounts, sequence);
+            not createResult.has_value()) {
+            return createResult;
+        }
+    }
+
+    mounted = true;
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::read(uint32_t sector, etl::span<uint8_t> data) {
+    constexpr uint8_t ErasedByte = 0xFFU;
+
+    if (not mounted) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (sector >= mapping.size()) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    if (data.size() != SectorBytes) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if (mapping[sector] == UnmappedPage) {
+        etl::fill(data.begin(), data.end(), ErasedByte);
+        return {};
+    }
+
+    const uint16_t Block = mapping[sector] / PagesPerBlock;
+
+    if (readCounts[Block] < UINT16_MAX) {
+        readCounts[Block]++;
+    }
+
+    if (isScrubEnabled and (readCounts[Block] >= scrubSettings.readDisturbLimit) and (refreshBlock == NoBlock)) {
+        startRefresh(Block, false);
+        statistics.readDisturbRefreshes++;
+    }
+
+    if (auto readResult = nand.readPageEcc(toAddress(mapping[sector]), data); not readResult.has_value()) {
+        return etl::unexpected(readResult.error());
+    }
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::write(uint32_t sector, etl::span<const uint8_t> data) {
+    if (not mounted) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (sector >= mapping.size()) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    if (data.size() != SectorBytes) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    for (uint8_t attempt = 0U; attempt < MaxProgramAttempts; attempt++) {
+        if (hostBlock == NoBlock) {
+            auto allocateResult = allocateBlock(PlaneCount, BlockUse::HOST_DATA);
+
+            if (not allocateResult.has_value()) {
+                return etl::unexpected(allocateResult.error());
+            }
+
+            hostBlock = *allocateResult;
+        }
+
+        const uint32_t PhysicalPage = (static_cast<uint32_t>(hostBlock) * PagesPerBlock) + writtenPages[hostBlock];
+        const uint32_t WriteSequence = sequence + 1U;
+        const Tag PageTag = encodeTag(TagFields { sector, WriteSequence, eraseCounts[hostBlock] });
+
+        auto programResult = nand.programPageEcc(toAddress(PhysicalPage), data, PageTag);
+
+        writtenPages[hostBlock]++;
+
+        if (programResult.has_value()) {
+            sequence = WriteSequence;
+            statistics.hostPageWrites++;
+
+            if (writtenPages[hostBlock] == PagesPerBlock) {
+                hostBlock = NoBlock;
+            }
+
+            return recordMapping(sector, PhysicalPage, WriteSequence);
+        }
+
+        if (programResult.error() != NANDErrorCode::PROGRAM_FAILED) {
+            return programResult;
+        }
+
+        retireBlock(hostBlock);
+    }
+
+    return etl::unexpected(NANDErrorCode::PROGRAM_FAILED);
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::checkpoint() {
+    if (not mounted or (journal == nullptr)) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (auto checkpointResult = journal->checkpoint(mapping, blockMaxSequence, eraseCounts, sequence);
+        not checkpointResult.has_value()) {
+        return checkpointResult;
+    }
+
+    statistics.checkpoints++;
+
+    return {};
+}
+
+etl::expected<bool, NANDErrorCode> NANDFTL::runBackgroundStep() {
+    if (not mounted or not isBackgroundEnabled) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (erasedPool.size() < backgroundWatermarks.erasedLow) {
+        isPreErasing = true;
+    } else if (erasedPool.size() >= backgroundWatermarks.erasedHigh) {
+        isPreErasing = false;
+    }
+
+    if (getFreeBlockCount() < backgroundWatermarks.freeLow) {
+        isCollectingInBackground = true;
+    } else if (getFreeBlockCount() >= backgroundWatermarks.freeHigh) {
+        isCollectingInBackground = false;
+    }
+
+    /* Above the low watermark, wait for a dirty block in each plane to erase them together */
+    const bool CanPairErase = (dirtyPool.size(0U) > 0U) and (dirtyPool.size(1U) > 0U);
+
+    if (isPreErasing and (dirtyPool.size() > 0U) and
+        (CanPairErase or (erasedPool.size() < backgroundWatermarks.erasedLow))) {
+        if (auto eraseResult = preEraseBlocks(); not eraseResult.has_value()) {
+            return etl::unexpected(eraseResult.error());
+        }
+
+        return true;
+    }
+
+    if (isCollectingInBackground and (collectingBlock == NoBlock)) {
+        const uint16_t Victim = selectVictim();
+
+        if ((Victim == NoBlock) or (validPages[Victim] > BackgroundMaxValidPages)) {
+            isCollectingInBackground = false;
+        } else {
+            collectingBlock = Victim;
+            collectionPage = 0U;
+        }
+    }
+
+    if (collectingBlock != NoBlock) {
+        statistics.backgroundCollectionSteps++;
+
+        if (auto collectResult = continueCollection(BackgroundStepPages); not collectResult.has_value()) {
+            return etl::unexpected(collectResult.error());
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+etl::expected<bool, NANDErrorCode> NANDFTL::runScrubStep() {
+    if (not mounted or not isScrubEnabled) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if ((refreshBlock != NoBlock) and (collectingBlock == NoBlock)) {
+        if (holdsData(refreshBlock)) {
+            closeBlock(refreshBlock);
+            collectingBlock = refreshBlock;
+            collectionPage = 0U;
+        } else {
+            /* Collected meanwhile by write() or the background step */
+            refreshBlock = NoBlock;
+            correctingBlock = NoBlock;
+        }
+    }
+
+    if (collectingBlock != NoBlock) {
+        if (auto collectResult = continueCollection(scrubSettings.pagesPerStep); not collectResult.has_value()) {
+            return etl::unexpected(collectResult.error());
+        }
+
+        return true;
+    }
+
+    auto checkResult = checkScrubPages();
+
+    if (not checkResult.has_value()) {
+        return etl::unexpected(checkResult.error());
+    }
+
+    return (*checkResult > 0U) or (refreshBlock != NoBlock);
+}
+
+uint32_t NANDFTL::getMaxSectorCount() const {
+    uint16_t goodBlocks = 0U;
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        if (not nand.isBlockBad(block).value_or(true)) {
+            goodBlocks++;
+        }
+    }
+
+    if (goodBlocks <= OverprovisionBlocks) {
+        return 0U;
+    }
+
+    return static_cast<uint32_t>(goodBlocks - OverprovisionBlocks) * PagesPerBlock;
+}
+
+
+/* ============= Mapping ============= */
+
+NANDFTL::Tag NANDFTL::encodeTag(const TagFields& fields) {
+    constexpr size_t SequenceOffset = 4U;
+    constexpr size_t EraseCountOffset = 8U;
+
+    Tag tag{};
+
+    LittleEndian::storeWord(tag, 0U, fields.sector);
+    LittleEndian::storeWord(tag, SequenceOffset, fields.sequence);
+    LittleEndian::storeWord(tag, EraseCountOffset, fields.eraseCount);
+
+    return tag;
+}
+
+NANDFTL::TagFields NANDFTL::decodeTag(const Tag& tag) {
+    constexpr size_t SequenceOffset = 4U;
+    constexpr size_t EraseCountOffset = 8U;
+
+    return TagFields { LittleEndian::loadWord(tag, 0U), LittleEndian::loadWord(tag, SequenceOffset),
+                       LittleEndian::loadWord(tag, EraseCountOffset) };
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::prepare() {
+    if (mounted) {
+        return etl::unexpected(NANDErrorCode::ALREADY_INITIALIZED);
+    }
+
+    if (auto badResult = nand.isBlockBad(0U); not badResult.has_value()) {
+        return etl::unexpected(badResult.error());
+    }
+
+    if (mapping.empty() or (mapping.size() > getMaxSectorCount())) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    etl::fill(mapping.begin(), mapping.end(), UnmappedPage);
+    validPages.fill(0U);
+    writtenPages.fill(0U);
+    blockMinSequence.fill(UINT32_MAX);
+    blockMaxSequence.fill(0U);
+    eraseCounts.fill(0U);
+    erasedPool.clear();
+    dirtyPool.clear();
+    retiringBlocks.reset();
+    erasesSinceWearCheck = 0U;
+    lastAllocatedPlane = 0U;
+    collectingBlock = NoBlock;
+    collectionPage = 0U;
+    scrubBlock = 0U;
+    scrubPage = 0U;
+    refreshBlock = NoBlock;
+    correctingBlock = NoBlock;
+    readCounts.fill(0U);
+    isPreErasing = false;
+    isCollectingInBackground = false;
+    hostBlock = NoBlock;
+    relocationBlocks.fill(NoBlock);
+    sequence = 0U;
+    statistics = Statistics{};
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::scanBlock(uint16_t block, bool& isEraseCountKnown) {
+    for (uint8_t page = 0U; page < PagesPerBlock; page++) {
+        const uint32_t PhysicalPage = (static_cast<uint32_t>(block) * PagesPerBlock) + page;
+        Tag tag;
+
+        auto tagResult = nand.readPageMetadataEcc(toAddress(PhysicalPage), tag);
+
+        if (not tagResult.has_value()) {
+            if (tagResult.error() != NANDErrorCode::ECC_UNCORRECTABLE) {
+                return etl::unexpected(tagResult.error());
+            }
+
+            writtenPages[block] = page + 1U;
+            continue;
+        }
+
+        if (tagResult->isErased) {
+            break;
+        }
+
+        writtenPages[block] = page + 1U;
+
+        const TagFields Fields = decodeTag(tag);
+
+        if (page == 0U) {
+            eraseCounts[block] = Fields.eraseCount;
+            isEraseCountKnown = true;
+        }
+
+        sequence = etl::max(sequence, Fields.sequence);
+
+        if ((Fields.sector < mapping.size()) and isNewerCopy(Fields.sector, Fields.sequence)) {
+            setMapping(Fields.sector, PhysicalPage, Fields.sequence);
+        }
+
+        blockMinSequence[block] = etl::min(blockMinSequence[block], Fields.sequence);
+        blockMaxSequence[block] = etl::max(blockMaxSequence[block], Fields.sequence);
+    }
+
+    return {};
+}
+
+bool NANDFTL::isNewerCopy(uint32_t sector, uint32_t tagSequence) {
+    const uint32_t CurrentPage = mapping[sector];
+
+    if (CurrentPage == UnmappedPage) {
+        return true;
+    }
+
+    const uint16_t CurrentBlock = CurrentPage / PagesPerBlock;
+
+    if (tagSequence > blockMaxSequence[CurrentBlock]) {
+        return true;
+    }
+
+    if (tagSequence < blockMinSequence[CurrentBlock]) {
+        return false;
+    }
+
+    /* Sequence ranges overlap (relocated pages keep their sequence): compare with the mapped copy */
+    Tag currentTag;
+
+    if (not nand.readPageMetadataEcc(toAddress(CurrentPage), currentTag).has_value()) {
+        return true;
+    }
+
+    return tagSequence > decodeTag(currentTag).sequence;
+}
+
+void NANDFTL::estimateEraseCounts(const etl::bitset<BlockCount>& knownEraseCounts) {
+    uint64_t total = 0U;
+    uint16_t known = 0U;
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        if (knownEraseCounts.test(block)) {
+            total += eraseCounts[block];
+            known++;
+        }
+    }
+
+    const uint32_t Mean = (known > 0U) ? static_cast<uint32_t>(total / known) : 0U;
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        if (not knownEraseCounts.test(block)) {
+            eraseCounts[block] = Mean;
+        }
+    }
+}
+
+void NANDFTL::setMapping(uint32_t sector, uint32_t physicalPage, uint32_t tagSequence) {
+    const uint32_t PreviousPage = mapping[sector];
+
+    if (PreviousPage != UnmappedPage) {
+        validPages[PreviousPage / PagesPerBlock]--;
+    }
+
+    if (physicalPage == UnmappedPage) {
+        mapping[sector] = UnmappedPage;
+        return;
+    }
+
+    const uint16_t Block = physicalPage / PagesPerBlock;
+
+    mapping[sector] = physicalPage;
+    validPages[Block]++;
+    blockMinSequence[Block] = etl::min(blockMinSequence[Block], tagSequence);
+    blockMaxSequence[Block] = etl::max(blockMaxSequence[Block], tagSequence);
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::recordMapping(uint32_t sector, uint32_t physicalPage,
+                                                          uint32_t tagSequence) {
+    setMapping(sector, physicalPage, tagSequence);
+
+    return appendJournal(NANDFTLJournal::Record { sector, physicalPage, tagSequence });
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::appendJournal(const NANDFTLJournal::Record& record) {
+    if (journal == nullptr) {
+        return {};
+    }
+
+    if (journal->isFull()) {
+        if (auto checkpointResult = checkpoint(); not checkpointResult.has_value()) {
+            return checkpointResult;
+        }
+    }
+
+    return journal->append(record);
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::loadJournal() {
+    constexpr uint32_t PhysicalPageCount = static_cast<uint32_t>(BlockCount) * PagesPerBlock;
+
+    auto loadResult = journal->load(mapping, blockMaxSequence, eraseCounts);
+
+    if (not loadResult.has_value()) {
+        return etl::unexpected(loadResult.error());
+    }
+
+    for (const uint32_t PhysicalPage : mapping) {
+        if (PhysicalPage == UnmappedPage) {
+            continue;
+        }
+
+        if ((PhysicalPage >= PhysicalPageCount) or (validPages[PhysicalPage / PagesPerBlock] == PagesPerBlock)) {
+            return etl::unexpected(NANDErrorCode::JOURNAL_INVALID);
+        }
+
+        validPages[PhysicalPage / PagesPerBlock]++;
+    }
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        const bool IsBad = nand.isBlockBad(block).value_or(true);
+
+        if ((validPages[block] > 0U) and IsBad) {
+            return etl::unexpected(NANDErrorCode::JOURNAL_INVALID);
+        }
+
+        if (IsBad) {
+            continue;
+        }
+
+        if (validPages[block] == 0U) {
+            dirtyPool.insert(block);
+        } else {
+            /* Write pointers are not journaled: close the block, collection skips its erased pages */
+            writtenPages[block] = PagesPerBlock;
+        }
+    }
+
+    /* A host write may have been programmed but not journaled before a reset: do not reuse its sequence */
+    sequence = *loadResult + 1U;
+
+    return {};
+}
+
+
+/* ============= Block Allocation ============= */
+
+etl::expected<uint16_t, NANDErrorCode> NANDFTL::allocateBlock(uint8_t plane, BlockUse use) {
+    const bool MayCollect = (use == BlockUse::HOST_DATA);
+
+    while (MayCollect and (getFreeBlockCount() < GcThresholdBlocks)) {
+        const uint32_t StartCycles = MT29F::readCycleCounter();
+        auto collectResult = collectGarbage();
+
+        recordStall(statistics.foregroundCollectionUs, StartCycles);
+
+        if (not collectResult.has_value()) {
+            if ((collectResult.error() != NANDErrorCode::NO_SPACE) or (getFreeBlockCount() == 0U)) {
+                return etl::unexpected(collectResult.error());
+            }
+
+            break;
+        }
+
+        statistics.foregroundCollections++;
+    }
+
+    if (MayCollect and (erasesSinceWearCheck >= StaticWearCheckInterval) and
+        (getFreeBlockCount() >= GcThresholdBlocks)) {
+        if (auto levelResult = levelWear(); not levelResult.has_value()) {
+            return etl::unexpected(levelResult.error());
+        }
+    }
+
+    while (getFreeBlockCount() > 0U) {
+        uint16_t block = pickBlock(erasedPool, plane, use);
+
+        if (block != NoBlock) {
+            erasedPool.remove(block);
+        } else {
+            block = pickBlock(dirtyPool, plane, use);
+
+            if (block == NoBlock) {
+                break;
+            }
+
+            dirtyPool.remove(block);
+
+            const uint32_t StartCycles = MT29F::readCycleCounter();
+            auto eraseResult = eraseFreeBlock(block);
+
+            recordStall(statistics.foregroundEraseUs, StartCycles);
+
+            if (not eraseResult.has_value()) {
+                dirtyPool.insert(block);
+                return etl::unexpected(eraseResult.error());
+            }
+
+            if (not *eraseResult) {
+                continue;
+            }
+
+            statistics.foregroundErases++;
+        }
+
+        lastAllocatedPlane = block % PlaneCount;
+        writtenPages[block] = 0U;
+        validPages[block] = 0U;
+        blockMinSequence[block] = UINT32_MAX;
+        blockMaxSequence[block] = 0U;
+
+        return block;
+    }
+
+    return etl::unexpected(NANDErrorCode::NO_SPACE);
+}
+
+uint16_t NANDFTL::pickBlock(const FreeBlockPool& pool, uint8_t plane, BlockUse use) const {
+    if (use == BlockUse::COLD_DATA) {
+        uint16_t block = NoBlock;
+
+        for (uint8_t candidate = 0U; candidate < PlaneCount; candidate++) {
+            const uint16_t MostWorn = pool.findMostWorn(candidate);
+
+            if (((plane == PlaneCount) or (candidate == plane)) and (MostWorn != NoBlock) and
+                ((block == NoBlock) or (eraseCounts[MostWorn] > eraseCounts[block]))) {
+                block = MostWorn;
+            }
+        }
+
+        return block;
+    }
+
+    if (plane != PlaneCount) {
+        return pool.peekLeastWorn(plane);
+    }
+
+    const uint16_t Preferred = pool.peekLeastWorn(lastAllocatedPlane ^ 1U);
+    const uint16_t Other = pool.peekLeastWorn(lastAllocatedPlane);
+
+    return ((Preferred == NoBlock) or ((Other != NoBlock) and (eraseCounts[Other] < eraseCounts[Preferred])))
+               ? Other
+               : Preferred;
+}
+
+etl::expected<bool, NANDErrorCode> NANDFTL::eraseFreeBlock(uint16_t block) {
+    if (auto eraseResult = nand.eraseBlock(block); not eraseResult.has_value()) {
+        if (eraseResult.error() != NANDErrorCode::ERASE_FAILED) {
+            return etl::unexpected(eraseResult.error());
+        }
+
+        LOG_ERROR << "FTL: Erase failed, retiring block " << block;
+        (void) nand.markBadBlock(block);
+        statistics.retiredBlocks++;
+        return false;
+    }
+
+    if (auto recordResult = recordErase(block); not recordResult.has_value()) {
+        return etl::unexpected(recordResult.error());
+    }
+
+    return true;
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::preEraseBlocks() {
+    const uint16_t Even = dirtyPool.peekLeastWorn(0U);
+    const uint16_t Odd = dirtyPool.peekLeastWorn(1U);
+
+    if ((Even != NoBlock) and (Odd != NoBlock)) {
+        dirtyPool.remove(Even);
+        dirtyPool.remove(Odd);
+
+        auto eraseResult = nand.eraseBlockMultiPlane(Even, Odd);
+
+        if (eraseResult.has_value()) {
+            const etl::array<uint16_t, PlaneCount> Pair = { Even, Odd };
+
+            statistics.multiPlaneErases++;
+
+            for (size_t index = 0U; index < Pair.size(); index++) {
+                statistics.backgroundErases++;
+
+                if (auto recordResult = recordErase(Pair[index]); not recordResult.has_value()) {
+                    /* Without a journaled erase count, the blocks not recorded yet are erased again later */
+                    for (; index < Pair.size(); index++) {
+                        dirtyPool.insert(Pair[index]);
+                    }
+
+                    return recordResult;
+                }
+
+                erasedPool.insert(Pair[index]);
+            }
+
+            return {};
+        }
+
+        /* The status does not tell which block failed: fall back to single erases */
+        dirtyPool.insert(Even);
+        dirtyPool.insert(Odd);
+
+        if (eraseResult.error() != NANDErrorCode::MULTIPLANE_FAILED) {
+            return eraseResult;
+        }
+    }
+
+    for (const uint16_t Block : { Even, Odd }) {
+        if (Block == NoBlock) {
+            continue;
+        }
+
+        dirtyPool.remove(Block);
+
+        auto eraseResult = eraseFreeBlock(Block);
+
+        if (not eraseResult.has_value()) {
+            dirtyPool.insert(Block);
+            return etl::unexpected(eraseResult.error());
+        }
+
+        if (*eraseResult) {
+            statistics.backgroundErases++;
+            erasedPool.insert(Block);
+        }
+    }
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::recordErase(uint16_t block) {
+    statistics.blockErases++;
+    eraseCounts[block]++;
+    readCounts[block] = 0U;
+
+    if (erasesSinceWearCheck < StaticWearCheckInterval) {
+        erasesSinceWearCheck++;
+    }
+
+    return appendJournal(NANDFTLJournal::Record { NANDFTLJournal::EraseRecordSector, block, eraseCounts[block] });
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::levelWear() {
+    erasesSinceWearCheck = 0U;
+
+    uint16_t coldest = NoBlock;
+    uint32_t mostWorn = 0U;
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        if (nand.isBlockBad(block).value_or(true)) {
+            continue;
+        }
+
+        mostWorn = etl::max(mostWorn, eraseCounts[block]);
+
+        if (isFreeBlock(block) or isOpenBlock(block) or (writtenPages[block] == 0U) or retiringBlocks.test(block)) {
+            continue;
+        }
+
+        if ((coldest == NoBlock) or (eraseCounts[block] < eraseCounts[coldest])) {
+            coldest = block;
+        }
+    }
+
+    if ((coldest == NoBlock) or ((mostWorn - eraseCounts[coldest]) <= StaticWearThreshold)) {
+        return {};
+    }
+
+    statistics.wearLevelingMigrations++;
+
+    isMigratingColdData = true;
+    auto collectResult = collectBlock(coldest);
+    isMigratingColdData = false;
+
+    /* More cold blocks may lag behind: check again at the next allocation */
+    erasesSinceWearCheck = StaticWearCheckInterval;
+
+    return collectResult;
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::releaseBlock(uint16_t block) {
+    if (retiringBlocks.test(block)) {
+        retiringBlocks.reset(block);
+        (void) nand.markBadBlock(block);
+        statistics.retiredBlocks++;
+        return {};
+    }
+
+    if (isBackgroundEnabled) {
+        dirtyPool.insert(block);
+        return {};
+    }
+
+    const uint32_t StartCycles = MT29F::readCycleCounter();
+    auto eraseResult = eraseFreeBlock(block);
+
+    recordStall(statistics.foregroundEraseUs, StartCycles);
+
+    if (not eraseResult.has_value()) {
+        dirtyPool.insert(block);
+        return etl::unexpected(eraseResult.error());
+    }
+
+    if (*eraseResult) {
+        statistics.foregroundErases++;
+        erasedPool.insert(block);
+    }
+
+    return {};
+}
+
+void NANDFTL::recordStall(uint64_t& totalUs, uint32_t startCycles) {
+    const uint32_t ElapsedUs = MT29F::getElapsedMicroseconds(startCycles);
+
+    totalUs += ElapsedUs;
+    statistics.maxForegroundStallUs = etl::max(statistics.maxForegroundStallUs, ElapsedUs);
+}
+
+void NANDFTL::retireBlock(uint16_t block) {
+    LOG_ERROR << "FTL: Program failed, retiring block " << block;
+
+    retiringBlocks.set(block);
+    closeBlock(block);
+}
+
+void NANDFTL::closeBlock(uint16_t block) {
+    if (block == hostBlock) {
+        hostBlock = NoBlock;
+    }
+
+    for (auto& relocationBlock : relocationBlocks) {
+        if (relocationBlock == block) {
+            relocationBlock = NoBlock;
+        }
+    }
+}
+
+
+/* ============= Garbage Collection ============= */
+
+etl::expected<void, NANDErrorCode> NANDFTL::collectGarbage() {
+    if (collectingBlock != NoBlock) {
+        return continueCollection(PagesPerBlock);
+    }
+
+    const uint16_t Victim = selectVictim();
+
+    if (Victim == NoBlock) {
+        return etl::unexpected(NANDErrorCode::NO_SPACE);
+    }
+
+    return collectBlock(Victim);
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::collectBlock(uint16_t victim) {
+    if ((collectingBlock != NoBlock) and (collectingBlock != victim)) {
+        if (auto finishResult = continueCollection(PagesPerBlock); not finishResult.has_value()) {
+            return finishResult;
+        }
+    }
+
+    if (collectingBlock != victim) {
+        collectingBlock = victim;
+        collectionPage = 0U;
+    }
+
+    return continueCollection(PagesPerBlock);
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::continueCollection(uint8_t maxPages) {
+    const uint16_t Victim = collectingBlock;
+
+    for (uint8_t examined = 0U; (examined < maxPages) and (collectionPage < writtenPages[Victim]) and
+                                (validPages[Victim] > 0U);
+         examined++) {
+        const uint32_t PhysicalPage = (static_cast<uint32_t>(Victim) * PagesPerBlock) + collectionPage;
+        Tag tag;
+
+        auto tagResult = nand.readPageMetadataEcc(toAddress(PhysicalPage), tag);
+
+        if (not tagResult.has_value()) {
+            if (tagResult.error() != NANDErrorCode::ECC_UNCORRECTABLE) {
+                return etl::unexpected(tagResult.error());
+            }
+
+            collectionPage++;
+            continue;
+        }
+
+        const TagFields Fields = decodeTag(tag);
+
+        if ((Fields.sector < mapping.size()) and (mapping[Fields.sector] == PhysicalPage)) {
+            if (auto relocateResult = relocatePage(PhysicalPage, Fields.sector, Fields.sequence,
+                                                   tagResult->maxCorrectedBits);
+                not relocateResult.has_value()) {
+                return relocateResult;
+            }
+        }
+
+        collectionPage++;
+    }
+
+    if ((collectionPage < writtenPages[Victim]) and (validPages[Victim] > 0U)) {
+        return {};
+    }
+
+    if (validPages[Victim] > 0U) {
+        /* Valid pages whose metadata could not be read: their data is lost */
+        for (uint32_t sector = 0U; sector < mapping.size(); sector++) {
+            if ((mapping[sector] != UnmappedPage) and ((mapping[sector] / PagesPerBlock) == Victim)) {
+                LOG_ERROR << "FTL: Unreadable page " << mapping[sector] << " dropped";
+                statistics.droppedPages++;
+
+                if (auto recordResult = recordMapping(sector, UnmappedPage, sequence); not recordResult.has_value()) {
+                    return recordResult;
+                }
+            }
+        }
+    }
+
+    collectingBlock = NoBlock;
+    statistics.garbageCollections++;
+
+    if (Victim == refreshBlock) {
+        refreshBlock = NoBlock;
+        correctingBlock = NoBlock;
+    }
+
+    return releaseBlock(Victim);
+}
+
+uint16_t NANDFTL::selectVictim() const {
+    uint16_t victim = NoBlock;
+    uint64_t bestScore = 0U;
+
+    for (uint16_t block = 0U; block < BlockCount; block++) {
+        if (isFreeBlock(block) or isOpenBlock(block) or (block == collectingBlock) or (writtenPages[block] == 0U)
+            or nand.isBlockBad(block).value_or(true)) {
+            continue;
+        }
+
+        const uint8_t Valid = validPages[block];
+
+        if (retiringBlocks.test(block) or (Valid == 0U)) {
+            return block;
+        }
+
+        if (Valid == PagesPerBlock) {
+            continue;
+        }
+
+        const uint64_t Reclaimed = PagesPerBlock - Valid;
+        uint64_t score = Reclaimed;
+
+        if (policy == GcPolicy::COST_BENEFIT) {
+            const uint64_t Age = sequence - blockMaxSequence[block] + 1U;
+
+            score = (Age * Reclaimed * PagesPerBlock) / (2U * Valid);
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            victim = block;
+        }
+    }
+
+    return victim;
+}
+
+etl::expected<void, NANDErrorCode> NANDFTL::relocatePage(uint32_t physicalPage, uint32_t sector, uint32_t tagSequence,
+                                                         uint8_t correctedBits) {
+    const uint8_t SourcePlane = (physicalPage / PagesPerBlock) % PlaneCount;
+
+    for (uint8_t attempt = 0U; attempt < MaxProgramAttempts; attempt++) {
+        uint8_t plane = SourcePlane;
+
+        /* Without a free block in the source plane, move through RAM into the other plane */
+        for (uint8_t candidate = 0U; (candidate < PlaneCount) and (relocationBlocks[plane] == NoBlock); candidate++) {
+            plane = (SourcePlane + candidate) % PlaneCount;
+
+            if (relocationBlocks[plane] != NoBlock) {
+                break;
+            }
+
+            auto allocateResult = allocateBlock(plane, isMigratingColdData ? BlockUse::COLD_DATA
+                                                                           : BlockUse::RELOCATED_DATA);
+
+            if (allocateResult.has_value()) {
+                relocationBlocks[plane] = *allocateResult;
+            } else if (allocateResult.error() != NANDErrorCode::NO_SPACE) {
+                return etl::unexpected(allocateResult.error());
+            }
+        }
+
+        if (relocationBlocks[plane] == NoBlock) {
+            return etl::unexpected(NANDErrorCode::NO_SPACE);
+        }
+
+        const uint16_t Destination = relocationBlocks[plane];
+        const uint32_t DestinationPage = (static_cast<uint32_t>(Destination) * PagesPerBlock) + writtenPages[Destination];
+        /* Page 0 goes through RAM to store the erase count of the destination */
+        const bool UseCopyback = (plane == SourcePlane) and (correctedBits <= CopybackMaxCorrectedBits) and
+                                 (writtenPages[Destination] != 0U) and
+                                 ((physicalPage / PagesPerBlock) != correctingBlock);
+
+        etl::expected<void, NANDErrorCode> moveResult;
+
+        if (UseCopyback) {
+            moveResult = nand.copyback(toAddress(physicalPage), toAddress(DestinationPage));
+        } else {
+            auto readResult = nand.readPageEcc(toAddress(physicalPage), pageBuffer);
+
+            if (not readResult.has_value()) {
+                if (readResult.error() != NANDErrorCode::ECC_UNCORRECTABLE) {
+                    return etl::unexpected(readResult.error());
+                }
+
+                /* The data is lost either way, dropping the page lets the collection complete */
+                LOG_ERROR << "FTL: Uncorrectable page " << physicalPage << " dropped";
+                statistics.droppedPages++;
+
+                return recordMapping(sector, UnmappedPage, tagSequence);
+            }
+
+            moveResult = nand.programPageEcc(toAddress(DestinationPage), pageBuffer,
+                                             encodeTag(TagFields { sector, tagSequence, eraseCounts[Destination] }));
+        }
+
+        writtenPages[Destination]++;
+
+        if (moveResult.has_value()) {
+            if (UseCopyback) {
+                statistics.copybackMoves++;
+            } else {
+                statistics.hostMoves++;
+            }
+
+            if (writtenPages[Destination] == PagesPerBlock) {
+                relocationBlocks[plane] = NoBlock;
+            }
+
+            return recordMapping(sector, DestinationPage, tagSequence);
+        }
+
+        if ((moveResult.error() != NANDErrorCode::PROGRAM_FAILED) and (moveResult.error() != NANDErrorCode::COPYBACK_FAILED)) {
+            return moveResult;
+        }
+
+        retireBlock(Destination);
+    }
+
+    return etl::unexpected(NANDErrorCode::PROGRAM_FAILED);
+}
+
+
+/* ============= Scrubbing ============= */
+
+etl::expected<uint8_t, NANDErrorCode> NANDFTL::checkScrubPages() {
+    uint8_t checked = 0U;
+    uint16_t visitedBlocks = 0U;
+
+    while ((checked < scrubSettings.pagesPerStep) and (refreshBlock == NoBlock) and (visitedBlocks <= BlockCount)) {
+        if ((scrubPage >= writtenPages[scrubBlock]) or not holdsData(scrubBlock)) {
+            scrubBlock++;
+            scrubPage = 0U;
+            visitedBlocks++;
+
+            if (scrubBlock == BlockCount) {
+                scrubBlock = 0U;
+                statistics.scrubPasses++;
+            }
+
+            continue;
+        }
+
+        const uint16_t Block = scrubBlock;
+        auto readResult = nand.readPageEcc(toAddress((static_cast<uint32_t>(Block) * PagesPerBlock) + scrubPage),
+                                           pageBuffer);
+
+        scrubPage++;
+        checked++;
+        statistics.scrubbedPages++;
+
+        if (not readResult.has_value()) {
+            if (readResult.error() != NANDErrorCode::ECC_UNCORRECTABLE) {
+                return etl::unexpected(readResult.error());
+            }
+
+            LOG_ERROR << "FTL: Scrub found uncorrectable page " << scrubPage - 1U << " in block " << Block;
+            statistics.scrubUncorrectablePages++;
+        }
+
+        if (not readResult.has_value() or (readResult->maxCorrectedBits >= scrubSettings.refreshCorrectedBits) or
+            (nand.getReadRetryOption(Block) != 0U)) {
+            LOG_INFO << "FTL: Scrub refreshing block " << Block;
+
+            startRefresh(Block, true);
+            statistics.scrubRefreshes++;
+
+            /* The rest of the block is about to move */
+            scrubPage = writtenPages[Block];
+        }
+    }
+
+    return checked;
+}
+
+void NANDFTL::startRefresh(uint16_t block, bool isCorrecting) {
+    refreshBlock = block;
+
+    if (isCorrecting) {
+        correctingBlock = block;
+    }
+}
@@ -0,0 +1,358 @@
+#include "NANDFTLJournal.hpp"
+#include "LittleEndian.hpp"
+#include <etl/algorithm.h>
+
+/* ============= Public Interface ============= */
+
+etl::expected<void, NANDErrorCode> NANDFTLJournal::create(etl::span<const uint32_t> mapping,
+                                                          etl::span<const uint32_t> blockSequences,
+                                                          etl::span<const uint32_t> eraseCounts, uint32_t sequence) {
+    isLoaded = false;
+
+    if (not fitsRegion(mapping.size(), blockSequences.size(), eraseCounts.size())) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    sectorCount = mapping.size();
+
+    if (auto writeResult = writeWords(BlockTableOffset, blockSequences); not writeResult.has_value()) {
+        return writeResult;
+    }
+
+    if (auto writeResult = writeWords(EraseCountTableOffset, eraseCounts); not writeResult.has_value()) {
+        return writeResult;
+    }
+
+    if (auto writeResult = writeWords(ImageOffset, mapping); not writeResult.has_value()) {
+        return writeResult;
+    }
+
+    /* Continue from the generation already in MRAM, so that its records can never be replayed */
+    HeaderSlot slot;
+    generation = 0U;
+    headerSlot = 0U;
+
+    for (uint8_t index = 0U; index < 2U; index++) {
+        if (auto readResult = readBytes(index * HeaderSlotBytes, slot); not readResult.has_value()) {
+            return readResult;
+        }
+
+        const uint32_t SlotGeneration = LittleEndian::loadWord(slot, HeaderGenerationOffset);
+
+        if (etl::equal(HeaderMagic.begin(), HeaderMagic.end(), slot.begin()) and (SlotGeneration >= generation)) {
+            generation = SlotGeneration;
+            headerSlot = index;
+        }
+    }
+
+    if (auto commitResult = commitHeader(sequence); not commitResult.has_value()) {
+        return commitResult;
+    }
+
+    journalLength = 0U;
+    isLoaded = true;
+
+    return {};
+}
+
+etl::expected<uint32_t, NANDErrorCode> NANDFTLJournal::load(etl::span<uint32_t> mapping,
+                                                            etl::span<uint32_t> blockSequences,
+                                                            etl::span<uint32_t> eraseCounts) {
+    isLoaded = false;
+
+    if (not fitsRegion(mapping.size(), blockSequences.size(), eraseCounts.size())) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    sectorCount = mapping.size();
+
+    uint32_t sequence = 0U;
+    bool isHeaderFound = false;
+
+    for (uint8_t index = 0U; index < 2U; index++) {
+        HeaderSlot slot;
+
+        if (auto readResult = readBytes(index * HeaderSlotBytes, slot); not readResult.has_value()) {
+            return etl::unexpected(readResult.error());
+        }
+
+        uint32_t slotSequence = 0U;
+        auto headerResult = parseHeader(slot, slotSequence);
+
+        if (headerResult.has_value() and ((not isHeaderFound) or (*headerResult > generation))) {
+            isHeaderFound = true;
+            generation = *headerResult;
+            headerSlot = index;
+            sequence = slotSequence;
+        }
+    }
+
+    if (not isHeaderFound) {
+        return etl::unexpected(NANDErrorCode::JOURNAL_INVALID);
+    }
+
+    if (auto readResult = readWords(BlockTableOffset, blockSequences); not readResult.has_value()) {
+        return etl::unexpected(readResult.error());
+    }
+
+    if (auto readResult = readWords(EraseCountTableOffset, eraseCounts); not readResult.has_value()) {
+        return etl::unexpected(readResult.error());
+    }
+
+    if (auto readResult = readWords(ImageOffset, mapping); not readResult.has_value()) {
+        return etl::unexpected(readResult.error());
+    }
+
+    journalLength = 0U;
+
+    while (journalLength < journalCapacity) {
+        RecordBytesArray bytes;
+        Record record{};
+
+        if (auto readResult = readBytes(getJournalOffset() + (journalLength * RecordBytes), bytes);
+            not readResult.has_value()) {
+            return etl::unexpected(readResult.error());
+        }
+
+        if (not decodeRecord(bytes, record)) {
+            break;
+        }
+
+        if (record.sector == EraseRecordSector) {
+            if (record.physicalPage < BlockCount) {
+                eraseCounts[record.physicalPage] = record.sequence;
+            }
+
+            journalLength++;
+            continue;
+        }
+
+        if (record.sector >= sectorCount) {
+            break;
+        }
+
+        mapping[record.sector] = record.physicalPage;
+
+        const uint32_t Block = record.physicalPage / MT29F::PagesPerBlock;
+
+        if (Block < BlockCount) {
+            blockSequences[Block] = etl::max(blockSequences[Block], record.sequence);
+        }
+
+        sequence = etl::max(sequence, record.sequence);
+        journalLength++;
+    }
+
+    isLoaded = true;
+
+    return sequence;
+}
+
+etl::expected<void, NANDErrorCode> NANDFTLJournal::append(const Record& record) {
+    if (not isLoaded) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (isFull()) {
+        return etl::unexpected(NANDErrorCode::NO_SPACE);
+    }
+
+    if (auto writeResult = writeBytes(getJournalOffset() + (journalLength * RecordBytes), encodeRecord(record));
+        not writeResult.has_value()) {
+        return writeResult;
+    }
+
+    journalLength++;
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDFTLJournal::checkpoint(etl::span<const uint32_t> mapping,
+                                                              etl::span<const uint32_t> blockSequences,
+                                                              etl::span<const uint32_t> eraseCounts,
+                                                              uint32_t sequence) {
+    if (not isLoaded) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (not fitsRegion(mapping.size(), blockSequences.size(), eraseCounts.size()) or (mapping.size() != sectorCount)) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    for (uint32_t index = 0U; index < journalLength; index++) {
+        RecordBytesArray bytes;
+        Record record{};
+
+        if (auto readResult = readBytes(getJournalOffset() + (index * RecordBytes), bytes); not readResult.has_value()) {
+            return readResult;
+        }
+
+        if (not decodeRecord(bytes, record) or (record.sector >= sectorCount)) {
+            continue;
+        }
+
+        if (auto writeResult = writeWords(ImageOffset + (record.sector * sizeof(uint32_t)),
+                                          mapping.subspan(record.sector, 1U));
+            not writeResult.has_value()) {
+            return writeResult;
+        }
+    }
+
+    if (auto writeResult = writeWords(BlockTableOffset, blockSequences); not writeResult.has_value()) {
+        return writeResult;
+    }
+
+    if (auto writeResult = writeWords(EraseCountTableOffset, eraseCounts); not writeResult.has_value()) {
+        return writeResult;
+    }
+
+    if (auto commitResult = commitHeader(sequence); not commitResult.has_value()) {
+        return commitResult;
+    }
+
+    journalLength = 0U;
+
+    return {};
+}
+
+
+/* ============= Layout ============= */
+
+bool NANDFTLJournal::fitsRegion(size_t mappingSize, size_t blockSequencesSize, size_t eraseCountsSize) const {
+    constexpr uint64_t MaxMappingSize = UINT32_MAX / sizeof(uint32_t);
+
+    return (mappingSize > 0U) and (mappingSize <= MaxMappingSize) and (blockSequencesSize == BlockCount) and
+           (eraseCountsSize == BlockCount) and
+           (journalCapacity > 0U) and
+           (static_cast<uint64_t>(getRequiredBytes(0U, 0U)) + (mappingSize * sizeof(uint32_t)) +
+                (static_cast<uint64_t>(journalCapacity) * RecordBytes) <=
+            regionBytes);
+}
+
+etl::expected<void, NANDErrorCode> NANDFTLJournal::commitHeader(uint32_t sequence) {
+    HeaderSlot slot{};
+
+    generation++;
+    headerSlot ^= 1U;
+
+    etl::copy(HeaderMagic.begin(), HeaderMagic.end(), slot.begin());
+    LittleEndian::storeWord(slot, HeaderSectorCountOffset, sectorCount);
+    LittleEndian::storeWord(slot, HeaderCapacityOffset, journalCapacity);
+    LittleEndian::storeWord(slot, HeaderGenerationOffset, generation);
+    LittleEndian::storeWord(slot, HeaderSequenceOffset, sequence);
+
+    const uint16_t Crc = MT29F::computeCrc16(etl::span<const uint8_t>(slot).first(HeaderCrcOffset));
+    LittleEndian::storeHalfWord(slot, HeaderCrcOffset, Crc);
+
+    return writeBytes(headerSlot * HeaderSlotBytes, slot);
+}
+
+etl::expected<uint32_t, NANDErrorCode> NANDFTLJournal::parseHeader(const HeaderSlot& slot, uint32_t& sequence) const {
+    const uint16_t StoredCrc = LittleEndian::loadHalfWord(slot, HeaderCrcOffset);
+
+    if (not etl::equal(HeaderMagic.begin(), HeaderMagic.end(), slot.begin()) or
+        (MT29F::computeCrc16(etl::span<const uint8_t>(slot).first(HeaderCrcOffset)) != StoredCrc) or
+        (LittleEndian::loadWord(slot, HeaderSectorCountOffset) != sectorCount) or
+        (LittleEndian::loadWord(slot, HeaderCapacityOffset) != journalCapacity)) {
+        return etl::unexpected(NANDErrorCode::JOURNAL_INVALID);
+    }
+
+    sequence = LittleEndian::loadWord(slot, HeaderSequenceOffset);
+
+    return LittleEndian::loadWord(slot, HeaderGenerationOffset);
+}
+
+NANDFTLJournal::RecordBytesArray NANDFTLJournal::encodeRecord(const Record& record) const {
+    RecordBytesArray bytes{};
+
+    LittleEndian::storeWord(bytes, 0U, record.sector);
+    LittleEndian::storeWord(bytes, RecordPageOffset, record.physicalPage);
+    LittleEndian::storeWord(bytes, RecordSequenceOffset, record.sequence);
+
+    /* The upper half of the generation is only covered by the CRC */
+    LittleEndian::storeWord(bytes, RecordGenerationOffset, generation);
+
+    const uint16_t Crc = MT29F::computeCrc16(bytes);
+    LittleEndian::storeHalfWord(bytes, RecordCrcOffset, Crc);
+
+    return bytes;
+}
+
+bool NANDFTLJournal::decodeRecord(const RecordBytesArray& bytes, Record& record) const {
+    RecordBytesArray expected = bytes;
+
+    LittleEndian::storeWord(expected, RecordGenerationOffset, generation);
+
+    const uint16_t StoredCrc = LittleEndian::loadHalfWord(bytes, RecordCrcOffset);
+
+    if ((bytes[RecordGenerationOffset] != expected[RecordGenerationOffset]) or
+        (bytes[RecordGenerationOffset + 1U] != expected[RecordGenerationOffset + 1U]) or
+        (MT29F::computeCrc16(expected) != StoredCrc)) {
+        return false;
+    }
+
+    record.sector = LittleEndian::loadWord(bytes, 0U);
+    record.physicalPage = LittleEndian::loadWord(bytes, RecordPageOffset);
+    record.sequence = LittleEndian::loadWord(bytes, RecordSequenceOffset);
+
+    return true;
+}
+
+
+/* ============= MRAM Access ============= */
+
+etl::expected<void, NANDErrorCode> NANDFTLJournal::writeWords(uint32_t offset, etl::span<const uint32_t> words) {
+    etl::array<uint8_t, TransferEntries * sizeof(uint32_t)> bytes;
+
+    for (size_t first = 0U; first < words.size(); first += TransferEntries) {
+        const size_t Count = etl::min(TransferEntries, words.size() - first);
+
+        for (size_t index = 0U; index < Count; index++) {
+            LittleEndian::storeWord(bytes, index * sizeof(uint32_t), words[first + index]);
+        }
+
+        if (auto writeResult = writeBytes(offset + (first * sizeof(uint32_t)),
+                                          etl::span<const uint8_t>(bytes).first(Count * sizeof(uint32_t)));
+            not writeResult.has_value()) {
+            return writeResult;
+        }
+    }
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDFTLJournal::readWords(uint32_t offset, etl::span<uint32_t> words) {
+    etl::array<uint8_t, TransferEntries * sizeof(uint32_t)> bytes;
+
+    for (size_t first = 0U; first < words.size(); first += TransferEntries) {
+        const size_t Count = etl::min(TransferEntries, words.size() - first);
+
+        if (auto readResult = readBytes(offset + (first * sizeof(uint32_t)),
+                                        etl::span<uint8_t>(bytes).first(Count * sizeof(uint32_t)));
+            not readResult.has_value()) {
+            return readResult;
+        }
+
+        for (size_t index = 0U; index < Count; index++) {
+            words[first + index] = LittleEndian::loadWord(bytes, index * sizeof(uint32_t));
+        }
+    }
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDFTLJournal::writeBytes(uint32_t offset, etl::span<const uint8_t> bytes) {
+    if (mram.mramWriteData(baseAddress + offset, bytes) != MRAMError::NONE) {
+        return etl::unexpected(NANDErrorCode::JOURNAL_IO_FAILED);
+    }
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDFTLJournal::readBytes(uint32_t offset, etl::span<uint8_t> bytes) {
+    if (mram.mramReadData(baseAddress + offset, bytes) != MRAMError::NONE) {
+        return etl::unexpected(NANDErrorCode::JOURNAL_IO_FAILED);
+    }
+
+    return {};
+}
@@ -1,7 +1,13 @@
 #include "NANDFlash.hpp"
+#include "LittleEndian.hpp"
 #include <etl/algorithm.h>
+#include <etl/binary.h>
 #include <Logger.hpp>
 
+#if !defined(__arm__)
+#include <chrono>
+#endif
+
 /* ============= Bad Block Management ============= */
 
 etl::expected<uint8_t, NANDErrorCode> MT29F::readBlockMarker(uint16_t block, uint8_t lun) {
@@ -13,7 +19,7 @@ etl::expected<uint8_t, NANDErrorCode> MT29F::readBlockMarker(uint16_t block, uin
 
     uint8_t marker = readData();
     
-    busyWaitNanoseconds(TrhwNs);
+    busyWaitNanoseconds(activeTiming->rhwNs);
 
     return marker;
 }
@@ -34,6 +40,10 @@ etl::expected<void, NANDErrorCode> MT29F::scanFactoryBadBlocks(uint8_t lun) {
         bool readSucceeded = false;
 
         for (uint8_t attempt = 0U; attempt < BlockMarkerReadRetries; attempt++) {
+            if (attempt > 0U) {
+                operationStatistics.retries++;
+            }
+
             readResult = readBlockMarker(block, lun);
 
             if (readResult.has_value()) {
@@ -43,9 +53,7 @@ etl::expected<void, NANDErrorCode> MT29F::scanFactoryBadBlocks(uint8_t lun) {
         }
 
         if ((not readSucceeded) or (readResult.value() == BadBlockMarker)) {
-            if (auto markResult = markBadBlock(block, lun); not markResult.has_value()) {
-                return markResult;
-            }
+            badBlockBitset[lun].set(block);
         }
     }
 
@@ -57,11 +65,224 @@ etl::expected<void, NANDErrorCode> MT29F::markBadBlock(uint16_t block, uint8_t l
         return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
     }
 
+    if (badBlockBitset[lun].test(block)) {
+        return {};
+    }
+
     badBlockBitset[lun].set(block);
+    operationStatistics.badBlocksMarked++;
+
+    if (not isInitialized) {
+        return {};
+    }
+
+    /* The marker keeps the block bad through a rescan, should every copy of the table be lost */
+    if (auto markerResult = programBlockMarker(block, lun); not markerResult.has_value()) {
+        LOG_ERROR << "NAND: Bad block marker could not be programmed in block " << block;
+    }
+
+    return persistBadBlockTable();
+}
+
+etl::expected<void, NANDErrorCode> MT29F::programBlockMarker(uint16_t block, uint8_t lun) {
+    constexpr etl::array<uint8_t, 1> Marker = { BadBlockMarker };
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    return executeProgramCommandSequence(NANDAddress { lun, block, 0U, BlockMarkerOffset }, Marker, {});
+}
+
+etl::expected<void, NANDErrorCode> MT29F::rebuildBadBlockTable() {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    for (uint8_t lun = 0U; lun < LunsPerCe; lun++) {
+        if (auto scanResult = scanFactoryBadBlocks(lun); not scanResult.has_value()) {
+            return scanResult;
+        }
+    }
+
+    return persistBadBlockTable();
+}
+
+
+/* ============= Persistent Bad Block Table ============= */
+
+etl::expected<bool, NANDErrorCode> MT29F::loadBadBlockTable() {
+    BbtRecord record;
+    BbtRecord newestRecord;
+    bool isRecordFound = false;
+    uint32_t newestGeneration = 0U;
+
+    for (uint8_t reserved = 0U; reserved < ReservedBlocksPerLun; reserved++) {
+        const uint16_t Block = UsableBlocksPerLun + reserved;
+
+        auto pageResult = findFirstErasedBbtPage(Block);
+
+        if (not pageResult.has_value()) {
+            return etl::unexpected(pageResult.error());
+        }
+
+        bbtNextPage[reserved] = pageResult.value();
+
+        for (uint8_t page = bbtNextPage[reserved]; page > 0U; page--) {
+            auto recordResult = readBbtRecord(Block, page - 1U, record);
+
+            if (not recordResult.has_value()) {
+                return etl::unexpected(recordResult.error());
+            }
+
+            if (not *recordResult) {
+                continue;
+            }
+
+            const uint32_t Generation = LittleEndian::loadWord(record, BbtGenerationOffset);
+
+            if ((not isRecordFound) or (Generation > newestGeneration)) {
+                newestRecord = record;
+                newestGeneration = Generation;
+                isRecordFound = true;
+            }
+
+            break;
+        }
+    }
+
+    if (not isRecordFound) {
+        return false;
+    }
+
+    for (uint8_t lun = 0U; lun < LunsPerCe; lun++) {
+        badBlockBitset[lun].reset();
+
+        for (uint16_t block = 0U; block < BlocksPerLun; block++) {
+            const uint8_t Byte = newestRecord[BbtBitsetOffset + (lun * BbtBitsetBytes) + (block / 8U)];
+
+            if (((Byte >> (block % 8U)) & 1U) != 0U) {
+                badBlockBitset[lun].set(block);
+            }
+        }
+    }
+
+    bbtGeneration = newestGeneration;
+
+    return true;
+}
+
+etl::expected<void, NANDErrorCode> MT29F::persistBadBlockTable() {
+    BbtRecord record;
+    record.fill(GoodBlockMarker);
+
+    bbtGeneration++;
+
+    etl::copy(BbtMagic.begin(), BbtMagic.end(), record.begin());
+    record[BbtMagic.size()] = BbtVersion;
+    record[BbtMagic.size() + 1U] = LunsPerCe;
+    LittleEndian::storeHalfWord(record, BbtMagic.size() + 2U, BlocksPerLun);
+    LittleEndian::storeWord(record, BbtGenerationOffset, bbtGeneration);
+
+    for (uint8_t lun = 0U; lun < LunsPerCe; lun++) {
+        for (size_t byte = 0U; byte < BbtBitsetBytes; byte++) {
+            uint8_t bits = 0U;
+
+            for (uint8_t bit = 0U; bit < 8U; bit++) {
+                bits |= static_cast<uint8_t>(badBlockBitset[lun].test((byte * 8U) + bit)) << bit;
+            }
+
+            record[BbtBitsetOffset + (lun * BbtBitsetBytes) + byte] = bits;
+        }
+    }
+
+    const uint16_t Crc = computeCrc16(etl::span<const uint8_t>(record).first(BbtCrcOffset));
+    LittleEndian::storeHalfWord(record, BbtCrcOffset, Crc);
+
+    BCHCodec::encode(etl::span<const uint8_t>(record).first(BbtRecordBytes),
+                     etl::span<uint8_t, BCHCodec::ParityBytes>(&record[BbtRecordBytes], BCHCodec::ParityBytes));
+
+    bool isCopyWritten = false;
+
+    for (uint8_t reserved = 0U; reserved < ReservedBlocksPerLun; reserved++) {
+        const uint16_t Block = UsableBlocksPerLun + reserved;
+
+        if (badBlockBitset[0].test(Block)) {
+            continue;
+        }
+
+        if (bbtNextPage[reserved] >= PagesPerBlock) {
+            if (auto eraseResult = eraseBlock(Block); not eraseResult.has_value()) {
+                LOG_ERROR << "NAND: Bad block table block erase failed";
+                badBlockBitset[0].set(Block);
+                continue;
+            }
+
+            bbtNextPage[reserved] = 0U;
+        }
+
+        const NANDAddress Address { 0U, Block, bbtNextPage[reserved], 0U };
+        bbtNextPage[reserved]++;
+
+        if (auto programResult = programPage(Address, record); not programResult.has_value()) {
+            LOG_ERROR << "NAND: Bad block table program failed";
+            badBlockBitset[0].set(Block);
+            continue;
+        }
+
+        isCopyWritten = true;
+    }
+
+    if (not isCopyWritten) {
+        return etl::unexpected(NANDErrorCode::PROGRAM_FAILED);
+    }
 
     return {};
 }
 
+etl::expected<uint8_t, NANDErrorCode> MT29F::findFirstErasedBbtPage(uint16_t block) {
+    uint8_t low = 0U;
+    uint8_t high = PagesPerBlock;
+
+    while (low < high) {
+        const uint8_t Middle = low + ((high - low) / 2U);
+        etl::array<uint8_t, BbtMagic.size()> magic;
+
+        if (auto readResult = readPage(NANDAddress { 0U, block, Middle, 0U }, magic); not readResult.has_value()) {
+            return etl::unexpected(readResult.error());
+        }
+
+        if (countZeroBits(magic, BbtProgrammedZeroBits) > BbtProgrammedZeroBits) {
+            low = Middle + 1U;
+        } else {
+            high = Middle;
+        }
+    }
+
+    return low;
+}
+
+etl::expected<bool, NANDErrorCode> MT29F::readBbtRecord(uint16_t block, uint8_t page, BbtRecord& record) {
+    if (auto readResult = readPage(NANDAddress { 0U, block, page, 0U }, record); not readResult.has_value()) {
+        return etl::unexpected(readResult.error());
+    }
+
+    const etl::span<uint8_t, BCHCodec::ParityBytes> Parity(&record[BbtRecordBytes], BCHCodec::ParityBytes);
+
+    if (not BCHCodec::decode(etl::span<uint8_t>(record).first(BbtRecordBytes), Parity).has_value()) {
+        return false;
+    }
+
+    const uint16_t StoredBlocksPerLun = LittleEndian::loadHalfWord(record, BbtMagic.size() + 2U);
+    const uint16_t StoredCrc = LittleEndian::loadHalfWord(record, BbtCrcOffset);
+
+    return etl::equal(BbtMagic.begin(), BbtMagic.end(), record.begin())
+           and (record[BbtMagic.size()] == BbtVersion)
+           and (record[BbtMagic.size() + 1U] == LunsPerCe)
+           and (StoredBlocksPerLun == BlocksPerLun)
+           and (computeCrc16(etl::span<const uint8_t>(record).first(BbtCrcOffset)) == StoredCrc);
+}
+
 
 /* ============= Write Protection ============= */
 
@@ -118,17 +339,135 @@ etl::expected<void, NANDErrorCode> MT29F::executeReadCommandSequence(const NANDA
 
     sendCommand(Commands::READ_CONFIRM);
     
-    busyWaitNanoseconds(TwbNs);
+    busyWaitNanoseconds(activeTiming->wbNs);
 
-    if (auto waitResult = waitForReady(TimeoutReadUs); not waitResult.has_value()) {
+    if (auto waitResult = waitForReady(TimeoutReadUs, StatusReady | StatusArrayReady, BusyOperation::ARRAY_READ);
+        not waitResult.has_value()) {
         return waitResult;
     }
     
-    busyWaitNanoseconds(TrrNs);
+    busyWaitNanoseconds(activeTiming->rrNs);
+
+    sendCommand(Commands::READ_MODE);
+
+    busyWaitNanoseconds(activeTiming->whrNs);
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::executeProgramCommandSequence(const NANDAddress& address,
+                                                                        etl::span<const uint8_t> data,
+                                                                        etl::span<const uint8_t> trailingData) {
+    const uint16_t Column = static_cast<uint16_t>(address.column);
+    const etl::array<ProgramSegment, 2> Segments = {
+        ProgramSegment { Column, data },
+        ProgramSegment { static_cast<uint16_t>(Column + data.size()), trailingData },
+    };
+
+    return executeProgramCommandSequence(address, etl::span<const ProgramSegment>(Segments.data(), trailingData.empty() ? 1U : 2U));
+}
+
+etl::expected<void, NANDErrorCode> MT29F::executeProgramCommandSequence(const NANDAddress& address,
+                                                                        etl::span<const ProgramSegment> segments) {
+    const NANDAddress StartAddress { address.lun, address.block, address.page, segments[0].column };
+    AddressCycles cycles;
+    buildAddressCycles(StartAddress, cycles);
+
+    {
+        WriteEnableGuard guard(*this);
+
+        if (auto writeEnabledResult = verifyWriteEnabled(); not writeEnabledResult.has_value()) {
+            return writeEnabledResult;
+        }
+
+        sendCommand(Commands::PAGE_PROGRAM);
+
+        for (const auto& cycle : cycles) {
+            sendAddress(cycle);
+        }
+
+        busyWaitNanoseconds(activeTiming->adlNs);
+
+        uint32_t nextColumn = segments[0].column;
+
+        for (const auto& segment : segments) {
+            /* Contiguous segments keep streaming, the column pointer is already there */
+            if (segment.column != nextColumn) {
+                sendColumnChange(Commands::CHANGE_WRITE_COLUMN, segment.column);
+            }
+
+            if (auto transferResult = sendDataBlock(segment.data); not transferResult.has_value()) {
+                return transferResult;
+            }
+
+            nextColumn = segment.column + segment.data.size();
+        }
+
+        sendCommand(Commands::PAGE_PROGRAM_CONFIRM);
+
+        busyWaitNanoseconds(activeTiming->wbNs);
+
+        if (auto waitResult = waitForReady(TimeoutProgramUs, StatusReady | StatusArrayReady, BusyOperation::PROGRAM);
+            not waitResult.has_value()) {
+            return waitResult;
+        }
+    }
+
+    if (hasOperationFailed(readStatusRegister())) {
+        operationStatistics.statusFailures++;
+        return etl::unexpected(NANDErrorCode::PROGRAM_FAILED);
+    }
+
+    return {};
+}
+
+void MT29F::sendColumnChange(Commands command, uint16_t column) {
+    constexpr uint8_t ByteMask = 0xFFU;
+    constexpr uint8_t ColumnHighByteMask = 0x3FU;
+    constexpr uint8_t BitsPerByte = 8U;
+
+    sendCommand(command);
+
+    sendAddress(column & ByteMask);
+
+    sendAddress((column >> BitsPerByte) & ColumnHighByteMask);
+
+    if (command == Commands::CHANGE_READ_COLUMN) {
+        sendCommand(Commands::CHANGE_READ_COLUMN_CONFIRM);
+    }
+
+    busyWaitNanoseconds(TccsNs);
+}
+
+etl::expected<void, NANDErrorCode> MT29F::executeCacheReadCommand(const NANDAddress* nextAddress, bool isSequential) {
+    if (nextAddress == nullptr) {
+        sendCommand(Commands::READ_CACHE_END);
+    } else if (isSequential) {
+        sendCommand(Commands::READ_CACHE_SEQUENTIAL);
+    } else {
+        AddressCycles cycles;
+        buildAddressCycles(*nextAddress, cycles);
+
+        sendCommand(Commands::READ_MODE);
+
+        for (const auto& cycle : cycles) {
+            sendAddress(cycle);
+        }
+
+        sendCommand(Commands::READ_CACHE_SEQUENTIAL);
+    }
+
+    busyWaitNanoseconds(activeTiming->wbNs);
+
+    if (auto waitResult = waitForReady(TimeoutReadUs, StatusReady); not waitResult.has_value()) {
+        return waitResult;
+    }
+
+    busyWaitNanoseconds(activeTiming->rrNs);
 
     sendCommand(Commands::READ_MODE);
 
-    busyWaitNanoseconds(TwhrNs);
+    busyWaitNanoseconds(activeTiming->whrNs);
 
     return {};
 }
@@ -141,13 +480,13 @@ void MT29F::readDeviceID(etl::span<uint8_t, 5> id) {
     
     sendAddress(static_cast<uint8_t>(ReadIDAddress::MANUFACTURER_ID));
     
-    busyWaitNanoseconds(TwhrNs);
+    busyWaitNanoseconds(activeTiming->whrNs);
 
     for (auto& byte : id) { 
         byte = readData();
     }
     
-    busyWaitNanoseconds(TrhwNs);
+    busyWaitNanoseconds(activeTiming->rhwNs);
 }
 
 void MT29F::readONFISignature(etl::span<uint8_t, 4> signature) {
@@ -155,27 +494,36 @@ void MT29F::readONFISignature(etl::span<uint8_t, 4> signature) {
     
     sendAddress(static_cast<uint8_t>(ReadIDAddress::ONFI_SIGNATURE));
     
-    busyWaitNanoseconds(TwhrNs);
+    busyWaitNanoseconds(activeTiming->whrNs);
 
     for (auto& byte : signature) { 
         byte = readData();
     }
 
-    busyWaitNanoseconds(TrhwNs);
+    busyWaitNanoseconds(activeTiming->rhwNs);
 }
 
 bool MT29F::validateParameterPageCRC(etl::span<const uint8_t, 256> parameterPage) {
-    constexpr uint16_t CrcPolynomial = 0x8005U;
-    constexpr uint16_t CrcInitialValue = 0x4F4EU;
     constexpr size_t CrcDataLength = 254U;
     constexpr size_t StoredCrcLowByteOffset = 254U;
     constexpr size_t StoredCrcHighByteOffset = 255U;
     constexpr uint8_t BitsPerByte = 8U;
+
+    const uint16_t StoredCrc = static_cast<uint16_t>(parameterPage[StoredCrcLowByteOffset]) |
+                               (static_cast<uint16_t>(parameterPage[StoredCrcHighByteOffset]) << BitsPerByte);
+
+    return computeCrc16(parameterPage.first<CrcDataLength>()) == StoredCrc;
+}
+
+uint16_t MT29F::computeCrc16(etl::span<const uint8_t> data) {
+    constexpr uint16_t CrcPolynomial = 0x8005U;
+    constexpr uint16_t CrcInitialValue = 0x4F4EU;
+    constexpr uint8_t BitsPerByte = 8U;
     constexpr uint16_t MsbMask = 0x8000U;
 
     uint16_t crc = CrcInitialValue;
 
-    for (const auto byte : parameterPage.first<CrcDataLength>()) {
+    for (const auto byte : data) {
         crc ^= static_cast<uint16_t>(byte) << BitsPerByte;
 
         for (uint8_t bit = 0U; bit < BitsPerByte; bit++) {
@@ -187,10 +535,7 @@ bool MT29F::validateParameterPageCRC(etl::span<const uint8_t, 256> parameterPage
         }
     }
 
-    const uint16_t StoredCrc = static_cast<uint16_t>(parameterPage[StoredCrcLowByteOffset]) |
-                               (static_cast<uint16_t>(parameterPage[StoredCrcHighByteOffset]) << BitsPerByte);
-
-    return crc == StoredCrc;
+    return crc;
 }
 
 etl::expected<void, NANDErrorCode> MT29F::validateDeviceParameters() {
@@ -198,6 +543,7 @@ etl::expected<void, NANDErrorCode> MT29F::validateDeviceParameters() {
     constexpr size_t OnfiSpareBytesPerPageOffset = 84U;
     constexpr size_t OnfiPagesPerBlockOffset = 92U;
     constexpr size_t OnfiBlocksPerLunOffset = 96U;
+    constexpr size_t OnfiTimingModeSupportOffset = 129U;
     constexpr uint8_t OnfiParameterPageCopies = 3U;
     constexpr uint8_t ParameterPageAddress = 0x00U;
 
@@ -205,17 +551,17 @@ etl::expected<void, NANDErrorCode> MT29F::validateDeviceParameters() {
 
     sendAddress(ParameterPageAddress);
     
-    busyWaitNanoseconds(TwhrNs);
+    busyWaitNanoseconds(activeTiming->whrNs);
 
     if (auto waitResult = waitForReady(TimeoutReadUs); not waitResult.has_value()) {
         return waitResult;
     }
 
-    busyWaitNanoseconds(TrrNs);
+    busyWaitNanoseconds(activeTiming->rrNs);
 
     sendCommand(Commands::READ_MODE);
     
-    busyWaitNanoseconds(TwhrNs);
+    busyWaitNanoseconds(activeTiming->whrNs);
 
     for (uint8_t copy = 0U; copy < OnfiParameterPageCopies; copy++) {
         etl::array<uint8_t, 256> parametersPageData;
@@ -264,10 +610,14 @@ etl::expected<void, NANDErrorCode> MT29F::validateDeviceParameters() {
             continue;
         }
 
+        supportedTimingModes = asUint16(parametersPageData[OnfiTimingModeSupportOffset],
+                                        parametersPageData[OnfiTimingModeSupportOffset + 1U]);
+
         return {};
     }
 
-    LOG_ERROR << "NAND: All parameter page copies were invalid (possible bit flip). Will use the hardcoded geometry values";
+    LOG_ERROR << "NAND: All parameter page copies were invalid (possible bit flip). Will use the hardcoded geometry values"
+                 " and timing mode 0";
     return {};
 }
 
@@ -306,20 +656,37 @@ etl::expected<void, NANDErrorCode> MT29F::validateAddress(const NANDAddress& add
     return {};
 }
 
+etl::expected<void, NANDErrorCode> MT29F::validateProgramRequest(const NANDAddress& address, etl::span<const uint8_t> data) {
+    if (data.size() > (TotalBytesPerPage - address.column)) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if ((address.column <= BlockMarkerOffset) and ((address.column + data.size()) > BlockMarkerOffset)) {
+        const size_t MarkerIndex = BlockMarkerOffset - address.column;
+        const uint8_t MarkerValue = data[MarkerIndex];
+
+        if (MarkerValue != GoodBlockMarker) {
+            return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+        }
+    }
+
+    return validateAddress(address);
+}
+
 uint8_t MT29F::readStatusRegister() {
     sendCommand(Commands::READ_STATUS);
 
-    busyWaitNanoseconds(TwhrNs);
+    busyWaitNanoseconds(activeTiming->whrNs);
 
     uint8_t status = readData();
 
-    busyWaitNanoseconds(TrhwNs);
+    busyWaitNanoseconds(activeTiming->rhwNs);
 
     return status;
 }
 
 etl::expected<void, NANDErrorCode> MT29F::ensureDeviceReady() {
-    if (not isReady(readStatusRegister())) {
+    if ((pendingOperation != PendingOperation::NONE) or (not isReady(readStatusRegister()))) {
         return etl::unexpected(NANDErrorCode::DEVICE_BUSY);
     }
 
@@ -336,58 +703,307 @@ etl::expected<void, NANDErrorCode> MT29F::verifyWriteEnabled() {
     return {};
 }
 
+/* ============= Data Phase ============= */
+
+etl::expected<void, NANDErrorCode> MT29F::readDataBlock(etl::span<uint8_t> data) {
+    if ((dmaEngine != nullptr) and (data.size() >= DmaMinimumTransferBytes) and
+        dmaEngine->startRead(moduleBaseAddress, data)) {
+        if (not dmaEngine->waitForCompletion(TimeoutDmaTransferUs)) {
+            dataPhaseStatistics.dmaFailures++;
+            return etl::unexpected(NANDErrorCode::DMA_FAILED);
+        }
+
+        dataPhaseStatistics.dmaTransfers++;
+        return {};
+    }
+
+    for (auto& byte : data) {
+        byte = readData();
+    }
+
+    dataPhaseStatistics.cpuTransfers++;
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::sendDataBlock(etl::span<const uint8_t> data) {
+    if ((dmaEngine != nullptr) and (data.size() >= DmaMinimumTransferBytes) and
+        dmaEngine->startWrite(data, moduleBaseAddress)) {
+        if (not dmaEngine->waitForCompletion(TimeoutDmaTransferUs)) {
+            dataPhaseStatistics.dmaFailures++;
+            return etl::unexpected(NANDErrorCode::DMA_FAILED);
+        }
+
+        dataPhaseStatistics.dmaTransfers++;
+        return {};
+    }
+
+    for (const auto& byte : data) {
+        sendData(byte);
+    }
+
+    dataPhaseStatistics.cpuTransfers++;
+    return {};
+}
+
 /* ============= Wait Policy ============= */
 
-etl::expected<void, NANDErrorCode> MT29F::waitForReady(uint32_t timeoutUs) {
+etl::expected<void, NANDErrorCode> MT29F::waitForReady(uint32_t timeoutUs, uint8_t readyStatusMask,
+                                                    BusyOperation operation) {
+    LatencyProbe probe { operationStatistics.waitForReady };
+    const uint32_t StartCycles = readCycleCounter();
     const bool UsePureBusyWait = (timeoutUs <= BusyWaitThresholdUs);
-    uint32_t elapsedUs = 0U;
-    constexpr bool PinLevelBusy = static_cast<bool>(ActiveLowPin::ASSERTED);
+    uint32_t plannedWakeUs = 0U;
+    bool isFirstPoll = true;
+
+    if (isReadyBusyInterruptEnabled) {
+        if (auto interruptResult = waitForReadyBusyInterrupt(timeoutUs); not interruptResult.has_value()) {
+            operationStatistics.timeouts++;
+            return interruptResult;
+        }
+    } else {
+        plannedWakeUs = sleepForExpectedBusyTime(operation, timeoutUs, StartCycles);
+    }
+
+    /* The status poll only gets what is left of the timeout */
+    uint32_t elapsedUs = getElapsedMicroseconds(StartCycles);
+
+    /* Poll tightly around the expected completion, then fall back to yielding */
+    const uint32_t SpinUntilUs = elapsedUs + BusyWaitThresholdUs;
+
+    if (not isReadyBusyInterruptEnabled and hasReadyBusyLine()) {
+        while (isReadyBusyAsserted()) {
+            isFirstPoll = false;
 
-    if (nandReadyBusyPin != PIO_PIN_NONE) {
-        while (PIO_PinRead(nandReadyBusyPin) == PinLevelBusy) {
             if (elapsedUs > timeoutUs) {
+                operationStatistics.timeouts++;
                 return etl::unexpected(NANDErrorCode::TIMEOUT);
             }
 
-            if (UsePureBusyWait or (elapsedUs < BusyWaitThresholdUs)) {
-                busyWaitMicroseconds(BusyWaitPollIntervalUs);
-                elapsedUs += BusyWaitPollIntervalUs;
-            } else {
-                if (not yieldMilliseconds.call_if(YieldIntervalMs)) {
-                    busyWaitMicroseconds(YieldIntervalMs * 1000U);
-                }
-                elapsedUs += YieldIntervalMs * 1000U;
-            }
+            waitPollInterval(UsePureBusyWait or (elapsedUs < SpinUntilUs), elapsedUs);
         }
     }
 
     while (true) {
-        if (isReady(readStatusRegister())) {
+        if ((readStatusRegister() & readyStatusMask) == readyStatusMask) {
+            const uint32_t BusyUs = getElapsedMicroseconds(StartCycles);
+
+            /* Ready at the first look after sleeping: the operation may have ended anywhere before */
+            recordBusyTime(operation, ((plannedWakeUs != 0U) and isFirstPoll) ? etl::min(BusyUs, plannedWakeUs) : BusyUs);
             return {};
         }
 
+        isFirstPoll = false;
+
         if (elapsedUs > timeoutUs) {
+            operationStatistics.timeouts++;
             return etl::unexpected(NANDErrorCode::TIMEOUT);
         }
 
-        if (UsePureBusyWait or (elapsedUs < BusyWaitThresholdUs)) {
-            busyWaitMicroseconds(BusyWaitPollIntervalUs);
-            elapsedUs += BusyWaitPollIntervalUs;
-        } else {
-            if (not yieldMilliseconds.call_if(YieldIntervalMs)) {
-                busyWaitMicroseconds(YieldIntervalMs * 1000U);
-            }
-            elapsedUs += YieldIntervalMs * 1000U;
-        }
+        waitPollInterval(UsePureBusyWait or (elapsedUs < SpinUntilUs), elapsedUs);
     }
 }
 
+void MT29F::waitPollInterval(bool isSpinning, uint32_t& elapsedUs) {
+    if (isSpinning) {
+        busyWaitMicroseconds(BusyWaitPollIntervalUs);
+        elapsedUs += BusyWaitPollIntervalUs;
+        operationStatistics.spinUs += BusyWaitPollIntervalUs;
+        return;
+    }
 
-/* ============= Timing Utilities ============= */
+    if (not yieldMilliseconds.call_if(YieldIntervalMs)) {
+        busyWaitMicroseconds(YieldIntervalMs * 1000U);
+    }
 
-__attribute__((noinline, section(".ramfunc")))
-void MT29F::busyWaitCycles(uint32_t cycles) {
-    constexpr uint32_t CyclesPerLoop = 2U;
+    elapsedUs += YieldIntervalMs * 1000U;
+}
+
+uint32_t MT29F::sleepForExpectedBusyTime(BusyOperation operation, uint32_t timeoutUs, uint32_t startCycles) {
+    const uint32_t ExpectedUs = etl::min(getBusyTimeEstimateUs(operation), timeoutUs);
+
+    if (ExpectedUs <= AdaptiveWakeMarginUs) {
+        return 0U;
+    }
+
+    const uint32_t WakeUs = ExpectedUs - AdaptiveWakeMarginUs;
+
+    /* A yield may return up to YieldIntervalMs late, so stop yielding one interval early */
+    if (yieldMilliseconds.is_valid()) {
+        while ((getElapsedMicroseconds(startCycles) + (YieldIntervalMs * 1000U)) <= WakeUs) {
+            yieldMilliseconds(YieldIntervalMs);
+        }
+    }
+
+    const uint32_t ElapsedUs = getElapsedMicroseconds(startCycles);
+
+    if (ElapsedUs < WakeUs) {
+        busyWaitMicroseconds(WakeUs - ElapsedUs);
+        operationStatistics.spinUs += WakeUs - ElapsedUs;
+    }
+
+    return WakeUs;
+}
+
+void MT29F::recordBusyTime(BusyOperation operation, uint32_t busyUs) {
+    if (operation == BusyOperation::OTHER) {
+        return;
+    }
+
+    uint32_t& scaledEstimate = busyTimeEstimates[static_cast<uint8_t>(operation)];
+
+    /* Exponentially weighted moving average with weight 2^-BusyEstimateShift, stored scaled by 2^BusyEstimateShift */
+    if (scaledEstimate == 0U) {
+        scaledEstimate = busyUs << BusyEstimateShift;
+    } else {
+        scaledEstimate = scaledEstimate - (scaledEstimate >> BusyEstimateShift) + busyUs;
+    }
+}
+
+etl::expected<void, NANDErrorCode> MT29F::waitForReadyBusyInterrupt(uint32_t timeoutUs) {
+    if (not isReadyBusyAsserted()) {
+        return {};
+    }
+
+    const uint32_t StartCycles = readCycleCounter();
+
+    PIO_PinInterruptEnable(nandReadyBusyPin);
+
+    /* R/B# may have risen before the interrupt was enabled, so re-sample after every wakeup.
+     * A stale wakeup only gets the time left, so the whole wait stays within timeoutUs. */
+    for (uint8_t wakeup = 0U; (wakeup <= MaxSpuriousWakeups) and isReadyBusyAsserted(); wakeup++) {
+        const uint32_t ElapsedUs = getElapsedMicroseconds(StartCycles);
+
+        if ((ElapsedUs >= timeoutUs) or (not waitForNotification(timeoutUs - ElapsedUs))) {
+            break;
+        }
+    }
+
+    PIO_PinInterruptDisable(nandReadyBusyPin);
+
+    if (isReadyBusyAsserted()) {
+        return etl::unexpected(NANDErrorCode::TIMEOUT);
+    }
+
+    return {};
+}
+
+void MT29F::readyBusyCallback(PIO_PIN /* pin */, uintptr_t context) {
+    auto* nand = reinterpret_cast<MT29F*>(context);
+
+    nand->notifyTaskFromIsr.call_if();
+}
+
+
+/* ============= Timing Mode Negotiation ============= */
+
+etl::expected<void, NANDErrorCode> MT29F::negotiateTimingMode() {
+    constexpr uint8_t TimingModeMask = 0x0FU;
+
+    uint8_t mode = 0U;
+
+    for (uint8_t candidate = ONFITiming::ModeCount - 1U; candidate > 0U; candidate--) {
+        if ((supportedTimingModes & (1U << candidate)) != 0U) {
+            mode = candidate;
+            break;
+        }
+    }
+
+    if (mode == activeTiming->mode) {
+        return {};
+    }
+
+    if (auto setResult = setFeatures(FeatureAddress::TIMING_MODE, FeatureParameters{ mode, 0U, 0U, 0U });
+        not setResult.has_value()) {
+        return setResult;
+    }
+
+    applyTimingMode(mode);
+
+    FeatureParameters reportedParameters{};
+
+    if (auto getResult = getFeatures(FeatureAddress::TIMING_MODE, reportedParameters); not getResult.has_value()) {
+        return getResult;
+    }
+
+    if ((reportedParameters[0] & TimingModeMask) == mode) {
+        return {};
+    }
+
+    LOG_ERROR << "NAND: Timing mode change not applied by the device. Using timing mode 0";
+
+    applyTimingMode(0U);
+
+    return setFeatures(FeatureAddress::TIMING_MODE, FeatureParameters{});
+}
+
+etl::expected<void, NANDErrorCode> MT29F::setFeatures(FeatureAddress feature, const FeatureParameters& parameters) {
+    sendCommand(Commands::SET_FEATURES);
+
+    sendAddress(static_cast<uint8_t>(feature));
+
+    busyWaitNanoseconds(activeTiming->adlNs);
+
+    for (const auto parameter : parameters) {
+        sendData(parameter);
+    }
+
+    busyWaitNanoseconds(activeTiming->wbNs);
+
+    return waitForReady(TimeoutFeatureUs);
+}
+
+etl::expected<void, NANDErrorCode> MT29F::getFeatures(FeatureAddress feature, FeatureParameters& parameters) {
+    sendCommand(Commands::GET_FEATURES);
+
+    sendAddress(static_cast<uint8_t>(feature));
+
+    busyWaitNanoseconds(activeTiming->wbNs);
+
+    if (auto waitResult = waitForReady(TimeoutFeatureUs); not waitResult.has_value()) {
+        return waitResult;
+    }
+
+    busyWaitNanoseconds(activeTiming->rrNs);
+
+    sendCommand(Commands::READ_MODE);
+
+    busyWaitNanoseconds(activeTiming->whrNs);
+
+    for (auto& parameter : parameters) {
+        parameter = readData();
+    }
+
+    busyWaitNanoseconds(activeTiming->rhwNs);
+
+    return {};
+}
+
+void MT29F::applyTimingMode(uint8_t mode) {
+    activeTiming = &ONFITiming::Modes[mode];
+
+    if (busBackend != nullptr) {
+        return;
+    }
+
+    const ONFITiming::SmcCycles& Cycles = SmcTimings[mode];
+
+    smcConfigureTiming(nandChipSelect,
+                       SMC_SETUP_NWE_SETUP(Cycles.writeSetup) | SMC_SETUP_NCS_WR_SETUP(0U) |
+                           SMC_SETUP_NRD_SETUP(0U) | SMC_SETUP_NCS_RD_SETUP(0U),
+                       SMC_PULSE_NWE_PULSE(Cycles.writePulse) | SMC_PULSE_NCS_WR_PULSE(Cycles.writeCycle) |
+                           SMC_PULSE_NRD_PULSE(Cycles.readPulse) | SMC_PULSE_NCS_RD_PULSE(Cycles.readCycle),
+                       SMC_CYCLE_NWE_CYCLE(Cycles.writeCycle) | SMC_CYCLE_NRD_CYCLE(Cycles.readCycle),
+                       SMC_MODE_READ_MODE_Msk | SMC_MODE_WRITE_MODE_Msk | SMC_MODE_EXNW_MODE_DISABLED |
+                           SMC_MODE_DBW_8_BIT | SMC_MODE_TDF_CYCLES(Cycles.dataFloat));
+}
+
+
+/* ============= Timing Utilities ============= */
+
+#if defined(__arm__)
+__attribute__((noinline, section(".ramfunc")))
+void MT29F::busyWaitCycles(uint32_t cycles) {
+    constexpr uint32_t CyclesPerLoop = 2U;
 
     uint32_t iterations = cycles / CyclesPerLoop;
 
@@ -395,134 +1011,1190 @@ void MT29F::busyWaitCycles(uint32_t cycles) {
         return;
     }
 
-    __asm__ volatile (
-        ".align 4              \n"
-        "1:  subs %0, %0, #1   \n"
-        "    bne  1b           \n"
-        : "+r" (iterations)
-        :
-        : "cc"
-    );
+    __asm__ volatile (
+        ".align 4              \n"
+        "1:  subs %0, %0, #1   \n"
+        "    bne  1b           \n"
+        : "+r" (iterations)
+        :
+        : "cc"
+    );
+}
+#else
+void MT29F::busyWaitCycles(uint32_t cycles) {
+    constexpr uint64_t CpuMhz = CPU_CLOCK_FREQUENCY / 1000000U;
+    const auto Deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds((cycles * 1000ULL) / CpuMhz);
+
+    while (std::chrono::steady_clock::now() < Deadline) {
+    }
+}
+#endif
+
+#if defined(__arm__)
+void MT29F::enableCycleCounter() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t MT29F::readCycleCounter() {
+    return DWT->CYCCNT;
+}
+#else
+void MT29F::enableCycleCounter() {}
+
+uint32_t MT29F::readCycleCounter() {
+    constexpr uint64_t CpuMhz = CPU_CLOCK_FREQUENCY / 1000000U;
+    const auto Elapsed = std::chrono::steady_clock::now().time_since_epoch();
+
+    return static_cast<uint32_t>((std::chrono::duration_cast<std::chrono::nanoseconds>(Elapsed).count() * CpuMhz) / 1000U);
+}
+#endif
+
+
+/* ============= Public Interface - Initialization ============= */
+
+etl::expected<void, NANDErrorCode> MT29F::initialize() {
+    if (isInitialized) {
+        return etl::unexpected(NANDErrorCode::ALREADY_INITIALIZED);
+    }
+
+    enableCycleCounter();
+
+    if (nandWriteProtectPin == PIO_PIN_NONE) {
+        LOG_INFO << "NAND: Write protection pin not provided. Hardware write protection disabled";
+    } else {
+        disableWrites();
+    }
+
+    if (not hasReadyBusyLine()) {
+        LOG_INFO << "NAND: Ready/busy pin not provided. Using status register polling";
+    }
+
+    isTimingModeNegotiated = false;
+
+    applyTimingMode(0U);
+
+    if (auto resetResult = reset(); not resetResult.has_value()) {
+        LOG_ERROR << "NAND: Reset failed";
+        return resetResult;
+    }
+
+    etl::array<uint8_t, 5> deviceId;
+    
+    readDeviceID(deviceId);
+
+    if (not etl::equal(ExpectedDeviceId.begin(), ExpectedDeviceId.end(), deviceId.begin())) {
+        LOG_ERROR << "NAND: Device ID mismatch";
+    }
+
+    constexpr etl::array<uint8_t, 4> ExpectedOnfi { 'O', 'N', 'F', 'I' };
+    
+    etl::array<uint8_t, 4> onfiSignature;
+
+    readONFISignature(onfiSignature);
+
+    if (not etl::equal(onfiSignature.begin(), onfiSignature.end(), ExpectedOnfi.begin())) {
+        LOG_ERROR << "NAND: ONFI signature verification failed";
+    }
+
+    if (auto parameterResult = validateDeviceParameters(); not parameterResult.has_value()) {
+        return parameterResult;
+    }
+
+    if (auto timingResult = negotiateTimingMode(); not timingResult.has_value()) {
+        LOG_ERROR << "NAND: Timing mode negotiation failed";
+        return timingResult;
+    }
+
+    isTimingModeNegotiated = true;
+
+    isInitialized = true;
+
+    auto loadResult = loadBadBlockTable();
+
+    if (not loadResult.has_value()) {
+        /* Rescanning now would forget the blocks marked bad at runtime whose marker could not be programmed */
+        LOG_ERROR << "NAND: Bad block table could not be read";
+        isInitialized = false;
+        return etl::unexpected(loadResult.error());
+    }
+
+    if (*loadResult) {
+        return {};
+    }
+
+    LOG_INFO << "NAND: No valid bad block table found. Scanning factory markers";
+
+    if (auto scanResult = scanFactoryBadBlocks(); not scanResult.has_value()) {
+        isInitialized = false;
+        return scanResult;
+    }
+
+    if (auto persistResult = persistBadBlockTable(); not persistResult.has_value()) {
+        LOG_ERROR << "NAND: Bad block table could not be saved";
+    }
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::enableReadyBusyInterrupt(NotificationWaitDelegate waitNotification,
+                                                                    NotificationGiveDelegate notifyFromIsr) {
+    if ((nandReadyBusyPin == PIO_PIN_NONE) or (busBackend != nullptr) or (not waitNotification.is_valid())
+        or (not notifyFromIsr.is_valid())) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    waitForNotification = waitNotification;
+    notifyTaskFromIsr = notifyFromIsr;
+
+    PIO_PinInterruptDisable(nandReadyBusyPin);
+    PIO_PinInterruptCallbackRegister(nandReadyBusyPin, readyBusyCallback, reinterpret_cast<uintptr_t>(this));
+
+    isReadyBusyInterruptEnabled = true;
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::reset() {
+    sendCommand(Commands::RESET);
+
+    busyWaitNanoseconds(activeTiming->wbNs);
+
+    applyTimingMode(0U);
+
+    if (auto waitResult = waitForReady(TimeoutResetUs); not waitResult.has_value()) {
+        return waitResult;
+    }
+
+    if (isTimingModeNegotiated) {
+        return negotiateTimingMode();
+    }
+
+    return {};
+}
+
+
+/* ============= Public Interface - Data Operations ============= */
+
+etl::expected<void, NANDErrorCode> MT29F::readPage(const NANDAddress& address, etl::span<uint8_t> data) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (data.size() > (TotalBytesPerPage - address.column)) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if (auto validateResult = validateAddress(address); not validateResult.has_value()) {
+        return validateResult;
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    LatencyProbe probe { operationStatistics.read };
+
+    if (auto commandResult = executeReadCommandSequence(address); not commandResult.has_value()) {
+        return commandResult;
+    }
+
+    if (auto transferResult = readDataBlock(data); not transferResult.has_value()) {
+        return transferResult;
+    }
+
+    busyWaitNanoseconds(activeTiming->rhwNs);
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::programPage(const NANDAddress& address, etl::span<const uint8_t> data) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (auto validateResult = validateProgramRequest(address, data); not validateResult.has_value()) {
+        return validateResult;
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    LatencyProbe probe { operationStatistics.program };
+
+    return executeProgramCommandSequence(address, data, {});
+}
+
+etl::expected<void, NANDErrorCode> MT29F::eraseBlock(uint16_t block, uint8_t lun) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if ((block >= BlocksPerLun) or (lun >= LunsPerCe)) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    LatencyProbe probe { operationStatistics.erase };
+
+    storeReadRetryOption(block, 0U);
+
+    const NANDAddress Address { lun, block, 0U, 0U };
+    AddressCycles cycles;
+    buildAddressCycles(Address, cycles);
+
+    {
+        WriteEnableGuard guard(*this);
+
+        if (auto writeEnabledResult = verifyWriteEnabled(); not writeEnabledResult.has_value()) {
+            return writeEnabledResult;
+        }
+
+        sendCommand(Commands::ERASE_BLOCK);
+
+        sendAddress(cycles[static_cast<size_t>(AddressCycle::ROW_ADDRESS_1)]);
+        sendAddress(cycles[static_cast<size_t>(AddressCycle::ROW_ADDRESS_2)]);
+        sendAddress(cycles[static_cast<size_t>(AddressCycle::ROW_ADDRESS_3)]);
+
+        sendCommand(Commands::ERASE_BLOCK_CONFIRM);
+
+        busyWaitNanoseconds(activeTiming->wbNs);
+
+        if (auto waitResult = waitForReady(TimeoutEraseUs, StatusReady | StatusArrayReady, BusyOperation::ERASE);
+            not waitResult.has_value()) {
+            return waitResult;
+        }
+    }
+
+    if (hasOperationFailed(readStatusRegister())) {
+        operationStatistics.statusFailures++;
+        return etl::unexpected(NANDErrorCode::ERASE_FAILED);
+    }
+
+    return {};
+}
+
+
+/* ============= Public Interface - Scatter-Gather Operations ============= */
+
+etl::expected<void, NANDErrorCode> MT29F::readPageSegments(const NANDAddress& address,
+                                                           etl::span<const ReadSegment> segments) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (segments.empty()) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    for (const auto& segment : segments) {
+        if ((segment.column >= TotalBytesPerPage) or (segment.data.size() > (TotalBytesPerPage - segment.column))) {
+            return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+        }
+    }
+
+    const NANDAddress StartAddress { address.lun, address.block, address.page, segments[0].column };
+
+    if (auto validateResult = validateAddress(StartAddress); not validateResult.has_value()) {
+        return validateResult;
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    LatencyProbe probe { operationStatistics.read };
+
+    if (auto commandResult = executeReadCommandSequence(StartAddress); not commandResult.has_value()) {
+        return commandResult;
+    }
+
+    uint32_t nextColumn = segments[0].column;
+
+    for (const auto& segment : segments) {
+        if (segment.column != nextColumn) {
+            busyWaitNanoseconds(activeTiming->rhwNs);
+
+            sendColumnChange(Commands::CHANGE_READ_COLUMN, segment.column);
+        }
+
+        if (auto transferResult = readDataBlock(segment.data); not transferResult.has_value()) {
+            return transferResult;
+        }
+
+        nextColumn = segment.column + segment.data.size();
+    }
+
+    busyWaitNanoseconds(activeTiming->rhwNs);
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::programPageSegments(const NANDAddress& address,
+                                                              etl::span<const ProgramSegment> segments) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (segments.empty()) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    for (const auto& segment : segments) {
+        const NANDAddress SegmentAddress { address.lun, address.block, address.page, segment.column };
+
+        if (auto validateResult = validateProgramRequest(SegmentAddress, segment.data); not validateResult.has_value()) {
+            return validateResult;
+        }
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    LatencyProbe probe { operationStatistics.program };
+
+    return executeProgramCommandSequence(address, segments);
+}
+
+
+/* ============= Public Interface - Erased Page Detection ============= */
+
+etl::expected<bool, NANDErrorCode> MT29F::isPageErased(const NANDAddress& address, uint32_t bitFlipTolerance) {
+    constexpr uint32_t ErasedWord = 0xFFFFFFFFU;
+    constexpr uint32_t WordsPerPage = TotalBytesPerPage / sizeof(uint32_t);
+
+    static_assert((TotalBytesPerPage % sizeof(uint32_t)) == 0U, "The page must split into whole words");
+
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    const NANDAddress PageAddress { address.lun, address.block, address.page, 0U };
+
+    if (auto validateResult = validateAddress(PageAddress); not validateResult.has_value()) {
+        return etl::unexpected(validateResult.error());
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return etl::unexpected(readyResult.error());
+    }
+
+    if (auto commandResult = executeReadCommandSequence(PageAddress); not commandResult.has_value()) {
+        return etl::unexpected(commandResult.error());
+    }
+
+    uint32_t zeroBits = 0U;
+
+    for (uint32_t word = 0U; (word < WordsPerPage) and (zeroBits <= bitFlipTolerance); word++) {
+        const uint32_t Value = readDataWord();
+
+        if (Value != ErasedWord) {
+            zeroBits += etl::count_bits(static_cast<uint32_t>(~Value));
+        }
+    }
+
+    busyWaitNanoseconds(activeTiming->rhwNs);
+
+    return zeroBits <= bitFlipTolerance;
+}
+
+
+/* ============= Public Interface - Split-Phase Operations ============= */
+
+etl::expected<void, NANDErrorCode> MT29F::startReadPage(const NANDAddress& address) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (auto validateResult = validateAddress(address); not validateResult.has_value()) {
+        return validateResult;
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    AddressCycles cycles;
+    buildAddressCycles(address, cycles);
+
+    sendCommand(Commands::READ_MODE);
+
+    for (const auto& cycle : cycles) {
+        sendAddress(cycle);
+    }
+
+    sendCommand(Commands::READ_CONFIRM);
+
+    busyWaitNanoseconds(activeTiming->wbNs);
+
+    pendingOperation = PendingOperation::READ;
+    pendingAddress = address;
+    pendingStartCycles = readCycleCounter();
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::startProgramPage(const NANDAddress& address, etl::span<const uint8_t> data) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (auto validateResult = validateProgramRequest(address, data); not validateResult.has_value()) {
+        return validateResult;
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    const uint32_t StartCycles = readCycleCounter();
+    AddressCycles cycles;
+    buildAddressCycles(address, cycles);
+
+    enableWrites();
+
+    if (auto writeEnabledResult = verifyWriteEnabled(); not writeEnabledResult.has_value()) {
+        disableWrites();
+        return writeEnabledResult;
+    }
+
+    sendCommand(Commands::PAGE_PROGRAM);
+
+    for (const auto& cycle : cycles) {
+        sendAddress(cycle);
+    }
+
+    busyWaitNanoseconds(activeTiming->adlNs);
+
+    if (auto transferResult = sendDataBlock(data); not transferResult.has_value()) {
+        disableWrites();
+        return transferResult;
+    }
+
+    sendCommand(Commands::PAGE_PROGRAM_CONFIRM);
+
+    busyWaitNanoseconds(activeTiming->wbNs);
+
+    pendingOperation = PendingOperation::PROGRAM;
+    pendingAddress = address;
+    pendingStartCycles = StartCycles;
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::startEraseBlock(uint16_t block, uint8_t lun) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if ((block >= BlocksPerLun) or (lun >= LunsPerCe)) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    storeReadRetryOption(block, 0U);
+
+    const NANDAddress Address { lun, block, 0U, 0U };
+    AddressCycles cycles;
+    buildAddressCycles(Address, cycles);
+
+    enableWrites();
+
+    if (auto writeEnabledResult = verifyWriteEnabled(); not writeEnabledResult.has_value()) {
+        disableWrites();
+        return writeEnabledResult;
+    }
+
+    sendCommand(Commands::ERASE_BLOCK);
+
+    sendAddress(cycles[static_cast<size_t>(AddressCycle::ROW_ADDRESS_1)]);
+    sendAddress(cycles[static_cast<size_t>(AddressCycle::ROW_ADDRESS_2)]);
+    sendAddress(cycles[static_cast<size_t>(AddressCycle::ROW_ADDRESS_3)]);
+
+    sendCommand(Commands::ERASE_BLOCK_CONFIRM);
+
+    busyWaitNanoseconds(activeTiming->wbNs);
+
+    pendingOperation = PendingOperation::ERASE;
+    pendingAddress = Address;
+    pendingStartCycles = readCycleCounter();
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::completeOperation(etl::span<uint8_t> data) {
+    const PendingOperation Operation = pendingOperation;
+
+    if (Operation == PendingOperation::NONE) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    pendingOperation = PendingOperation::NONE;
+
+    /* The device has been busy since the start: its busy time is not learned from this wait */
+    if (Operation == PendingOperation::READ) {
+        if (data.size() > (TotalBytesPerPage - pendingAddress.column)) {
+            return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+        }
+
+        if (auto waitResult = waitForReady(TimeoutReadUs); not waitResult.has_value()) {
+            return waitResult;
+        }
+
+        busyWaitNanoseconds(activeTiming->rrNs);
+
+        sendCommand(Commands::READ_MODE);
+
+        busyWaitNanoseconds(activeTiming->whrNs);
+
+        auto transferResult = readDataBlock(data);
+
+        busyWaitNanoseconds(activeTiming->rhwNs);
+        operationStatistics.read.record(getElapsedMicroseconds(pendingStartCycles));
+
+        return transferResult;
+    }
+
+    const bool IsProgram = (Operation == PendingOperation::PROGRAM);
+    auto waitResult = waitForReady(IsProgram ? TimeoutProgramUs : TimeoutEraseUs);
+
+    disableWrites();
+    (IsProgram ? operationStatistics.program : operationStatistics.erase)
+        .record(getElapsedMicroseconds(pendingStartCycles));
+
+    if (not waitResult.has_value()) {
+        return waitResult;
+    }
+
+    if (hasOperationFailed(readStatusRegister())) {
+        operationStatistics.statusFailures++;
+        return etl::unexpected(IsProgram ? NANDErrorCode::PROGRAM_FAILED : NANDErrorCode::ERASE_FAILED);
+    }
+
+    return {};
+}
+
+
+/* ============= Public Interface - Random Column Read Operations ============= */
+
+etl::expected<void, NANDErrorCode> MT29F::openPage(const NANDAddress& address) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    const NANDAddress PageAddress { address.lun, address.block, address.page, 0U };
+
+    if (auto validateResult = validateAddress(PageAddress); not validateResult.has_value()) {
+        return validateResult;
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    if (auto commandResult = executeReadCommandSequence(PageAddress); not commandResult.has_value()) {
+        return commandResult;
+    }
+
+    openPageAddress = PageAddress;
+    isPageOpen = true;
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> MT29F::readOpenPage(uint16_t column, etl::span<uint8_t> data) {
+    if (not isPageOpen) {
+        return etl::unexpected(NANDErrorCode::PAGE_NOT_OPEN);
+    }
+
+    if ((column >= TotalBytesPerPage) or (data.size() > (TotalBytesPerPage - column))) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    busyWaitNanoseconds(activeTiming->rhwNs);
+
+    sendColumnChange(Commands::CHANGE_READ_COLUMN, column);
+
+    if (auto transferResult = readDataBlock(data); not transferResult.has_value()) {
+        isPageOpen = false;
+        return transferResult;
+    }
+
+    return {};
+}
+
+/* ============= Public Interface - ECC Protected Data Operations ============= */
+
+template <typename ReadAttempt>
+etl::expected<MT29F::EccStatus, NANDErrorCode> MT29F::readWithRetry(uint16_t block, ReadAttempt readAttempt) {
+    if ((not isInitialized) or (block >= BlocksPerLun)) {
+        return readAttempt();
+    }
+
+    const uint8_t FirstOption = getReadRetryOption(block);
+    uint8_t selectedOption = 0U;
+    etl::expected<EccStatus, NANDErrorCode> result = etl::unexpected(NANDErrorCode::ECC_UNCORRECTABLE);
+
+    for (uint8_t attempt = 0U; attempt < ReadRetryOptions; attempt++) {
+        const uint8_t Option = (FirstOption + attempt) % ReadRetryOptions;
+
+        if (Option != selectedOption) {
+            if (auto selectResult = selectReadRetryOption(Option); not selectResult.has_value()) {
+                result = etl::unexpected(selectResult.error());
+                break;
+            }
+
+            selectedOption = Option;
+        }
+
+        if (attempt > 0U) {
+            operationStatistics.retries++;
+        }
+
+        result = readAttempt();
+
+        if (result.has_value()) {
+            if (Option != FirstOption) {
+                storeReadRetryOption(block, Option);
+                operationStatistics.readRetryRecoveries++;
+            }
+
+            break;
+        }
+
+        if (result.error() != NANDErrorCode::ECC_UNCORRECTABLE) {
+            break;
+        }
+    }
+
+    /* Leave the device on the default read levels for every other read */
+    if (selectedOption != 0U) {
+        if (auto selectResult = selectReadRetryOption(0U); not selectResult.has_value() and result.has_value()) {
+            return etl::unexpected(selectResult.error());
+        }
+    }
+
+    return result;
+}
+
+etl::expected<void, NANDErrorCode> MT29F::selectReadRetryOption(uint8_t option) {
+    const FeatureParameters Parameters = { option, 0U, 0U, 0U };
+
+    return setFeatures(FeatureAddress::READ_RETRY, Parameters);
+}
+
+etl::expected<MT29F::EccStatus, NANDErrorCode> MT29F::readPageEcc(const NANDAddress& address, etl::span<uint8_t> data,
+                                                                  etl::span<uint8_t> metadata) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if ((address.column != 0U) or (data.size() != DataBytesPerPage) or (metadata.size() > EccMetadataBytes)) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if (auto validateResult = validateAddress(address); not validateResult.has_value()) {
+        return etl::unexpected(validateResult.error());
+    }
+
+    LatencyProbe probe { operationStatistics.read };
+
+    return readWithRetry(static_cast<uint16_t>(address.block),
+                         [&]() { return readPageEccAttempt(address, data, metadata); });
+}
+
+etl::expected<MT29F::EccStatus, NANDErrorCode> MT29F::readPageEccAttempt(const NANDAddress& address,
+                                                                         etl::span<uint8_t> data,
+                                                                         etl::span<uint8_t> metadata) {
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return etl::unexpected(readyResult.error());
+    }
+
+    if (auto commandResult = executeReadCommandSequence(address); not commandResult.has_value()) {
+        return etl::unexpected(commandResult.error());
+    }
+
+    etl::array<uint8_t, SpareBytesPerPage> spare;
+
+    if (auto transferResult = readDataBlock(data); not transferResult.has_value()) {
+        return etl::unexpected(transferResult.error());
+    }
+
+    if (auto transferResult = readDataBlock(spare); not transferResult.has_value()) {
+        return etl::unexpected(transferResult.error());
+    }
+
+    busyWaitNanoseconds(activeTiming->rhwNs);
+
+    EccStatus status;
+    status.isErased = true;
+
+    for (uint8_t sector = 0U; sector <= EccSectorsPerPage; sector++) {
+        const bool IsMetadata = (sector == EccSectorsPerPage);
+        const etl::span<uint8_t> SectorData = IsMetadata
+                                              ? etl::span<uint8_t>(spare).subspan(EccMetadataOffset, EccMetadataBytes)
+                                              : data.subspan(sector * EccSectorBytes, EccSectorBytes);
+        const etl::span<uint8_t, BCHCodec::ParityBytes> Parity(&spare[EccParityOffset + (sector * BCHCodec::ParityBytes)],
+                                                                BCHCodec::ParityBytes);
+
+        if (auto decodeResult = decodeEccCodeword(SectorData, Parity, status); not decodeResult.has_value()) {
+            return etl::unexpected(decodeResult.error());
+        }
+    }
+
+    etl::copy_n(spare.begin() + EccMetadataOffset, metadata.size(), metadata.begin());
+
+    return status;
+}
+
+etl::expected<void, NANDErrorCode> MT29F::programPageEcc(const NANDAddress& address, etl::span<const uint8_t> data,
+                                                         etl::span<const uint8_t> metadata) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if ((address.column != 0U) or (data.size() != DataBytesPerPage) or (metadata.size() > EccMetadataBytes)) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if (auto validateResult = validateAddress(address); not validateResult.has_value()) {
+        return validateResult;
+    }
+
+    etl::array<uint8_t, SpareBytesPerPage> spare;
+    spare.fill(GoodBlockMarker);
+
+    etl::copy(metadata.begin(), metadata.end(), spare.begin() + EccMetadataOffset);
+
+    for (uint8_t sector = 0U; sector <= EccSectorsPerPage; sector++) {
+        const bool IsMetadata = (sector == EccSectorsPerPage);
+        const etl::span<const uint8_t> SectorData = IsMetadata
+                                                    ? etl::span<const uint8_t>(spare).subspan(EccMetadataOffset, EccMetadataBytes)
+                                                    : data.subspan(sector * EccSectorBytes, EccSectorBytes);
+        const etl::span<uint8_t, BCHCodec::ParityBytes> Parity(&spare[EccParityOffset + (sector * BCHCodec::ParityBytes)],
+                                                                BCHCodec::ParityBytes);
+
+        BCHCodec::encode(SectorData, Parity);
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    LatencyProbe probe { operationStatistics.program };
+
+    return executeProgramCommandSequence(address, data, spare);
+}
+
+etl::expected<MT29F::EccStatus, NANDErrorCode> MT29F::readPageMetadataEcc(const NANDAddress& address,
+                                                                          etl::span<uint8_t> metadata) {
+    return readWithRetry(static_cast<uint16_t>(address.block),
+                         [&]() { return readPageMetadataEccAttempt(address, metadata); });
+}
+
+etl::expected<MT29F::EccStatus, NANDErrorCode> MT29F::readPageMetadataEccAttempt(const NANDAddress& address,
+                                                                                 etl::span<uint8_t> metadata) {
+    constexpr uint16_t MetadataColumn = BlockMarkerOffset + EccMetadataOffset;
+    constexpr uint16_t MetadataParityColumn = BlockMarkerOffset + EccParityOffset +
+                                              (EccSectorsPerPage * BCHCodec::ParityBytes);
+
+    if (metadata.size() > EccMetadataBytes) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if (auto openResult = openPage(address); not openResult.has_value()) {
+        return etl::unexpected(openResult.error());
+    }
+
+    etl::array<uint8_t, EccMetadataBytes> codewordData;
+    etl::array<uint8_t, BCHCodec::ParityBytes> parity;
+
+    if (auto readResult = readOpenPage(MetadataColumn, codewordData); not readResult.has_value()) {
+        return etl::unexpected(readResult.error());
+    }
+
+    if (auto readResult = readOpenPage(MetadataParityColumn, parity); not readResult.has_value()) {
+        return etl::unexpected(readResult.error());
+    }
+
+    closePage();
+
+    busyWaitNanoseconds(activeTiming->rhwNs);
+
+    EccStatus status;
+    status.isErased = true;
+
+    if (auto decodeResult = decodeEccCodeword(codewordData, parity, status); not decodeResult.has_value()) {
+        return etl::unexpected(decodeResult.error());
+    }
+
+    etl::copy_n(codewordData.begin(), metadata.size(), metadata.begin());
+
+    return status;
+}
+
+etl::expected<void, NANDErrorCode> MT29F::decodeEccCodeword(etl::span<uint8_t> data,
+                                                            etl::span<uint8_t, BCHCodec::ParityBytes> parity,
+                                                            EccStatus& status) {
+    constexpr uint8_t ErasedByte = 0xFFU;
+
+    uint8_t correctedBits = 0U;
+
+    /* Erased codeword with a few flipped bits? Checked before the full decode, as it is much cheaper and
+     * counting stops within a few words on programmed data. The code distance leaves room for at most
+     * one codeword this close to all ones, so a programmed codeword is not mistaken for an erased one */
+    uint32_t zeroBits = countZeroBits(data, BCHCodec::CorrectableBits);
+
+    if (zeroBits <= BCHCodec::CorrectableBits) {
+        zeroBits += countZeroBits(parity, BCHCodec::CorrectableBits - zeroBits);
+    }
+
+    if (zeroBits <= BCHCodec::CorrectableBits) {
+        etl::fill(data.begin(), data.end(), ErasedByte);
+        etl::fill(parity.begin(), parity.end(), ErasedByte);
+        correctedBits = static_cast<uint8_t>(zeroBits);
+    } else if (auto decodeResult = BCHCodec::decode(data, parity); decodeResult.has_value()) {
+        correctedBits = *decodeResult;
+        status.isErased = false;
+    } else {
+        return etl::unexpected(NANDErrorCode::ECC_UNCORRECTABLE);
+    }
+
+    status.correctedBits += correctedBits;
+    status.maxCorrectedBits = etl::max(status.maxCorrectedBits, correctedBits);
+
+    return {};
+}
+
+uint32_t MT29F::countZeroBits(etl::span<const uint8_t> bytes, uint32_t limit) {
+    constexpr uint8_t BitsPerByte = 8U;
+    constexpr uint32_t ErasedWord = 0xFFFFFFFFU;
+
+    uint32_t zeroBits = 0U;
+    size_t index = 0U;
+
+    for (; ((index + sizeof(uint32_t)) <= bytes.size()) and (zeroBits <= limit); index += sizeof(uint32_t)) {
+        /* Merged into a single (unaligned) word load by the compiler */
+        const uint32_t Word = LittleEndian::loadWord(bytes, index);
+
+        if (Word != ErasedWord) {
+            zeroBits += etl::count_bits(static_cast<uint32_t>(~Word));
+        }
+    }
+
+    for (; index < bytes.size(); index++) {
+        zeroBits += BitsPerByte - etl::count_bits(bytes[index]);
+    }
+
+    return zeroBits;
+}
+
+/* ============= Public Interface - Cache Read Operations ============= */
+
+size_t MT29F::PageDataStream::read(etl::span<uint8_t> data) {
+    const size_t Length = etl::min(data.size(), remainingBytes);
+
+    for (auto& byte : data.first(Length)) {
+        byte = nand.readData();
+    }
+
+    remainingBytes -= Length;
+
+    return Length;
+}
+
+etl::expected<void, NANDErrorCode> MT29F::readPagesSequential(const NANDAddress& startAddress, uint32_t pageCount,
+                                                              PageSink sink) {
+    if (not isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if ((startAddress.column != 0U) or (not sink.is_valid())) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if (auto validateResult = validateAddress(startAddress); not validateResult.has_value()) {
+        return validateResult;
+    }
+
+    const uint32_t FirstPageIndex = (startAddress.block * PagesPerBlock) + startAddress.page;
+
+    if (pageCount > ((static_cast<uint32_t>(BlocksPerLun) * PagesPerBlock) - FirstPageIndex)) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    if (pageCount == 0U) {
+        return {};
+    }
+
+    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
+        return readyResult;
+    }
+
+    if (auto commandResult = executeReadCommandSequence(startAddress); not commandResult.has_value()) {
+        return commandResult;
+    }
+
+    NANDAddress currentAddress = startAddress;
+
+    for (uint32_t pageIndex = 0U; pageIndex < pageCount; pageIndex++) {
+        const bool IsLastPage = (pageIndex + 1U) == pageCount;
+        NANDAddress nextAddress = currentAddress;
+
+        nextAddress.page++;
+
+        if (nextAddress.page == PagesPerBlock) {
+            nextAddress.page = 0U;
+            nextAddress.block++;
+        }
+
+        const bool IsSequential = nextAddress.block == currentAddress.block;
+
+        if (auto cacheResult = executeCacheReadCommand(IsLastPage ? nullptr : &nextAddress, IsSequential);
+            not cacheResult.has_value()) {
+            return cacheResult;
+        }
+
+        PageDataStream stream { *this, TotalBytesPerPage };
+        const bool ShouldContinue = sink(currentAddress, stream);
+
+        busyWaitNanoseconds(activeTiming->rhwNs);
+
+        if (not ShouldContinue) {
+            /* 31h already started loading the next page, 3Fh ends the cache read mode */
+            if (not IsLastPage) {
+                if (auto endResult = executeCacheReadCommand(nullptr, false); not endResult.has_value()) {
+                    return endResult;
+                }
+            }
+
+            break;
+        }
+
+        currentAddress = nextAddress;
+    }
+
+    return waitForReady(TimeoutReadUs);
+}
+
+/* ============= Public Interface - Cache Program Operations ============= */
+
+MT29F::CacheProgramWriter::~CacheProgramWriter() {
+    if (isStreaming) {
+        endStream();
+    }
 }
 
+etl::expected<void, NANDErrorCode> MT29F::CacheProgramWriter::write(const NANDAddress& address, etl::span<const uint8_t> data) {
+    return sendPage(address, data, false);
+}
 
-/* ============= Public Interface - Initialization ============= */
+etl::expected<void, NANDErrorCode> MT29F::CacheProgramWriter::finish(const NANDAddress& address, etl::span<const uint8_t> data) {
+    return sendPage(address, data, true);
+}
 
-etl::expected<void, NANDErrorCode> MT29F::initialize() {
-    if (isInitialized) {
-        return etl::unexpected(NANDErrorCode::ALREADY_INITIALIZED);
+etl::expected<void, NANDErrorCode> MT29F::CacheProgramWriter::sendPage(const NANDAddress& address,
+                                                                      etl::span<const uint8_t> data, bool isLastPage) {
+    if (not nand.isInitialized) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
     }
 
-    if (nandWriteProtectPin == PIO_PIN_NONE) {
-        LOG_INFO << "NAND: Write protection pin not provided. Hardware write protection disabled";
-    } else {
-        disableWrites();
+    if (auto validateResult = validateProgramRequest(address, data); not validateResult.has_value()) {
+        return validateResult;
     }
 
-    if (nandReadyBusyPin == PIO_PIN_NONE) {
-        LOG_INFO << "NAND: Ready/busy pin not provided. Using status register polling";
+    if (not isStreaming) {
+        if (auto readyResult = nand.ensureDeviceReady(); not readyResult.has_value()) {
+            return readyResult;
+        }
+
+        nand.enableWrites();
+        isStreaming = true;
+
+        if (auto writeEnabledResult = nand.verifyWriteEnabled(); not writeEnabledResult.has_value()) {
+            endStream();
+            return writeEnabledResult;
+        }
     }
 
-    if (auto resetResult = reset(); not resetResult.has_value()) {
-        LOG_ERROR << "NAND: Reset failed";
-        return resetResult;
+    AddressCycles cycles;
+    buildAddressCycles(address, cycles);
+
+    nand.sendCommand(Commands::PAGE_PROGRAM);
+
+    for (const auto& cycle : cycles) {
+        nand.sendAddress(cycle);
     }
 
-    etl::array<uint8_t, 5> deviceId;
-    
-    readDeviceID(deviceId);
+    busyWaitNanoseconds(nand.activeTiming->adlNs);
 
-    if (not etl::equal(ExpectedDeviceId.begin(), ExpectedDeviceId.end(), deviceId.begin())) {
-        LOG_ERROR << "NAND: Device ID mismatch";
+    if (auto transferResult = nand.sendDataBlock(data); not transferResult.has_value()) {
+        endStream();
+        return transferResult;
     }
 
-    constexpr etl::array<uint8_t, 4> ExpectedOnfi { 'O', 'N', 'F', 'I' };
-    
-    etl::array<uint8_t, 4> onfiSignature;
+    nand.sendCommand(isLastPage ? Commands::PAGE_PROGRAM_CONFIRM : Commands::PAGE_PROGRAM_CACHE);
 
-    readONFISignature(onfiSignature);
+    busyWaitNanoseconds(nand.activeTiming->wbNs);
 
-    if (not etl::equal(onfiSignature.begin(), onfiSignature.end(), ExpectedOnfi.begin())) {
-        LOG_ERROR << "NAND: ONFI signature verification failed";
+    const uint8_t ReadyMask = isLastPage ? (StatusReady | StatusArrayReady) : StatusReady;
+    const uint32_t TimeoutUs = hasPageInFlight ? (2U * TimeoutProgramUs) : TimeoutProgramUs;
+
+    if (auto waitResult = nand.waitForReady(TimeoutUs, ReadyMask); not waitResult.has_value()) {
+        endStream();
+        return waitResult;
     }
 
-    if (auto parameterResult = validateDeviceParameters(); not parameterResult.has_value()) {
-        return parameterResult;
+    const uint8_t Status = nand.readStatusRegister();
+    bool allSucceeded = true;
+
+    if (hasPageInFlight) {
+        allSucceeded = report(pageInFlight, (Status & StatusFailCommand) == 0U);
     }
 
-    if (auto scanResult = scanFactoryBadBlocks(); not scanResult.has_value()) {
-        return scanResult;
+    hasPageInFlight = true;
+    pageInFlight = address;
+
+    if (isLastPage) {
+        allSucceeded = report(address, (Status & StatusFail) == 0U) and allSucceeded;
+        hasPageInFlight = false;
+        endStream();
     }
 
-    isInitialized = true;
+    if (not allSucceeded) {
+        return etl::unexpected(NANDErrorCode::PROGRAM_FAILED);
+    }
 
     return {};
 }
 
-etl::expected<void, NANDErrorCode> MT29F::reset() {
-    sendCommand(Commands::RESET);
+bool MT29F::CacheProgramWriter::report(const NANDAddress& address, bool programSucceeded) {
+    if (not programSucceeded) {
+        nand.operationStatistics.statusFailures++;
+    }
 
-    busyWaitNanoseconds(TwbNs);
+    statusSink.call_if(address, programSucceeded);
 
-    if (auto waitResult = waitForReady(TimeoutResetUs); not waitResult.has_value()) {
-        return waitResult;
+    return programSucceeded;
+}
+
+void MT29F::CacheProgramWriter::endStream() {
+    if (hasPageInFlight) {
+        const bool IsArrayIdle = nand.waitForReady(TimeoutProgramUs).has_value();
+        const uint8_t Status = nand.readStatusRegister();
+
+        report(pageInFlight, IsArrayIdle and ((Status & StatusFail) == 0U));
+        hasPageInFlight = false;
     }
 
-    return {};
+    nand.disableWrites();
+    isStreaming = false;
 }
 
+/* ============= Public Interface - Bad Block Management ============= */
 
-/* ============= Public Interface - Data Operations ============= */
+etl::expected<bool, NANDErrorCode> MT29F::isBlockBad(uint16_t block, uint8_t lun) const {
+    if ((block >= BlocksPerLun) or (lun >= LunsPerCe)) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
 
-etl::expected<void, NANDErrorCode> MT29F::readPage(const NANDAddress& address, etl::span<uint8_t> data) {
+    return badBlockBitset[lun].test(block) or (block >= UsableBlocksPerLun);
+}
+
+
+/* ==================== Multi-Plane Operations ==================== */
+
+etl::expected<void, NANDErrorCode> MT29F::eraseBlockMultiPlane(uint16_t block0, uint16_t block1, uint8_t lun) {
     if (not isInitialized) {
         return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
     }
 
-    if (data.size() > (TotalBytesPerPage - address.column)) {
-        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
-    }
-
-    if (auto validateResult = validateAddress(address); not validateResult.has_value()) {
-        return validateResult;
+    if (auto pairResult = validatePlanePair(block0, block1, lun); not pairResult.has_value()) {
+        return pairResult;
     }
 
     if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
         return readyResult;
     }
 
-    if (auto commandResult = executeReadCommandSequence(address); not commandResult.has_value()) {
-        return commandResult;
-    }
+    LatencyProbe probe { operationStatistics.erase };
 
-    for (auto& byte : data) {
-        byte = readData();
+    storeReadRetryOption(block0, 0U);
+    storeReadRetryOption(block1, 0U);
+
+    const NANDAddress Address0 { lun, block0, 0U, 0U };
+    const NANDAddress Address1 { lun, block1, 0U, 0U };
+    AddressCycles cycles0;
+    AddressCycles cycles1;
+    buildAddressCycles(Address0, cycles0);
+    buildAddressCycles(Address1, cycles1);
+
+    {
+        WriteEnableGuard guard(*this);
+
+        if (auto writeEnabledResult = verifyWriteEnabled(); not writeEnabledResult.has_value()) {
+            return writeEnabledResult;
+        }
+
+        sendCommand(Commands::ERASE_BLOCK);
+
+        sendAddress(cycles0[static_cast<size_t>(AddressCycle::ROW_ADDRESS_1)]);
+        sendAddress(cycles0[static_cast<size_t>(AddressCycle::ROW_ADDRESS_2)]);
+        sendAddress(cycles0[static_cast<size_t>(AddressCycle::ROW_ADDRESS_3)]);
+
+        sendCommand(Commands::ERASE_MULTIPLANE_CONFIRM);
+
+        sendCommand(Commands::ERASE_BLOCK);
+
+        sendAddress(cycles1[static_cast<size_t>(AddressCycle::ROW_ADDRESS_1)]);
+        sendAddress(cycles1[static_cast<size_t>(AddressCycle::ROW_ADDRESS_2)]);
+        sendAddress(cycles1[static_cast<size_t>(AddressCycle::ROW_ADDRESS_3)]);
+
+        sendCommand(Commands::ERASE_BLOCK_CONFIRM);
+
+        busyWaitNanoseconds(activeTiming->wbNs);
+
+        if (auto waitResult = waitForReady(TimeoutEraseUs, StatusReady | StatusArrayReady, BusyOperation::ERASE);
+            not waitResult.has_value()) {
+            return waitResult;
+        }
     }
 
-    busyWaitNanoseconds(TrhwNs);
+    if (hasOperationFailed(readStatusRegister())) {
+        operationStatistics.statusFailures++;
+        return etl::unexpected(NANDErrorCode::MULTIPLANE_FAILED);
+    }
 
     return {};
 }
 
-etl::expected<void, NANDErrorCode> MT29F::programPage(const NANDAddress& address, etl::span<const uint8_t> data) {
+etl::expected<void, NANDErrorCode> MT29F::programPageMultiPlane(uint16_t block0, uint16_t block1, uint8_t page,
+                                                                etl::span<const uint8_t> data0,
+                                                                etl::span<const uint8_t> data1, uint8_t lun) {
     if (not isInitialized) {
         return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
     }
 
-    if (data.size() > (TotalBytesPerPage - address.column)) {
-        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    if (auto pairResult = validatePlanePair(block0, block1, lun); not pairResult.has_value()) {
+        return pairResult;
     }
 
-    if ((address.column <= BlockMarkerOffset) and ((address.column + data.size()) > BlockMarkerOffset)) {
-        const size_t MarkerIndex = BlockMarkerOffset - address.column;
-        const uint8_t MarkerValue = data[MarkerIndex];
+    const NANDAddress Address0 { lun, block0, page, 0U };
+    const NANDAddress Address1 { lun, block1, page, 0U };
 
-        if (MarkerValue != GoodBlockMarker) {
-            return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
-        }
+    if (auto validateResult = validateProgramRequest(Address0, data0); not validateResult.has_value()) {
+        return validateResult;
     }
 
-    if (auto validateResult = validateAddress(address); not validateResult.has_value()) {
+    if (auto validateResult = validateProgramRequest(Address1, data1); not validateResult.has_value()) {
         return validateResult;
     }
 
@@ -530,8 +2202,12 @@ etl::expected<void, NANDErrorCode> MT29F::programPage(const NANDAddress& address
         return readyResult;
     }
 
-    AddressCycles cycles;
-    buildAddressCycles(address, cycles);
+    LatencyProbe probe { operationStatistics.program };
+
+    AddressCycles cycles0;
+    AddressCycles cycles1;
+    buildAddressCycles(Address0, cycles0);
+    buildAddressCycles(Address1, cycles1);
 
     {
         WriteEnableGuard guard(*this);
@@ -542,38 +2218,70 @@ etl::expected<void, NANDErrorCode> MT29F::programPage(const NANDAddress& address
 
         sendCommand(Commands::PAGE_PROGRAM);
 
-        for (const auto& cycle : cycles) {
+        for (const auto& cycle : cycles0) {
+            sendAddress(cycle);
+        }
+
+        busyWaitNanoseconds(activeTiming->adlNs);
+
+        if (auto transferResult = sendDataBlock(data0); not transferResult.has_value()) {
+            return transferResult;
+        }
+
+        sendCommand(Commands::PAGE_PROGRAM_MULTIPLANE_CONFIRM);
+
+        busyWaitNanoseconds(activeTiming->wbNs);
+
+        if (auto waitResult = waitForReady(TimeoutDummyBusyUs, StatusReady); not waitResult.has_value()) {
+            return waitResult;
+        }
+
+        sendCommand(Commands::PAGE_PROGRAM_MULTIPLANE);
+
+        for (const auto& cycle : cycles1) {
             sendAddress(cycle);
         }
 
-        busyWaitNanoseconds(TadlNs);
+        busyWaitNanoseconds(activeTiming->adlNs);
 
-        for (const auto& byte : data) {
-            sendData(byte);
+        if (auto transferResult = sendDataBlock(data1); not transferResult.has_value()) {
+            return transferResult;
         }
 
         sendCommand(Commands::PAGE_PROGRAM_CONFIRM);
 
-        busyWaitNanoseconds(TwbNs);
+        busyWaitNanoseconds(activeTiming->wbNs);
 
-        if (auto waitResult = waitForReady(TimeoutProgramUs); not waitResult.has_value()) {
+        if (auto waitResult = waitForReady(TimeoutProgramUs, StatusReady | StatusArrayReady, BusyOperation::PROGRAM);
+            not waitResult.has_value()) {
             return waitResult;
         }
     }
 
     if (hasOperationFailed(readStatusRegister())) {
-        return etl::unexpected(NANDErrorCode::PROGRAM_FAILED);
+        operationStatistics.statusFailures++;
+        return etl::unexpected(NANDErrorCode::MULTIPLANE_FAILED);
     }
 
     return {};
 }
 
-etl::expected<void, NANDErrorCode> MT29F::eraseBlock(uint16_t block, uint8_t lun) {
+etl::expected<void, NANDErrorCode> MT29F::readPageMultiPlane(uint16_t block0, uint16_t block1, uint8_t page,
+                                                             etl::span<uint8_t> data0, etl::span<uint8_t> data1,
+                                                             uint8_t lun) {
     if (not isInitialized) {
         return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
     }
 
-    if ((block >= BlocksPerLun) or (lun >= LunsPerCe)) {
+    if (auto pairResult = validatePlanePair(block0, block1, lun); not pairResult.has_value()) {
+        return pairResult;
+    }
+
+    if ((data0.size() > TotalBytesPerPage) or (data1.size() > TotalBytesPerPage)) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if (page >= PagesPerBlock) {
         return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
     }
 
@@ -581,58 +2289,49 @@ etl::expected<void, NANDErrorCode> MT29F::eraseBlock(uint16_t block, uint8_t lun
         return readyResult;
     }
 
-    const NANDAddress Address { lun, block, 0U, 0U };
-    AddressCycles cycles;
-    buildAddressCycles(Address, cycles);
-
-    {
-        WriteEnableGuard guard(*this);
+    LatencyProbe probe { operationStatistics.read };
 
-        if (auto writeEnabledResult = verifyWriteEnabled(); not writeEnabledResult.has_value()) {
-            return writeEnabledResult;
-        }
+    const NANDAddress Address0 { lun, block0, page, 0U };
+    const NANDAddress Address1 { lun, block1, page, 0U };
+    AddressCycles cycles0;
+    buildAddressCycles(Address0, cycles0);
 
-        sendCommand(Commands::ERASE_BLOCK);
+    sendCommand(Commands::READ_MODE);
 
-        sendAddress(cycles[static_cast<size_t>(AddressCycle::ROW_ADDRESS_1)]);
-        sendAddress(cycles[static_cast<size_t>(AddressCycle::ROW_ADDRESS_2)]);
-        sendAddress(cycles[static_cast<size_t>(AddressCycle::ROW_ADDRESS_3)]);
+    for (const auto& cycle : cycles0) {
+        sendAddress(cycle);
+    }
 
-        sendCommand(Commands::ERASE_BLOCK_CONFIRM);
+    sendCommand(Commands::READ_MULTIPLANE);
 
-        busyWaitNanoseconds(TwbNs);
+    busyWaitNanoseconds(activeTiming->wbNs);
 
-        if (auto waitResult = waitForReady(TimeoutEraseUs); not waitResult.has_value()) {
-            return waitResult;
-        }
+    if (auto waitResult = waitForReady(TimeoutDummyBusyUs, StatusReady); not waitResult.has_value()) {
+        return waitResult;
     }
 
-    if (hasOperationFailed(readStatusRegister())) {
-        return etl::unexpected(NANDErrorCode::ERASE_FAILED);
+    if (auto commandResult = executeReadCommandSequence(Address1); not commandResult.has_value()) {
+        return commandResult;
     }
 
-    return {};
-}
-
+    changeReadColumnEnhanced(Address0);
 
-/* ============= Public Interface - Bad Block Management ============= */
-
-etl::expected<bool, NANDErrorCode> MT29F::isBlockBad(uint16_t block, uint8_t lun) const {
-    if ((block >= BlocksPerLun) or (lun >= LunsPerCe)) {
-        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    if (auto transferResult = readDataBlock(data0); not transferResult.has_value()) {
+        return transferResult;
     }
 
-    return badBlockBitset[lun].test(block);
-}
+    changeReadColumnEnhanced(Address1);
 
+    if (auto transferResult = readDataBlock(data1); not transferResult.has_value()) {
+        return transferResult;
+    }
 
-/* ==================== Multi-Plane Operations ==================== */
+    busyWaitNanoseconds(activeTiming->rhwNs);
 
-etl::expected<void, NANDErrorCode> MT29F::eraseBlockMultiPlane(uint16_t block0, uint16_t block1, uint8_t lun) {
-    if (not isInitialized) {
-        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
-    }
+    return {};
+}
 
+etl::expected<void, NANDErrorCode> MT29F::validatePlanePair(uint16_t block0, uint16_t block1, uint8_t lun) {
     if ((block0 >= BlocksPerLun) or (block1 >= BlocksPerLun) or (lun >= LunsPerCe)) {
         return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
     }
@@ -641,52 +2340,24 @@ etl::expected<void, NANDErrorCode> MT29F::eraseBlockMultiPlane(uint16_t block0,
         return etl::unexpected(NANDErrorCode::PLANE_MISMATCH);
     }
 
-    if (auto readyResult = ensureDeviceReady(); not readyResult.has_value()) {
-        return readyResult;
-    }
-
-    const NANDAddress Address0 { lun, block0, 0U, 0U };
-    const NANDAddress Address1 { lun, block1, 0U, 0U };
-    AddressCycles cycles0;
-    AddressCycles cycles1;
-    buildAddressCycles(Address0, cycles0);
-    buildAddressCycles(Address1, cycles1);
-
-    {
-        WriteEnableGuard guard(*this);
-
-        if (auto writeEnabledResult = verifyWriteEnabled(); not writeEnabledResult.has_value()) {
-            return writeEnabledResult;
-        }
-
-        sendCommand(Commands::ERASE_BLOCK);
-
-        sendAddress(cycles0[static_cast<size_t>(AddressCycle::ROW_ADDRESS_1)]);
-        sendAddress(cycles0[static_cast<size_t>(AddressCycle::ROW_ADDRESS_2)]);
-        sendAddress(cycles0[static_cast<size_t>(AddressCycle::ROW_ADDRESS_3)]);
-
-        sendCommand(Commands::ERASE_MULTIPLANE_CONFIRM);
-
-        sendCommand(Commands::ERASE_BLOCK);
+    return {};
+}
 
-        sendAddress(cycles1[static_cast<size_t>(AddressCycle::ROW_ADDRESS_1)]);
-        sendAddress(cycles1[static_cast<size_t>(AddressCycle::ROW_ADDRESS_2)]);
-        sendAddress(cycles1[static_cast<size_t>(AddressCycle::ROW_ADDRESS_3)]);
+void MT29F::changeReadColumnEnhanced(const NANDAddress& address) {
+    AddressCycles cycles;
+    buildAddressCycles(address, cycles);
 
-        sendCommand(Commands::ERASE_BLOCK_CONFIRM);
+    busyWaitNanoseconds(activeTiming->rhwNs);
 
-        busyWaitNanoseconds(TwbNs);
+    sendCommand(Commands::CHANGE_READ_COLUMN_ENHANCED);
 
-        if (auto waitResult = waitForReady(TimeoutEraseUs); not waitResult.has_value()) {
-            return waitResult;
-        }
+    for (const auto& cycle : cycles) {
+        sendAddress(cycle);
     }
 
-    if (hasOperationFailed(readStatusRegister())) {
-        return etl::unexpected(NANDErrorCode::MULTIPLANE_FAILED);
-    }
+    sendCommand(Commands::CHANGE_READ_COLUMN_CONFIRM);
 
-    return {};
+    busyWaitNanoseconds(TccsNs);
 }
 
 
@@ -719,6 +2390,8 @@ etl::expected<void, NANDErrorCode> MT29F::copybackRead(const NANDAddress& source
         return readyResult;
     }
 
+    LatencyProbe probe { operationStatistics.read };
+
     AddressCycles cycles;
     buildAddressCycles(sourceAddress, cycles);
 
@@ -730,9 +2403,10 @@ etl::expected<void, NANDErrorCode> MT29F::copybackRead(const NANDAddress& source
 
     sendCommand(Commands::COPYBACK_READ_CONFIRM);
 
-    busyWaitNanoseconds(TwbNs);
+    busyWaitNanoseconds(activeTiming->wbNs);
 
-    if (auto waitResult = waitForReady(TimeoutReadUs); not waitResult.has_value()) {
+    if (auto waitResult = waitForReady(TimeoutReadUs, StatusReady | StatusArrayReady, BusyOperation::ARRAY_READ);
+        not waitResult.has_value()) {
         return waitResult;
     }
 
@@ -752,6 +2426,8 @@ etl::expected<void, NANDErrorCode> MT29F::copybackProgram(const NANDAddress& des
         return readyResult;
     }
 
+    LatencyProbe probe { operationStatistics.program };
+
     AddressCycles cycles;
     buildAddressCycles(destinationAddress, cycles);
 
@@ -770,14 +2446,16 @@ etl::expected<void, NANDErrorCode> MT29F::copybackProgram(const NANDAddress& des
 
         sendCommand(Commands::PAGE_PROGRAM_CONFIRM);
 
-        busyWaitNanoseconds(TwbNs);
+        busyWaitNanoseconds(activeTiming->wbNs);
 
-        if (auto waitResult = waitForReady(TimeoutProgramUs); not waitResult.has_value()) {
+        if (auto waitResult = waitForReady(TimeoutProgramUs, StatusReady | StatusArrayReady, BusyOperation::PROGRAM);
+            not waitResult.has_value()) {
             return waitResult;
         }
     }
 
     if (hasOperationFailed(readStatusRegister())) {
+        operationStatistics.statusFailures++;
         return etl::unexpected(NANDErrorCode::COPYBACK_FAILED);
     }
 
@@ -0,0 +1,961 @@
+#include "NANDLogStore.hpp"
+#include "LittleEndian.hpp"
+#include <etl/algorithm.h>
+
+/* ============= Public Interface ============= */
+
+etl::expected<void, NANDErrorCode> NANDLogStore::format() {
+    if (mounted) {
+        return etl::unexpected(NANDErrorCode::ALREADY_INITIALIZED);
+    }
+
+    if (auto geometryResult = validateGeometry(); not geometryResult.has_value()) {
+        return geometryResult;
+    }
+
+    for (uint16_t segment = 0U; segment < getSegmentCount(); segment++) {
+        index[segment] = IndexEntry{};
+
+        auto badResult = nand.isBlockBad(toBlock(segment));
+
+        if (not badResult.has_value()) {
+            return etl::unexpected(badResult.error());
+        }
+
+        if (*badResult) {
+            continue;
+        }
+
+        if (auto eraseResult = nand.eraseBlock(toBlock(segment)); not eraseResult.has_value()) {
+            if (eraseResult.error() != NANDErrorCode::ERASE_FAILED) {
+                return eraseResult;
+            }
+
+            (void) nand.markBadBlock(toBlock(segment));
+            continue;
+        }
+
+        statistics.erasedSegments++;
+    }
+
+    if (mram != nullptr) {
+        if (auto mirrorResult = writeMirror(); not mirrorResult.has_value()) {
+            return mirrorResult;
+        }
+    }
+
+    resetWriteBuffer();
+    writeSegment = NoSegment;
+    lastSegment = NoSegment;
+    writePage = 0U;
+    nextSequence = 0U;
+    hasRecords = false;
+    lastTimestamp = 0U;
+    mounted = true;
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::mount() {
+    if (mounted) {
+        return etl::unexpected(NANDErrorCode::ALREADY_INITIALIZED);
+    }
+
+    if (auto geometryResult = validateGeometry(); not geometryResult.has_value()) {
+        return geometryResult;
+    }
+
+    bool isIndexLoaded = false;
+
+    if (mram != nullptr) {
+        auto loadResult = loadMirror();
+
+        if (loadResult.has_value()) {
+            isIndexLoaded = true;
+        } else if (loadResult.error() != NANDErrorCode::JOURNAL_INVALID) {
+            return loadResult;
+        }
+    }
+
+    if (not isIndexLoaded) {
+        for (uint16_t segment = 0U; segment < getSegmentCount(); segment++) {
+            auto scanResult = scanSegment(segment);
+
+            if (not scanResult.has_value()) {
+                return etl::unexpected(scanResult.error());
+            }
+
+            index[segment] = *scanResult;
+        }
+
+        if (mram != nullptr) {
+            if (auto mirrorResult = writeMirror(); not mirrorResult.has_value()) {
+                return mirrorResult;
+            }
+        }
+    }
+
+    resetWriteBuffer();
+
+    if (auto endResult = locateEnd(); not endResult.has_value()) {
+        return endResult;
+    }
+
+    if (mram != nullptr) {
+        if (auto restoreResult = restoreStagedPage(); not restoreResult.has_value()) {
+            return restoreResult;
+        }
+    }
+
+    mounted = true;
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::append(uint32_t timestamp, etl::span<const uint8_t> payload,
+                                                        bool isCompressing) {
+    if (not mounted) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (payload.empty() or (payload.size() > MaxPayloadBytes) or (hasRecords and (timestamp < lastTimestamp))) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    const uint32_t StartCycles = MT29F::readCycleCounter();
+
+    /* The previous record filled the page */
+    if (bufferedBytes == MT29F::DataBytesPerPage) {
+        if (auto programResult = programBufferedPage(getBufferedPageHeader()); not programResult.has_value()) {
+            statistics.busyUs += MT29F::getElapsedMicroseconds(StartCycles);
+            return programResult;
+        }
+    }
+
+    etl::span<const uint8_t> stored = payload;
+    uint16_t lengthField = static_cast<uint16_t>(payload.size());
+    uint32_t compressUs = 0U;
+
+    if (isCompressing) {
+        const uint32_t CompressCycles = MT29F::readCycleCounter();
+
+        /* Only kept when smaller than the payload */
+        auto compressResult = codec.compress(payload, etl::span<uint8_t>(payloadBuffer).first(payload.size() - 1U));
+
+        compressUs = MT29F::getElapsedMicroseconds(CompressCycles);
+
+        if (compressResult.has_value()) {
+            stored = etl::span<const uint8_t>(payloadBuffer).first(*compressResult);
+            lengthField = static_cast<uint16_t>(*compressResult) | CompressedFlag;
+        }
+    }
+
+    etl::array<uint8_t, RecordHeaderBytes> header{};
+
+    LittleEndian::storeHalfWord(header, 0U, lengthField);
+    LittleEndian::storeWord(header, sizeof(uint16_t), timestamp);
+
+    const uint16_t RecordBytes = static_cast<uint16_t>(RecordHeaderBytes + stored.size());
+    const uint16_t HeadBytes = etl::min<uint16_t>(RecordBytes, MT29F::DataBytesPerPage - bufferedBytes);
+
+    copyRecordBytes(header, stored, 0U, etl::span<uint8_t>(writeBuffer).subspan(bufferedBytes, HeadBytes));
+
+    if (HeadBytes < RecordBytes) {
+        /* Split: the page is full with the head of the record, the rest starts the next page */
+        PageHeader pageHeader = getBufferedPageHeader();
+
+        pageHeader.lastTimestamp = timestamp;
+        pageHeader.usedBytes = MT29F::DataBytesPerPage;
+        pageHeader.recordCount++;
+
+        if (auto programResult = programBufferedPage(pageHeader); not programResult.has_value()) {
+            etl::fill(writeBuffer.begin() + bufferedBytes, writeBuffer.end(), 0xFFU);
+            statistics.busyUs += MT29F::getElapsedMicroseconds(StartCycles);
+            return programResult;
+        }
+
+        copyRecordBytes(header, stored, HeadBytes, etl::span<uint8_t>(writeBuffer).first(RecordBytes - HeadBytes));
+        bufferedBytes = RecordBytes - HeadBytes;
+        bufferedContinuedBytes = bufferedBytes;
+        bufferFirstTimestamp = timestamp;
+    } else {
+        if (bufferedBytes == 0U) {
+            bufferFirstTimestamp = timestamp;
+        }
+
+        bufferedBytes += RecordBytes;
+        bufferedRecords++;
+    }
+
+    bufferLastTimestamp = timestamp;
+    lastTimestamp = timestamp;
+    hasRecords = true;
+    statistics.appendedRecords++;
+    statistics.compressedRecords += ((lengthField & CompressedFlag) != 0U) ? 1U : 0U;
+    statistics.payloadBytes += payload.size();
+    statistics.storedBytes += RecordBytes;
+    statistics.compressUs += compressUs;
+    statistics.busyUs += MT29F::getElapsedMicroseconds(StartCycles);
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::flush() {
+    if (not mounted) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (bufferedBytes == 0U) {
+        return {};
+    }
+
+    const uint32_t StartCycles = MT29F::readCycleCounter();
+    etl::expected<void, NANDErrorCode> flushResult;
+
+    if ((mram != nullptr) and (bufferedBytes < MT29F::DataBytesPerPage)) {
+        statistics.stagedFlushes++;
+        flushResult = stageBufferedPage();
+    } else {
+        statistics.flushedPages += (bufferedBytes < MT29F::DataBytesPerPage) ? 1U : 0U;
+        flushResult = programBufferedPage(getBufferedPageHeader());
+    }
+
+    statistics.busyUs += MT29F::getElapsedMicroseconds(StartCycles);
+
+    return flushResult;
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::readRange(uint32_t startTime, uint32_t endTime, RecordSink sink) {
+    if (not mounted) {
+        return etl::unexpected(NANDErrorCode::NOT_INITIALIZED);
+    }
+
+    if (startTime > endTime) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    uint16_t segment = seekSegment(startTime);
+    uint8_t firstPage = 0U;
+    bool isOpen = true;
+
+    pendingBytes = 0U;
+
+    if (segment != NoSegment) {
+        auto seekResult = seekPage(segment, startTime);
+
+        if (not seekResult.has_value()) {
+            return etl::unexpected(seekResult.error());
+        }
+
+        firstPage = *seekResult;
+    }
+
+    while ((segment != NoSegment) and isOpen) {
+        for (uint8_t page = firstPage; (page < getWrittenPages(segment)) and isOpen; page++) {
+            PageHeaderBytesArray headerBytes{};
+            auto readResult = nand.readPageEcc(toAddress(segment, page), getReadPage(), headerBytes);
+
+            if (not readResult.has_value()) {
+                if (readResult.error() != NANDErrorCode::ECC_UNCORRECTABLE) {
+                    return etl::unexpected(readResult.error());
+                }
+
+                statistics.skippedPages++;
+                dropPendingRecord();
+                continue;
+            }
+
+            /* Rest of a segment closed early by a program failure */
+            if (readResult->isErased) {
+                break;
+            }
+
+            PageHeader header;
+
+            if (not decodePageHeader(headerBytes, header)) {
+                statistics.skippedPages++;
+                dropPendingRecord();
+                continue;
+            }
+
+            isOpen = (header.firstTimestamp <= endTime) and deliverPage(header, startTime, endTime, sink);
+        }
+
+        segment = getNextSegment(segment);
+        firstPage = 0U;
+    }
+
+    /* The RAM page goes on from the last programmed one like any other page */
+    if (isOpen) {
+        etl::copy(writeBuffer.begin(), writeBuffer.begin() + bufferedBytes, getReadPage().begin());
+        (void) deliverPage(getBufferedPageHeader(), startTime, endTime, sink);
+    }
+
+    return {};
+}
+
+
+/* ============= Write Path ============= */
+
+void NANDLogStore::copyRecordBytes(etl::span<const uint8_t> header, etl::span<const uint8_t> stored, size_t offset,
+                                   etl::span<uint8_t> destination) {
+    size_t copied = 0U;
+
+    if (offset < header.size()) {
+        copied = etl::min(header.size() - offset, destination.size());
+        etl::copy_n(header.begin() + offset, copied, destination.begin());
+        offset += copied;
+    }
+
+    etl::copy_n(stored.begin() + (offset - header.size()), destination.size() - copied, destination.begin() + copied);
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::programBufferedPage(PageHeader header) {
+    for (uint16_t attempt = 0U; attempt < getSegmentCount(); attempt++) {
+        if ((writeSegment == NoSegment) or (writePage >= PagesPerSegment)) {
+            if (auto openResult = openSegment(header.firstTimestamp); not openResult.has_value()) {
+                return openResult;
+            }
+        }
+
+        header.sequence = index[writeSegment].sequence;
+
+        auto programResult = nand.programPageEcc(toAddress(writeSegment, writePage), writeBuffer,
+                                                 encodePageHeader(header));
+
+        if (programResult.has_value()) {
+            writePage++;
+            statistics.programmedPages++;
+            resetWriteBuffer();
+
+            return {};
+        }
+
+        if (programResult.error() != NANDErrorCode::PROGRAM_FAILED) {
+            return programResult;
+        }
+
+        /* The pages already in the segment stay readable; the block is erased again when the ring comes back */
+        statistics.failedPrograms++;
+        writeSegment = NoSegment;
+    }
+
+    return etl::unexpected(NANDErrorCode::NO_SPACE);
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::stageBufferedPage() {
+    if (stagedBytes == bufferedBytes) {
+        return {};
+    }
+
+    if ((writeSegment == NoSegment) or (writePage >= PagesPerSegment)) {
+        if (auto openResult = openSegment(bufferFirstTimestamp); not openResult.has_value()) {
+            return openResult;
+        }
+    }
+
+    const uint32_t HeaderOffset = getStagedHeaderOffset(getSegmentCount());
+    const etl::span<const uint8_t> NewBytes =
+        etl::span<const uint8_t>(writeBuffer).subspan(stagedBytes, bufferedBytes - stagedBytes);
+
+    /* Data first: a header only ever names bytes already in MRAM */
+    if (auto dataResult = writeMirrorBytes(HeaderOffset + (2U * StagedHeaderBytes) + stagedBytes, NewBytes);
+        not dataResult.has_value()) {
+        return dataResult;
+    }
+
+    PageHeader header = getBufferedPageHeader();
+
+    header.sequence = index[writeSegment].sequence;
+
+    const PageHeaderBytesArray PageHeaderField = encodePageHeader(header);
+    const uint8_t Generation = stagedGeneration + 1U;
+    etl::array<uint8_t, StagedHeaderBytes> bytes{};
+
+    etl::copy(PageHeaderField.begin(), PageHeaderField.end(), bytes.begin());
+    bytes[PageHeaderBytes] = writePage;
+    bytes[PageHeaderBytes + 1U] = Generation;
+    LittleEndian::storeHalfWord(bytes, PageHeaderBytes + 2U,
+                                MT29F::computeCrc16(etl::span<const uint8_t>(bytes).first(PageHeaderBytes + 2U)));
+
+    if (auto headerResult = writeMirrorBytes(HeaderOffset + ((Generation % 2U) * StagedHeaderBytes), bytes);
+        not headerResult.has_value()) {
+        return headerResult;
+    }
+
+    stagedGeneration = Generation;
+    stagedBytes = bufferedBytes;
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::restoreStagedPage() {
+    if ((writeSegment == NoSegment) or (writePage >= PagesPerSegment)) {
+        return {};
+    }
+
+    const uint32_t HeaderOffset = getStagedHeaderOffset(getSegmentCount());
+    etl::array<uint8_t, 2U * StagedHeaderBytes> bytes{};
+
+    if (auto readResult = readMirrorBytes(HeaderOffset, bytes); not readResult.has_value()) {
+        return readResult;
+    }
+
+    uint8_t newest = NoStagedSlot;
+    PageHeader header;
+
+    for (uint8_t slot = 0U; slot < 2U; slot++) {
+        const etl::span<const uint8_t> Slot =
+            etl::span<const uint8_t>(bytes).subspan(slot * StagedHeaderBytes, StagedHeaderBytes);
+        const uint16_t Crc = LittleEndian::loadHalfWord(Slot, PageHeaderBytes + 2U);
+        const uint8_t Generation = Slot[PageHeaderBytes + 1U];
+        PageHeader candidate;
+
+        /* Only a page saved at the current end of the log, older ones were programmed since */
+        if ((Crc != MT29F::computeCrc16(Slot.first(PageHeaderBytes + 2U))) or not decodePageHeader(Slot, candidate) or (candidate.sequence != index[writeSegment].sequence) or
+            (Slot[PageHeaderBytes] != writePage)) {
+            continue;
+        }
+
+        if ((newest == NoStagedSlot) or (static_cast<int8_t>(Generation - stagedGeneration) > 0)) {
+            newest = slot;
+            stagedGeneration = Generation;
+            header = candidate;
+        }
+    }
+
+    if ((newest == NoStagedSlot) or (header.usedBytes == 0U)) {
+        return {};
+    }
+
+    if (auto readResult = readMirrorBytes(HeaderOffset + (2U * StagedHeaderBytes),
+                                          etl::span<uint8_t>(writeBuffer).first(header.usedBytes));
+        not readResult.has_value()) {
+        return readResult;
+    }
+
+    bufferedBytes = header.usedBytes;
+    bufferedRecords = header.recordCount;
+    bufferedContinuedBytes = header.continuedBytes;
+    bufferFirstTimestamp = header.firstTimestamp;
+    bufferLastTimestamp = header.lastTimestamp;
+    stagedBytes = header.usedBytes;
+    lastTimestamp = header.lastTimestamp;
+    hasRecords = true;
+
+    return {};
+}
+
+NANDLogStore::PageHeader NANDLogStore::getBufferedPageHeader() const {
+    PageHeader header;
+
+    header.firstTimestamp = bufferFirstTimestamp;
+    header.lastTimestamp = bufferLastTimestamp;
+    header.usedBytes = bufferedBytes;
+    header.recordCount = bufferedRecords;
+    header.continuedBytes = bufferedContinuedBytes;
+
+    return header;
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::openSegment(uint32_t firstTimestamp) {
+    const uint16_t Start = (lastSegment == NoSegment) ? 0U : ((lastSegment + 1U) % getSegmentCount());
+
+    writeSegment = NoSegment;
+
+    for (uint16_t step = 0U; step < getSegmentCount(); step++) {
+        const uint16_t Segment = (Start + step) % getSegmentCount();
+        auto badResult = nand.isBlockBad(toBlock(Segment));
+
+        if (not badResult.has_value()) {
+            return etl::unexpected(badResult.error());
+        }
+
+        if (*badResult) {
+            continue;
+        }
+
+        /* Drop the oldest segment from the index (and the mirror) before its data goes */
+        if (index[Segment].sequence != EmptySequence) {
+            statistics.droppedSegments++;
+
+            if (auto dropResult = setIndexEntry(Segment, IndexEntry{}); not dropResult.has_value()) {
+                return dropResult;
+            }
+        }
+
+        if (auto eraseResult = nand.eraseBlock(toBlock(Segment)); not eraseResult.has_value()) {
+            if (eraseResult.error() != NANDErrorCode::ERASE_FAILED) {
+                return eraseResult;
+            }
+
+            (void) nand.markBadBlock(toBlock(Segment));
+            continue;
+        }
+
+        statistics.erasedSegments++;
+
+        if (auto indexResult = setIndexEntry(Segment, IndexEntry { nextSequence, firstTimestamp });
+            not indexResult.has_value()) {
+            return indexResult;
+        }
+
+        nextSequence++;
+        writeSegment = Segment;
+        lastSegment = Segment;
+        writePage = 0U;
+
+        return {};
+    }
+
+    return etl::unexpected(NANDErrorCode::NO_SPACE);
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::setIndexEntry(uint16_t segment, const IndexEntry& entry) {
+    index[segment] = entry;
+
+    if (mram == nullptr) {
+        return {};
+    }
+
+    return writeMirrorEntry(segment);
+}
+
+void NANDLogStore::resetWriteBuffer() {
+    writeBuffer.fill(0xFFU);
+    bufferedBytes = 0U;
+    bufferedRecords = 0U;
+    bufferedContinuedBytes = 0U;
+    stagedBytes = 0U;
+}
+
+
+/* ============= Index ============= */
+
+etl::expected<void, NANDErrorCode> NANDLogStore::validateGeometry() const {
+    if ((index.size() < 2U) or ((firstBlock + index.size()) > MT29F::UsableBlocksPerLun)) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    return {};
+}
+
+etl::expected<NANDLogStore::IndexEntry, NANDErrorCode> NANDLogStore::scanSegment(uint16_t segment) {
+    auto badResult = nand.isBlockBad(toBlock(segment));
+
+    if (not badResult.has_value()) {
+        return etl::unexpected(badResult.error());
+    }
+
+    if (*badResult) {
+        return IndexEntry{};
+    }
+
+    auto headerResult = readPageHeader(segment, 0U);
+
+    if (not headerResult.has_value()) {
+        if ((headerResult.error() != NANDErrorCode::INVALID_PARAMETER) and
+            (headerResult.error() != NANDErrorCode::ECC_UNCORRECTABLE)) {
+            return etl::unexpected(headerResult.error());
+        }
+
+        return IndexEntry{};
+    }
+
+    return IndexEntry { headerResult->sequence, headerResult->firstTimestamp };
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::loadMirror() {
+    constexpr size_t CrcOffset = 8U;
+
+    etl::array<uint8_t, MirrorHeaderBytes> header{};
+
+    if (auto readResult = readMirrorBytes(0U, header); not readResult.has_value()) {
+        return readResult;
+    }
+
+    if (not etl::equal(MirrorMagic.begin(), MirrorMagic.end(), header.begin()) or
+        (LittleEndian::loadHalfWord(header, 4U) != firstBlock) or (LittleEndian::loadHalfWord(header, 6U) != getSegmentCount()) or
+        (LittleEndian::loadHalfWord(header, CrcOffset) != MT29F::computeCrc16(etl::span<const uint8_t>(header).first(CrcOffset)))) {
+        return etl::unexpected(NANDErrorCode::JOURNAL_INVALID);
+    }
+
+    etl::array<uint8_t, MirrorTransferEntries * MirrorEntryBytes> entries{};
+
+    for (uint16_t base = 0U; base < getSegmentCount(); base += MirrorTransferEntries) {
+        const uint16_t Count = etl::min<uint16_t>(MirrorTransferEntries, getSegmentCount() - base);
+        const etl::span<uint8_t> Bytes = etl::span<uint8_t>(entries).first(Count * MirrorEntryBytes);
+
+        if (auto readResult = readMirrorBytes(MirrorHeaderBytes + (static_cast<uint32_t>(base) * MirrorEntryBytes), Bytes);
+            not readResult.has_value()) {
+            return readResult;
+        }
+
+        for (uint16_t entry = 0U; entry < Count; entry++) {
+            const etl::span<const uint8_t> Entry = Bytes.subspan(entry * MirrorEntryBytes, MirrorEntryBytes);
+            const uint16_t Segment = base + entry;
+
+            if (LittleEndian::loadHalfWord(Entry, CrcOffset) == MT29F::computeCrc16(Entry.first(CrcOffset))) {
+                index[Segment] = IndexEntry { LittleEndian::loadWord(Entry, 0U), LittleEndian::loadWord(Entry, sizeof(uint32_t)) };
+                continue;
+            }
+
+            /* Torn by a reset: ask the NAND */
+            auto scanResult = scanSegment(Segment);
+
+            if (not scanResult.has_value()) {
+                return etl::unexpected(scanResult.error());
+            }
+
+            if (auto indexResult = setIndexEntry(Segment, *scanResult); not indexResult.has_value()) {
+                return indexResult;
+            }
+        }
+    }
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::writeMirror() {
+    constexpr size_t CrcOffset = 8U;
+
+    /* Invalidate the header first, so that a reset in between does not leave stale entries behind a valid one */
+    etl::array<uint8_t, MirrorHeaderBytes> header{};
+
+    if (auto invalidateResult = writeMirrorBytes(0U, header); not invalidateResult.has_value()) {
+        return invalidateResult;
+    }
+
+    /* A page saved under an older mirror could name a place the new log reaches again */
+    const etl::array<uint8_t, 2U * StagedHeaderBytes> StagedHeaders{};
+
+    if (auto stagedResult = writeMirrorBytes(getStagedHeaderOffset(getSegmentCount()), StagedHeaders);
+        not stagedResult.has_value()) {
+        return stagedResult;
+    }
+
+    etl::array<uint8_t, MirrorTransferEntries * MirrorEntryBytes> entries{};
+
+    for (uint16_t base = 0U; base < getSegmentCount(); base += MirrorTransferEntries) {
+        const uint16_t Count = etl::min<uint16_t>(MirrorTransferEntries, getSegmentCount() - base);
+        const etl::span<uint8_t> Bytes = etl::span<uint8_t>(entries).first(Count * MirrorEntryBytes);
+
+        for (uint16_t entry = 0U; entry < Count; entry++) {
+            encodeMirrorEntry(index[base + entry], Bytes.subspan(entry * MirrorEntryBytes, MirrorEntryBytes));
+        }
+
+        if (auto writeResult = writeMirrorBytes(MirrorHeaderBytes + (static_cast<uint32_t>(base) * MirrorEntryBytes),
+                                                Bytes);
+            not writeResult.has_value()) {
+            return writeResult;
+        }
+    }
+
+    etl::copy(MirrorMagic.begin(), MirrorMagic.end(), header.begin());
+    LittleEndian::storeHalfWord(header, 4U, firstBlock);
+    LittleEndian::storeHalfWord(header, 6U, getSegmentCount());
+    LittleEndian::storeHalfWord(header, CrcOffset, MT29F::computeCrc16(etl::span<const uint8_t>(header).first(CrcOffset)));
+
+    return writeMirrorBytes(0U, header);
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::writeMirrorEntry(uint16_t segment) {
+    etl::array<uint8_t, MirrorEntryBytes> bytes{};
+
+    encodeMirrorEntry(index[segment], bytes);
+
+    return writeMirrorBytes(MirrorHeaderBytes + (static_cast<uint32_t>(segment) * MirrorEntryBytes), bytes);
+}
+
+void NANDLogStore::encodeMirrorEntry(const IndexEntry& entry, etl::span<uint8_t> bytes) {
+    constexpr size_t CrcOffset = 8U;
+
+    LittleEndian::storeWord(bytes, 0U, entry.sequence);
+    LittleEndian::storeWord(bytes, sizeof(uint32_t), entry.firstTimestamp);
+    LittleEndian::storeHalfWord(bytes, CrcOffset, MT29F::computeCrc16(etl::span<const uint8_t>(bytes).first(CrcOffset)));
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::writeMirrorBytes(uint32_t offset, etl::span<const uint8_t> bytes) {
+    if (mram->mramWriteData(mirrorAddress + offset, bytes) != MRAMError::NONE) {
+        return etl::unexpected(NANDErrorCode::JOURNAL_IO_FAILED);
+    }
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::readMirrorBytes(uint32_t offset, etl::span<uint8_t> bytes) {
+    if (mram->mramReadData(mirrorAddress + offset, bytes) != MRAMError::NONE) {
+        return etl::unexpected(NANDErrorCode::JOURNAL_IO_FAILED);
+    }
+
+    return {};
+}
+
+etl::expected<void, NANDErrorCode> NANDLogStore::locateEnd() {
+    uint16_t newest = NoSegment;
+
+    for (uint16_t segment = 0U; segment < getSegmentCount(); segment++) {
+        if ((index[segment].sequence != EmptySequence) and
+            ((newest == NoSegment) or (index[segment].sequence > index[newest].sequence))) {
+            newest = segment;
+        }
+    }
+
+    writeSegment = newest;
+    lastSegment = newest;
+    writePage = 0U;
+    hasRecords = (newest != NoSegment);
+    nextSequence = (newest != NoSegment) ? (index[newest].sequence + 1U) : 0U;
+    lastTimestamp = (newest != NoSegment) ? index[newest].firstTimestamp : 0U;
+
+    if (newest == NoSegment) {
+        return {};
+    }
+
+    /* Pages are programmed in order: binary search the first erased one */
+    uint8_t low = 0U;
+    uint8_t high = PagesPerSegment;
+
+    while (low < high) {
+        const uint8_t Middle = low + ((high - low) / 2U);
+        PageHeaderBytesArray headerBytes{};
+
+        statistics.headerReads++;
+        auto readResult = nand.readPageMetadataEcc(toAddress(newest, Middle), headerBytes);
+
+        if (not readResult.has_value() and (readResult.error() != NANDErrorCode::ECC_UNCORRECTABLE)) {
+            return etl::unexpected(readResult.error());
+        }
+
+        if (readResult.has_value() and readResult->isErased) {
+            high = Middle;
+        } else {
+            low = Middle + 1U;
+        }
+    }
+
+    writePage = low;
+
+    for (uint8_t page = writePage; page > 0U; page--) {
+        auto headerResult = readPageHeader(newest, page - 1U);
+
+        if (headerResult.has_value()) {
+            lastTimestamp = headerResult->lastTimestamp;
+            break;
+        }
+
+        if ((headerResult.error() != NANDErrorCode::INVALID_PARAMETER) and
+            (headerResult.error() != NANDErrorCode::ECC_UNCORRECTABLE)) {
+            return etl::unexpected(headerResult.error());
+        }
+    }
+
+    return {};
+}
+
+
+/* ============= Query ============= */
+
+uint16_t NANDLogStore::seekSegment(uint32_t startTime) const {
+    uint16_t best = NoSegment;
+    uint16_t oldest = NoSegment;
+
+    for (uint16_t segment = 0U; segment < getSegmentCount(); segment++) {
+        const IndexEntry& Entry = index[segment];
+
+        if (Entry.sequence == EmptySequence) {
+            continue;
+        }
+
+        if ((oldest == NoSegment) or (Entry.sequence < index[oldest].sequence)) {
+            oldest = segment;
+        }
+
+        /* Strictly older: records at startTime may end the previous segment */
+        if ((Entry.firstTimestamp < startTime) and ((best == NoSegment) or (Entry.sequence > index[best].sequence))) {
+            best = segment;
+        }
+    }
+
+    return (best != NoSegment) ? best : oldest;
+}
+
+uint16_t NANDLogStore::getNextSegment(uint16_t segment) const {
+    for (uint16_t step = 1U; step < getSegmentCount(); step++) {
+        const uint16_t Candidate = (segment + step) % getSegmentCount();
+
+        if (index[Candidate].sequence != EmptySequence) {
+            return (index[Candidate].sequence > index[segment].sequence) ? Candidate : NoSegment;
+        }
+    }
+
+    return NoSegment;
+}
+
+etl::expected<uint8_t, NANDErrorCode> NANDLogStore::seekPage(uint16_t segment, uint32_t startTime) {
+    uint8_t low = 0U;
+    uint8_t high = getWrittenPages(segment);
+
+    while (low < high) {
+        const uint8_t Middle = low + ((high - low) / 2U);
+        auto headerResult = readPageHeader(segment, Middle);
+
+        if (headerResult.has_value() and (headerResult->lastTimestamp < startTime)) {
+            low = Middle + 1U;
+            continue;
+        }
+
+        if (not headerResult.has_value() and (headerResult.error() != NANDErrorCode::INVALID_PARAMETER) and
+            (headerResult.error() != NANDErrorCode::ECC_UNCORRECTABLE)) {
+            return etl::unexpected(headerResult.error());
+        }
+
+        /* Unreadable headers count as later pages: the stream then starts early, never late */
+        high = Middle;
+    }
+
+    return low;
+}
+
+etl::expected<NANDLogStore::PageHeader, NANDErrorCode> NANDLogStore::readPageHeader(uint16_t segment, uint8_t page) {
+    PageHeaderBytesArray bytes{};
+
+    statistics.headerReads++;
+
+    if (auto readResult = nand.readPageMetadataEcc(toAddress(segment, page), bytes); not readResult.has_value()) {
+        return etl::unexpected(readResult.error());
+    }
+
+    PageHeader header;
+
+    if (not decodePageHeader(bytes, header)) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    return header;
+}
+
+bool NANDLogStore::deliverPage(const PageHeader& header, uint32_t startTime, uint32_t endTime, RecordSink& sink) {
+    const etl::span<const uint8_t> Records = etl::span<const uint8_t>(readBuffer)
+                                                 .subspan(MT29F::DataBytesPerPage - pendingBytes, pendingBytes + header.usedBytes);
+    const bool IsFull = (header.usedBytes == MT29F::DataBytesPerPage);
+    size_t offset = pendingBytes + header.continuedBytes;
+
+    if (pendingBytes > 0U) {
+        pendingBytes = 0U;
+
+        /* The head gives the length, this page the bytes ending the record: they must agree */
+        if ((offset < RecordHeaderBytes) or (offset != getRecordBytes(Records))) {
+            statistics.skippedRecords++;
+        } else if (not deliverRecord(Records.first(offset), startTime, endTime, sink)) {
+            return false;
+        }
+    }
+
+    while (offset < Records.size()) {
+        const etl::span<const uint8_t> Record = Records.subspan(offset);
+
+        if (Record.size() >= RecordHeaderBytes) {
+            const size_t RecordBytes = getRecordBytes(Record);
+
+            /* Corrupted framing: skip the rest of the page */
+            if (RecordBytes == RecordHeaderBytes) {
+                return true;
+            }
+
+            if (RecordBytes <= Record.size()) {
+                if (not deliverRecord(Record.first(RecordBytes), startTime, endTime, sink)) {
+                    return false;
+                }
+
+                offset += RecordBytes;
+                continue;
+            }
+
+            if (LittleEndian::loadWord(Record, sizeof(uint16_t)) > endTime) {
+                return false;
+            }
+        }
+
+        /* Only a full page ends with a split record, anything else is corrupted framing */
+        if (IsFull) {
+            etl::copy(Record.begin(), Record.end(), readBuffer.begin() + (MT29F::DataBytesPerPage - Record.size()));
+            pendingBytes = static_cast<uint16_t>(Record.size());
+        }
+
+        return true;
+    }
+
+    return true;
+}
+
+bool NANDLogStore::deliverRecord(etl::span<const uint8_t> record, uint32_t startTime, uint32_t endTime,
+                                 RecordSink& sink) {
+    const uint16_t LengthField = LittleEndian::loadHalfWord(record, 0U);
+    const uint32_t Timestamp = LittleEndian::loadWord(record, sizeof(uint16_t));
+    etl::span<const uint8_t> payload = record.subspan(RecordHeaderBytes);
+
+    if (Timestamp > endTime) {
+        return false;
+    }
+
+    if (Timestamp < startTime) {
+        return true;
+    }
+
+    if ((LengthField & CompressedFlag) != 0U) {
+        auto decompressResult = LZCodec::decompress(payload, payloadBuffer);
+
+        if (not decompressResult.has_value() or (*decompressResult == 0U)) {
+            statistics.skippedRecords++;
+            return true;
+        }
+
+        payload = etl::span<const uint8_t>(payloadBuffer).first(*decompressResult);
+    }
+
+    return sink(Timestamp, payload);
+}
+
+size_t NANDLogStore::getRecordBytes(etl::span<const uint8_t> bytes) {
+    return RecordHeaderBytes + (LittleEndian::loadHalfWord(bytes, 0U) & static_cast<uint16_t>(~CompressedFlag));
+}
+
+void NANDLogStore::dropPendingRecord() {
+    if (pendingBytes > 0U) {
+        statistics.skippedRecords++;
+        pendingBytes = 0U;
+    }
+}
+
+
+/* ============= Encoding ============= */
+
+NANDLogStore::PageHeaderBytesArray NANDLogStore::encodePageHeader(const PageHeader& header) {
+    PageHeaderBytesArray bytes{};
+
+    etl::copy(PageMagic.begin(), PageMagic.end(), bytes.begin());
+    LittleEndian::storeWord(bytes, 4U, header.sequence);
+    LittleEndian::storeWord(bytes, 8U, header.firstTimestamp);
+    LittleEndian::storeWord(bytes, 12U, header.lastTimestamp);
+    LittleEndian::storeHalfWord(bytes, 16U, header.usedBytes);
+    LittleEndian::storeHalfWord(bytes, 18U, header.recordCount);
+    LittleEndian::storeHalfWord(bytes, 20U, header.continuedBytes);
+
+    return bytes;
+}
+
+bool NANDLogStore::decodePageHeader(etl::span<const uint8_t> bytes, PageHeader& header) {
+    if (not etl::equal(PageMagic.begin(), PageMagic.end(), bytes.begin())) {
+        return false;
+    }
+
+    header.sequence = LittleEndian::loadWord(bytes, 4U);
+    header.firstTimestamp = LittleEndian::loadWord(bytes, 8U);
+    header.lastTimestamp = LittleEndian::loadWord(bytes, 12U);
+    header.usedBytes = LittleEndian::loadHalfWord(bytes, 16U);
+    header.recordCount = LittleEndian::loadHalfWord(bytes, 18U);
+    header.continuedBytes = LittleEndian::loadHalfWord(bytes, 20U);
+
+    return (header.usedBytes <= MT29F::DataBytesPerPage) and (header.continuedBytes <= header.usedBytes);
+}
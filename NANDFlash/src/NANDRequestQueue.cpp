@@ -0,0 +1,233 @@
+#include "NANDRequestQueue.hpp"
+
+/* ============= Public Interface ============= */
+
+etl::expected<void, NANDErrorCode> NANDRequestQueue::submit(const Request& request) {
+    if (((request.operation == Operation::READ) and request.readData.empty()) or
+        ((request.operation == Operation::PROGRAM) and request.programData.empty())) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    lock();
+
+    uint8_t freeSlot = NoSlot;
+
+    for (uint8_t slot = 0U; slot < Capacity; slot++) {
+        if (not slots[slot].isPending) {
+            freeSlot = slot;
+            break;
+        }
+    }
+
+    if (freeSlot == NoSlot) {
+        statistics.rejected++;
+        unlock();
+        return etl::unexpected(NANDErrorCode::QUEUE_FULL);
+    }
+
+    slots[freeSlot].request = request;
+    slots[freeSlot].order = nextOrder;
+    slots[freeSlot].isPending = true;
+    nextOrder++;
+    pendingCount++;
+    statistics.submitted++;
+    statistics.maxDepth = etl::max(statistics.maxDepth, pendingCount);
+
+    unlock();
+
+    if (wakeWorker.is_valid()) {
+        wakeWorker();
+    }
+
+    return {};
+}
+
+uint32_t NANDRequestQueue::serviceRequests(NotificationWaitDelegate waitNotification, uint32_t idleTimeoutUs) {
+    uint32_t completed = 0U;
+
+    while (true) {
+        const uint32_t Serviced = serviceNext();
+
+        if (Serviced == 0U) {
+            break;
+        }
+
+        completed += Serviced;
+    }
+
+    if ((completed == 0U) and waitNotification.is_valid()) {
+        (void) waitNotification(idleTimeoutUs);
+    }
+
+    return completed;
+}
+
+uint32_t NANDRequestQueue::serviceNext() {
+    etl::array<Request, MaxCoalescedReads> batch;
+    const uint8_t Taken = takeNext(batch);
+
+    if (Taken == 0U) {
+        return 0U;
+    }
+
+    const etl::span<const Request> Requests { batch.data(), Taken };
+
+    if (Taken > 1U) {
+        statistics.coalescedReads += Taken - 1U;
+
+        const auto Result = executeReads(Requests);
+
+        for (const auto& request : Requests) {
+            complete(request, Result);
+        }
+    } else {
+        complete(Requests[0], execute(Requests[0]));
+    }
+
+    return Taken;
+}
+
+
+/* ============= Scheduling ============= */
+
+uint8_t NANDRequestQueue::takeNext(etl::array<Request, MaxCoalescedReads>& batch) {
+    lock();
+
+    uint8_t next = NoSlot;
+
+    for (uint8_t slot = 0U; slot < Capacity; slot++) {
+        /* Requests never overtake an older one on the same page or block, whatever their priority */
+        if (not slots[slot].isPending or dependsOnOlder(slot)) {
+            continue;
+        }
+
+        if ((next == NoSlot) or (slots[slot].request.priority < slots[next].request.priority) or
+            ((slots[slot].request.priority == slots[next].request.priority) and isOlder(slot, next))) {
+            next = slot;
+        }
+    }
+
+    if (next == NoSlot) {
+        unlock();
+        return 0U;
+    }
+
+    uint8_t taken = 0U;
+    const bool CanCoalesce =
+        (slots[next].request.operation == Operation::READ) and (slots[next].request.address.column == 0U);
+
+    while (next != NoSlot) {
+        batch[taken] = slots[next].request;
+        slots[next].isPending = false;
+        pendingCount--;
+        taken++;
+
+        next = (CanCoalesce and (taken < MaxCoalescedReads)) ? findFollowingRead(batch[taken - 1U].address) : NoSlot;
+    }
+
+    unlock();
+
+    return taken;
+}
+
+uint8_t NANDRequestQueue::findFollowingRead(const NANDAddress& address) const {
+    NANDAddress following = address;
+
+    following.page++;
+
+    if (following.page == MT29F::PagesPerBlock) {
+        following.page = 0U;
+        following.block++;
+    }
+
+    for (uint8_t slot = 0U; slot < Capacity; slot++) {
+        const Request& Candidate = slots[slot].request;
+
+        if (slots[slot].isPending and (Candidate.operation == Operation::READ) and
+            (Candidate.address.lun == following.lun) and (Candidate.address.block == following.block) and
+            (Candidate.address.page == following.page) and (Candidate.address.column == 0U) and
+            not dependsOnOlder(slot)) {
+            return slot;
+        }
+    }
+
+    return NoSlot;
+}
+
+bool NANDRequestQueue::dependsOnOlder(uint8_t slot) const {
+    const Request& Candidate = slots[slot].request;
+
+    for (uint8_t other = 0U; other < Capacity; other++) {
+        const Request& Other = slots[other].request;
+
+        if (not slots[other].isPending or not isOlder(other, slot) or
+            ((Other.operation == Operation::READ) and (Candidate.operation == Operation::READ)) or
+            (Other.address.lun != Candidate.address.lun) or (Other.address.block != Candidate.address.block)) {
+            continue;
+        }
+
+        if ((Other.operation == Operation::ERASE) or (Candidate.operation == Operation::ERASE) or
+            (Other.address.page == Candidate.address.page)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/* ============= Execution ============= */
+
+etl::expected<void, NANDErrorCode> NANDRequestQueue::execute(const Request& request) {
+    switch (request.operation) {
+        case Operation::READ:
+            return nand.readPage(request.address, request.readData);
+        case Operation::PROGRAM:
+            return nand.programPage(request.address, request.programData);
+        case Operation::ERASE:
+            return nand.eraseBlock(static_cast<uint16_t>(request.address.block),
+                                   static_cast<uint8_t>(request.address.lun));
+        default:
+            return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+}
+
+etl::expected<void, NANDErrorCode> NANDRequestQueue::executeReads(etl::span<const Request> reads) {
+    size_t delivered = 0U;
+    bool isTruncated = false;
+
+    auto sinkLambda = [&](const NANDAddress&, MT29F::PageDataStream& stream) -> bool {
+        const auto Destination = reads[delivered].readData;
+
+        if (stream.read(Destination) != Destination.size()) {
+            isTruncated = true;
+        }
+
+        delivered++;
+
+        return delivered < reads.size();
+    };
+
+    if (auto readResult = nand.readPagesSequential(reads[0].address, reads.size(), MT29F::PageSink(sinkLambda));
+        not readResult.has_value()) {
+        return readResult;
+    }
+
+    if (isTruncated or (delivered != reads.size())) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    return {};
+}
+
+void NANDRequestQueue::complete(const Request& request, etl::expected<void, NANDErrorCode> result) {
+    statistics.completed++;
+
+    if (not result.has_value()) {
+        statistics.failed++;
+    }
+
+    if (request.onComplete.is_valid()) {
+        request.onComplete(request, result);
+    }
+}
@@ -0,0 +1,153 @@
+#include "NANDStripedVolume.hpp"
+
+/* ============= Data Operations ============= */
+
+etl::expected<void, NANDErrorCode> NANDStripedVolume::readPages(uint16_t block, uint32_t firstPage, uint32_t pageCount,
+                                                                etl::span<uint8_t> data) {
+    auto rangeResult = validateRange(block, firstPage, pageCount, data.size());
+
+    if (not rangeResult.has_value()) {
+        return etl::unexpected(rangeResult.error());
+    }
+
+    const size_t PageBytes = *rangeResult;
+    etl::expected<void, NANDErrorCode> result;
+
+    /* Fill the pipeline: one array read per chip */
+    for (uint32_t index = 0U; (index < pageCount) and (index < chipCount) and result.has_value(); index++) {
+        const uint32_t Page = firstPage + index;
+
+        result = chips[Page % chipCount]->startReadPage(toChipAddress(block, Page));
+    }
+
+    for (uint32_t index = 0U; (index < pageCount) and result.has_value(); index++) {
+        const uint32_t Page = firstPage + index;
+        MT29F& chip = *chips[Page % chipCount];
+
+        result = chip.completeOperation(data.subspan(index * PageBytes, PageBytes));
+
+        if (result.has_value() and ((index + chipCount) < pageCount)) {
+            result = chip.startReadPage(toChipAddress(block, Page + chipCount));
+        }
+    }
+
+    return completeAll(result);
+}
+
+etl::expected<void, NANDErrorCode> NANDStripedVolume::programPages(uint16_t block, uint32_t firstPage,
+                                                                   uint32_t pageCount, etl::span<const uint8_t> data) {
+    auto rangeResult = validateRange(block, firstPage, pageCount, data.size());
+
+    if (not rangeResult.has_value()) {
+        return etl::unexpected(rangeResult.error());
+    }
+
+    const size_t PageBytes = *rangeResult;
+    etl::expected<void, NANDErrorCode> result;
+
+    for (uint32_t index = 0U; index < pageCount; index++) {
+        const uint32_t Page = firstPage + index;
+        MT29F& chip = *chips[Page % chipCount];
+
+        /* Only wait for this chip's previous page, the others keep programming */
+        if (chip.isOperationPending()) {
+            if (auto completeResult = chip.completeOperation(); not completeResult.has_value() and result.has_value()) {
+                result = completeResult;
+            }
+        }
+
+        if (auto startResult = chip.startProgramPage(toChipAddress(block, Page), data.subspan(index * PageBytes, PageBytes));
+            not startResult.has_value()) {
+            return completeAll(startResult);
+        }
+    }
+
+    return completeAll(result);
+}
+
+etl::expected<void, NANDErrorCode> NANDStripedVolume::eraseBlock(uint16_t block) {
+    if (chipCount == 0U) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if (block >= BlockCount) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    for (uint8_t chip = 0U; chip < chipCount; chip++) {
+        if (auto startResult = chips[chip]->startEraseBlock(block); not startResult.has_value()) {
+            return completeAll(startResult);
+        }
+    }
+
+    return completeAll({});
+}
+
+
+/* ============= Bad Block Management ============= */
+
+etl::expected<bool, NANDErrorCode> NANDStripedVolume::isBlockBad(uint16_t block) const {
+    if (block >= BlockCount) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    for (uint8_t chip = 0U; chip < chipCount; chip++) {
+        auto badResult = chips[chip]->isBlockBad(block);
+
+        if (not badResult.has_value() or *badResult) {
+            return badResult;
+        }
+    }
+
+    return false;
+}
+
+etl::expected<void, NANDErrorCode> NANDStripedVolume::markBadBlock(uint16_t block) {
+    if (block >= BlockCount) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    etl::expected<void, NANDErrorCode> result;
+
+    for (uint8_t chip = 0U; chip < chipCount; chip++) {
+        if (auto markResult = chips[chip]->markBadBlock(block); not markResult.has_value() and result.has_value()) {
+            result = markResult;
+        }
+    }
+
+    return result;
+}
+
+
+/* ============= Helpers ============= */
+
+etl::expected<size_t, NANDErrorCode> NANDStripedVolume::validateRange(uint16_t block, uint32_t firstPage,
+                                                                      uint32_t pageCount, size_t dataSize) const {
+    if ((chipCount == 0U) or (pageCount == 0U) or ((dataSize % pageCount) != 0U) or
+        ((dataSize / pageCount) > MT29F::TotalBytesPerPage)) {
+        return etl::unexpected(NANDErrorCode::INVALID_PARAMETER);
+    }
+
+    if ((block >= BlockCount) or (firstPage >= getPagesPerBlock()) or (pageCount > (getPagesPerBlock() - firstPage))) {
+        return etl::unexpected(NANDErrorCode::ADDRESS_OUT_OF_BOUNDS);
+    }
+
+    return dataSize / pageCount;
+}
+
+etl::expected<void, NANDErrorCode> NANDStripedVolume::completeAll(etl::expected<void, NANDErrorCode> previousResult) {
+    etl::expected<void, NANDErrorCode> result = previousResult;
+
+    for (uint8_t chip = 0U; chip < chipCount; chip++) {
+        if (not chips[chip]->isOperationPending()) {
+            continue;
+        }
+
+        /* A pending read is abandoned: its data register is not transferred */
+        if (auto completeResult = chips[chip]->completeOperation(); not completeResult.has_value() and result.has_value()) {
+            result = completeResult;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,110 @@
+#include "XDMACNANDDma.hpp"
+#include "NANDFlash.hpp"
+
+bool XDMACNANDDma::startRead(uint32_t dataRegisterAddress, etl::span<uint8_t> destination) {
+    if (not isCacheLineAligned(destination)) {
+        return false;
+    }
+
+#if (__DCACHE_PRESENT == 1U)
+    SCB_InvalidateDCache_by_Addr(reinterpret_cast<uint32_t*>(destination.data()),
+                                 static_cast<int32_t>(destination.size()));
+#endif
+
+    if (not start(ChannelConfigRead, reinterpret_cast<const void*>(dataRegisterAddress), destination.data(),
+                  destination.size())) {
+        return false;
+    }
+
+    readDestination = destination;
+
+    return true;
+}
+
+bool XDMACNANDDma::startWrite(etl::span<const uint8_t> source, uint32_t dataRegisterAddress) {
+#if (__DCACHE_PRESENT == 1U)
+    SCB_CleanDCache_by_Addr(reinterpret_cast<uint32_t*>(const_cast<uint8_t*>(source.data())),
+                            static_cast<int32_t>(source.size()));
+#endif
+
+    readDestination = {};
+
+    return start(ChannelConfigWrite, source.data(), reinterpret_cast<void*>(dataRegisterAddress), source.size());
+}
+
+bool XDMACNANDDma::waitForCompletion(uint32_t timeoutUs) {
+    if (not isTransferActive) {
+        return false;
+    }
+
+    if (waitForNotification.is_valid()) {
+        /* Stale wakeups only get the time left */
+        const uint32_t StartCycles = MT29F::readCycleCounter();
+
+        for (uint8_t wakeup = 0U; (wakeup <= MaxSpuriousWakeups) and (not isTransferComplete); wakeup++) {
+            const uint32_t ElapsedUs = MT29F::getElapsedMicroseconds(StartCycles);
+
+            if ((ElapsedUs >= timeoutUs) or (not waitForNotification(timeoutUs - ElapsedUs))) {
+                break;
+            }
+        }
+    } else {
+        pollForCompletion(timeoutUs);
+    }
+
+    isTransferActive = false;
+
+    if (not isTransferComplete) {
+        XDMAC_ChannelDisable(channel);
+        return false;
+    }
+
+#if (__DCACHE_PRESENT == 1U)
+    if (not readDestination.empty()) {
+        SCB_InvalidateDCache_by_Addr(reinterpret_cast<uint32_t*>(readDestination.data()),
+                                     static_cast<int32_t>(readDestination.size()));
+    }
+#endif
+
+    return not hasTransferFailed;
+}
+
+bool XDMACNANDDma::start(XDMAC_CHANNEL_CONFIG config, const void* source, void* destination, size_t length) {
+    if (isTransferActive or XDMAC_ChannelIsBusy(channel)) {
+        return false;
+    }
+
+    isTransferComplete = false;
+    hasTransferFailed = false;
+
+    XDMAC_ChannelCallbackRegister(channel, transferCallback, reinterpret_cast<uintptr_t>(this));
+
+    if (not XDMAC_ChannelSettingsSet(channel, config)) {
+        return false;
+    }
+
+    if (not XDMAC_ChannelTransfer(channel, source, destination, length)) {
+        return false;
+    }
+
+    isTransferActive = true;
+
+    return true;
+}
+
+void XDMACNANDDma::pollForCompletion(uint32_t timeoutUs) const {
+    const uint32_t StartCycles = MT29F::readCycleCounter();
+
+    while ((not isTransferComplete) and (MT29F::getElapsedMicroseconds(StartCycles) < timeoutUs)) {
+        __NOP();
+    }
+}
+
+void XDMACNANDDma::transferCallback(XDMAC_TRANSFER_EVENT event, uintptr_t context) {
+    auto* engine = reinterpret_cast<XDMACNANDDma*>(context);
+
+    engine->hasTransferFailed = (event != XDMAC_TRANSFER_COMPLETE);
+    engine->isTransferComplete = true;
+
+    engine->notifyTaskFromIsr.call_if();
+}
@@ -42,6 +42,22 @@ protected:
     constexpr SMC(ChipSelect chipSelect) : moduleBaseAddress(smcGetBaseAddress(chipSelect)),
                                            moduleEndAddress(smcGetEndAddress(chipSelect)) {}
 
+    /**
+     * Program the signal timings of a Chip Select. The new values apply from the next access.
+     * @param chipSelect Number of the Chip Select used for enabling the external module.
+     * @param setup SMC_SETUP value (NWE, NCS_WR, NRD, NCS_RD setup lengths).
+     * @param pulse SMC_PULSE value (NWE, NCS_WR, NRD, NCS_RD pulse lengths).
+     * @param cycle SMC_CYCLE value (total write and read cycle lengths).
+     * @param mode SMC_MODE value (read/write control signals, data bus width, data float time).
+     */
+    static inline void smcConfigureTiming(ChipSelect chipSelect, uint32_t setup, uint32_t pulse, uint32_t cycle,
+                                          uint32_t mode) {
+        SMC_REGS->SMC_CS_NUMBER[chipSelect].SMC_SETUP = setup;
+        SMC_REGS->SMC_CS_NUMBER[chipSelect].SMC_PULSE = pulse;
+        SMC_REGS->SMC_CS_NUMBER[chipSelect].SMC_CYCLE = cycle;
+        SMC_REGS->SMC_CS_NUMBER[chipSelect].SMC_MODE = mode;
+    }
+
     /**
      * Basic 8-bit write to an EBI address.
      * @param dataAddress EBI address to write to.
@@ -60,6 +76,17 @@ protected:
         return *(reinterpret_cast<volatile uint8_t *>(dataAddress));
     }
 
+    /**
+     * 32-bit read from an EBI address.
+     * On an 8-bit device the SMC splits the access into four byte cycles, the first one landing in the
+     * least significant byte.
+     * @param dataAddress EBI address to read from, 4-byte aligned.
+     * @return 32-bit data saved starting at that address.
+     */
+    inline uint32_t smcReadWord(uint32_t dataAddress) {
+        return *(reinterpret_cast<volatile uint32_t *>(dataAddress));
+    }
+
     /**
      * @param chipSelect Number of the Chip Select used for enabling the external module.
      * @return Base address on the EBI peripheral that the Chip Select corresponds to.